@@ -26,8 +26,52 @@ OpenBCI_Radios_Class::OpenBCI_Radios_Class() {
   debugMode = false; // Set true if doing dongle-dongle sim
   ackCounter = 0;
   lastTimeHostHeardFromDevice = 0;
+  lastTimeDeviceHeardFromHost = 0;
   lastTimeSerialRead = 0;
   systemUp = false;
+  timeSourceMicros = micros;
+  timeSourceMillis = millis;
+  numberOfStreamBuffers = OPENBCI_NUMBER_STREAM_BUFFERS;
+  timeoutPacketNormalUs = OPENBCI_TIMEOUT_PACKET_NRML_uS;
+  timeoutPacketStreamUs = OPENBCI_TIMEOUT_PACKET_STREAM_uS;
+  ingestCandidate = false;
+  streamSendBurst = OPENBCI_STREAM_SEND_BURST;
+  baudRateCodeDevice = OPENBCI_HOST_CMD_BAUD_DEFAULT;
+  isWaitingForNewBaudRate = false;
+  isWaitingForNewBaudRateConfirmation = false;
+  streamOverflowPolicy = OPENBCI_STREAM_OVERFLOW_POLICY;
+  streamDrops = 0;
+  streamSequence = OPENBCI_STREAM_SEQUENCE;
+  streamSequenceNext = 1;
+  streamSequenceLast = 0;
+  streamSequenceMissed = 0;
+  streamSequenceDuplicates = 0;
+  streamSequenceGap = 0;
+  streamSequenceGapAt = OPENBCI_STREAM_PARITY_NO_HOLE;
+  streamParityHoleSinceUs = 0;
+  streamParityRecovered = 0;
+  bufferStreamParitySet(OPENBCI_STREAM_PARITY_GROUP);
+  streamRetransmitTimeoutUs = OPENBCI_STREAM_RETRANSMIT_TIMEOUT_uS;
+  streamRetransmitSent = 0;
+  streamRetransmitRecovered = 0;
+  streamRetransmitExpired = 0;
+  bufferStreamRetransmitSet(OPENBCI_STREAM_RETRANSMIT);
+  streamDeltaBreak = false;
+  streamDeltaSamples = 0;
+  streamDeltaUndecoded = 0;
+  streamDeltaRefused = false;
+  bufferStreamDeltaSet(OPENBCI_STREAM_DELTA);
+  bufferOutputLength = 0;
+  bufferOutputSinceUs = 0;
+  outputMode = OPENBCI_OUTPUT_MODE;
+  outputBudgetBytes = OPENBCI_OUTPUT_BUDGET_BYTES;
+  outputBudgetUs = OPENBCI_OUTPUT_BUDGET_uS;
+  outputDrops = 0;
+  outputBaud = OPENBCI_BAUD_RATE_DEFAULT;
+  outputTxDoneUs = 0;
+  streamDeferred.reset();
+  streamDeferredDropped = 0;
+  streamDeferredDroppedSeen = 0;
 }
 
 /**
@@ -162,12 +206,15 @@ void OpenBCI_Radios_Class::configureDevice(void) {
     // END: To run host normally
   }
 
-  timeOfLastMultipacketSendToHost = millis();
+  timeOfLastMultipacketSendToHost = timeMillis();
   sendingMultiPacket = false;
   streamPacketsHaveHeads = true;
 
   pollRefresh();
 
+#ifdef OPENBCI_PERF_COUNTERS
+  latencyReset();
+#endif
 }
 
 /**
@@ -190,6 +237,8 @@ void OpenBCI_Radios_Class::configureHost(void) {
 
   // Open the Serial connection
   Serial.begin(OPENBCI_BAUD_RATE_DEFAULT);
+  outputBaud = OPENBCI_BAUD_RATE_DEFAULT;
+  outputTxDoneUs = timeMicros();
 
   packetInTXRadioBuffer = false;
   sendSerialAck = false;
@@ -197,6 +246,12 @@ void OpenBCI_Radios_Class::configureHost(void) {
   printMessageToDriverFlag = false;
   systemUp = false;
 
+#ifdef OPENBCI_PERF_COUNTERS
+  perfBegin();
+#endif
+#ifdef OPENBCI_RADIO_TRACE
+  traceReset();
+#endif
 }
 
 /**
@@ -392,7 +447,7 @@ boolean OpenBCI_Radios_Class::didPCSendDataToHost(void) {
 * @author AJ Keller (@pushtheworldllc)
 */
 boolean OpenBCI_Radios_Class::commsFailureTimeout(void) {
-  return millis() > (lastTimeHostHeardFromDevice + OPENBCI_TIMEOUT_COMMS_MS);
+  return timeElapsedMillis(lastTimeHostHeardFromDevice, OPENBCI_TIMEOUT_COMMS_MS);
 }
 
 /**
@@ -435,6 +490,39 @@ void OpenBCI_Radios_Class::printPollTime(char p) {
   Serial.print("Poll time: "); Serial.print((int)p); Serial.write(p);
 }
 
+/**
+* @description Host: prints the stream packets the Host's ring dropped since
+*  power on and the policy it drops them with, then the numbered packets found
+*  missing, the repeats thrown away, the packets rebuilt from parity, the ones
+*  that came again in time, the gap markers that gave up waiting, the packed
+*  samples that could not be undone and the stream packets thrown away
+*  because the PC was not reading, i.e.
+*  `Success: Stream drops host:3 policy:0 missed:5 duplicates:1 recovered:4 resent:1 expired:0 undecoded:0 backpressure:2$$$`
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::printStreamDrops(void) {
+  printSuccess();
+  Serial.print("Stream drops host:");
+  Serial.print((unsigned long)streamDrops);
+  Serial.print(" policy:");
+  Serial.print((int)streamOverflowPolicy);
+  Serial.print(" missed:");
+  Serial.print((unsigned long)streamSequenceMissed);
+  Serial.print(" duplicates:");
+  Serial.print((unsigned long)streamSequenceDuplicates);
+  Serial.print(" recovered:");
+  Serial.print((unsigned long)streamParityRecovered);
+  Serial.print(" resent:");
+  Serial.print((unsigned long)streamRetransmitRecovered);
+  Serial.print(" expired:");
+  Serial.print((unsigned long)streamRetransmitExpired);
+  Serial.print(" undecoded:");
+  Serial.print((unsigned long)streamDeltaUndecoded);
+  Serial.print(" backpressure:");
+  Serial.print((unsigned long)outputDrops);
+  printEOT();
+}
+
 void OpenBCI_Radios_Class::printSuccess(void) {
   Serial.print("Success: ");
 }
@@ -464,9 +552,27 @@ void OpenBCI_Radios_Class::printValidatedCommsTimeout(void) {
 *  `HOST_MESSAGE_CHAN_GET_SUCCESS` - The message to print when the Host and Device are communicating.
 *  `HOST_MESSAGE_POLL_TIME` - Prints the poll time when there is no comms.
 *  `HOST_MESSAGE_SERIAL_ACK` - Writes a serial ack (',') to the Driver/PC
+*  `HOST_MESSAGE_PERF` - Prints the perf counter snapshot, see `printPerf`
+*  `HOST_MESSAGE_LATENCY` - Prints the Host's latency histograms, see `printLatency`
+*  `HOST_MESSAGE_TRACE` - Writes the radio frame trace, see `printTrace`
+*  `HOST_MESSAGE_BAUD_DEVICE` - The Device's UART switched to `baudRateCodeDevice`
+*  `HOST_MESSAGE_BAUD_DEVICE_VERIFY` - Print the need to verify the Device baud code you inputed message
+*  `HOST_MESSAGE_COMMS_DOWN_BAUD_DEVICE` - Print the message when the comms went down trying to change the Device's baud rate.
+*  `HOST_MESSAGE_STREAM_DROPS` - Prints the Host's stream ring drop counter, see `printStreamDrops`
+*  `HOST_MESSAGE_STREAM_PARITY` - The Device confirmed `streamParityGroup`
+*  `HOST_MESSAGE_STREAM_PARITY_VERIFY` - Print the need to verify the parity group you inputed message
+*  `HOST_MESSAGE_STREAM_RETRANSMIT` - The Device confirmed `streamRetransmit`
+*  `HOST_MESSAGE_STREAM_RETRANSMIT_VERIFY` - Print the need to verify the retransmit setting you inputed message
+*  `HOST_MESSAGE_STREAM_DELTA` - The Device confirmed `streamDelta`
+*  `HOST_MESSAGE_STREAM_DELTA_VERIFY` - Print the need to verify the delta setting you inputed message
+*  `HOST_MESSAGE_OUTPUT_MODE` - Prints the new `outputMode`
+*  `HOST_MESSAGE_OUTPUT_MODE_VERIFY` - Print the need to verify the output mode you inputed message
 * @author AJ Keller (@pushtheworldllc)
 */
 void OpenBCI_Radios_Class::printMessageToDriver(uint8_t code) {
+  OPENBCI_PERF_START(start);
+  // After whatever the PC was already owed
+  bufferOutputDrain();
   switch (code) {
     case HOST_MESSAGE_COMMS_DOWN:
     printValidatedCommsTimeout();
@@ -483,6 +589,12 @@ void OpenBCI_Radios_Class::printMessageToDriver(uint8_t code) {
     printCommsTimeout();
     printEOT();
     break;
+    case HOST_MESSAGE_COMMS_DOWN_BAUD_DEVICE:
+    printFailure();
+    Serial.print("Device Baud Rate Change Request");
+    printCommsTimeout();
+    printEOT();
+    break;
     case HOST_MESSAGE_SYS_UP:
     printSuccess();
     Serial.print("System is Up");
@@ -502,6 +614,8 @@ void OpenBCI_Radios_Class::printMessageToDriver(uint8_t code) {
     Serial.end();
     // Open the Serial connection
     Serial.begin(OPENBCI_BAUD_RATE_FAST);
+    outputBaud = OPENBCI_BAUD_RATE_FAST;
+    outputTxDoneUs = timeMicros();
     break;
     case HOST_MESSAGE_BAUD_DEFAULT:
     printSuccess();
@@ -512,6 +626,8 @@ void OpenBCI_Radios_Class::printMessageToDriver(uint8_t code) {
     Serial.end();
     // Open the Serial connection
     Serial.begin(OPENBCI_BAUD_RATE_DEFAULT);
+    outputBaud = OPENBCI_BAUD_RATE_DEFAULT;
+    outputTxDoneUs = timeMicros();
     break;
     case HOST_MESSAGE_BAUD_HYPER:
     printSuccess();
@@ -522,6 +638,8 @@ void OpenBCI_Radios_Class::printMessageToDriver(uint8_t code) {
     Serial.end();
     // Open the Serial connection
     Serial.begin(OPENBCI_BAUD_RATE_HYPER);
+    outputBaud = OPENBCI_BAUD_RATE_HYPER;
+    outputTxDoneUs = timeMicros();
     break;
     case HOST_MESSAGE_CHAN:
     printValidatedCommsTimeout();
@@ -557,16 +675,107 @@ void OpenBCI_Radios_Class::printMessageToDriver(uint8_t code) {
     break;
     case HOST_MESSAGE_POLL_TIME:
     printSuccess();
-    printPollTime(radio.getPollTime());
+    printPollTime(getPollTime());
     printEOT();
     break;
     case HOST_MESSAGE_SERIAL_ACK:
     // Messages to print
     Serial.write(',');
+    break;
+    case HOST_MESSAGE_PERF:
+#ifdef OPENBCI_PERF_COUNTERS
+    printPerf();
+#else
+    printFailure();
+    Serial.print("Perf counters not compiled in");
+    printEOT();
+#endif
+    break;
+    case HOST_MESSAGE_LATENCY:
+#ifdef OPENBCI_PERF_COUNTERS
+    printLatency();
+#else
+    printFailure();
+    Serial.print("Latency histograms not compiled in");
+    printEOT();
+#endif
+    break;
+    case HOST_MESSAGE_STREAM_DROPS:
+    printStreamDrops();
+    break;
+    case HOST_MESSAGE_STREAM_PARITY:
+    printSuccess();
+    Serial.print("Stream parity group ");
+    Serial.print((int)streamParityGroup);
+    printEOT();
+    break;
+    case HOST_MESSAGE_STREAM_PARITY_VERIFY:
+    printFailure();
+    Serial.print("Verify stream parity group is 0 or ");
+    Serial.print((int)OPENBCI_STREAM_PARITY_GROUP_MIN);
+    Serial.print(" to ");
+    Serial.print((int)OPENBCI_STREAM_PARITY_GROUP_MAX);
+    printEOT();
+    break;
+    case HOST_MESSAGE_STREAM_RETRANSMIT:
+    printSuccess();
+    Serial.print("Stream retransmit ");
+    Serial.print(streamRetransmit ? "on" : "off");
+    printEOT();
+    break;
+    case HOST_MESSAGE_STREAM_RETRANSMIT_VERIFY:
+    printFailure();
+    Serial.print("Verify stream retransmit is 0 or 1");
+    printEOT();
+    break;
+    case HOST_MESSAGE_STREAM_DELTA:
+    printSuccess();
+    Serial.print("Stream delta ");
+    Serial.print(streamDelta ? "on" : "off");
+    printEOT();
+    break;
+    case HOST_MESSAGE_STREAM_DELTA_VERIFY:
+    printFailure();
+    Serial.print("Verify stream delta is 0 or 1");
+    printEOT();
+    break;
+    case HOST_MESSAGE_OUTPUT_MODE:
+    printSuccess();
+    Serial.print("Output mode ");
+    Serial.print(outputMode == OPENBCI_OUTPUT_MODE_THROUGHPUT ? "throughput" : "latency");
+    printEOT();
+    break;
+    case HOST_MESSAGE_OUTPUT_MODE_VERIFY:
+    printFailure();
+    Serial.print("Verify output mode is 0 or 1");
+    printEOT();
+    break;
+    case HOST_MESSAGE_BAUD_DEVICE:
+    printSuccess();
+    Serial.print("Device baud rate ");
+    Serial.print((int)baudRateFromCode(baudRateCodeDevice));
+    printEOT();
+    break;
+    case HOST_MESSAGE_BAUD_DEVICE_VERIFY:
+    printFailure();
+    Serial.print("Verify Device baud code is 0x05, 0x06 or 0x0A");
+    printEOT();
+    break;
+    case HOST_MESSAGE_TRACE:
+#ifdef OPENBCI_RADIO_TRACE
+    printTrace();
+#else
+    printFailure();
+    Serial.print("Radio trace not compiled in");
+    printEOT();
+#endif
     break;
     default:
     break;
   }
+  // The prints above waited on the UART as they needed, call it full after them
+  bufferOutputTxAdd(OPENBCI_SERIAL_TX_BUFFER_BYTES);
+  OPENBCI_PERF_END(*this, PERF_SECTION_PRINT_MESSAGE, start);
 }
 
 /**
@@ -585,6 +794,10 @@ void OpenBCI_Radios_Class::bufferSerialProcessCommsFailure(void) {
     isWaitingForNewPollTimeConfirmation = false;
     msgToPrint = HOST_MESSAGE_COMMS_DOWN_POLL_TIME;
     printMessageToDriverFlag = true;
+  } else if (isWaitingForNewBaudRateConfirmation) {
+    isWaitingForNewBaudRateConfirmation = false;
+    msgToPrint = HOST_MESSAGE_COMMS_DOWN_BAUD_DEVICE;
+    printMessageToDriverFlag = true;
   } else {
     if (bufferSerialHasData()) {
       byte action = processOutboundBuffer(bufferSerial.packetBuffer);
@@ -756,6 +969,42 @@ byte OpenBCI_Radios_Class::processOutboundBufferCharDouble(char *buffer) {
       // Clear the serial buffer
       bufferSerialReset(1);
       return ACTION_RADIO_SEND_NONE;
+      case OPENBCI_HOST_CMD_PERF_GET:
+      msgToPrint = HOST_MESSAGE_PERF;
+      printMessageToDriverFlag = true;
+      // Clear the serial buffer
+      bufferSerialReset(1);
+      return ACTION_RADIO_SEND_NONE;
+      case OPENBCI_HOST_CMD_LATENCY_GET:
+      // Print the Host's stages now, the Device answers with its own
+      msgToPrint = HOST_MESSAGE_LATENCY;
+      printMessageToDriverFlag = true;
+      // Clear the serial buffer
+      bufferSerialReset(1);
+#ifdef OPENBCI_PERF_COUNTERS
+      if (systemUp) {
+        singleCharMsg[0] = (char)ORPM_GET_LATENCY;
+        return ACTION_RADIO_SEND_SINGLE_CHAR;
+      }
+#endif
+      return ACTION_RADIO_SEND_NONE;
+      case OPENBCI_HOST_CMD_STREAM_DROPS_GET:
+      // Print the Host's count now, the Device answers with its own
+      msgToPrint = HOST_MESSAGE_STREAM_DROPS;
+      printMessageToDriverFlag = true;
+      // Clear the serial buffer
+      bufferSerialReset(1);
+      if (systemUp) {
+        singleCharMsg[0] = (char)ORPM_GET_STREAM_DROPS;
+        return ACTION_RADIO_SEND_SINGLE_CHAR;
+      }
+      return ACTION_RADIO_SEND_NONE;
+      case OPENBCI_HOST_CMD_TRACE_DUMP:
+      msgToPrint = HOST_MESSAGE_TRACE;
+      printMessageToDriverFlag = true;
+      // Clear the serial buffer
+      bufferSerialReset(1);
+      return ACTION_RADIO_SEND_NONE;
       case OPENBCI_HOST_CMD_SYS_UP:
       if (systemUp) {
         msgToPrint = HOST_MESSAGE_SYS_UP;
@@ -857,6 +1106,85 @@ byte OpenBCI_Radios_Class::processOutboundBufferCharTriple(char *buffer) {
         bufferSerialReset(1);
         return ACTION_RADIO_SEND_NONE;
       }
+      case OPENBCI_HOST_CMD_BAUD_DEVICE_SET:
+      // Clear the serial buffer
+      bufferSerialReset(1);
+      if (!systemUp) {
+        msgToPrint = HOST_MESSAGE_COMMS_DOWN;
+        printMessageToDriverFlag = true;
+        return ACTION_RADIO_SEND_NONE;
+      }
+      if (baudRateFromCode(buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD]) == 0) {
+        msgToPrint = HOST_MESSAGE_BAUD_DEVICE_VERIFY;
+        printMessageToDriverFlag = true;
+        return ACTION_RADIO_SEND_NONE;
+      }
+      // Save the requested rate
+      baudRateCodeDevice = buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD];
+      // Send a baud rate change request to the device
+      singleCharMsg[0] = (char)ORPM_CHANGE_BAUD_HOST_REQUEST;
+      return ACTION_RADIO_SEND_SINGLE_CHAR;
+      case OPENBCI_HOST_CMD_STREAM_PARITY_SET:
+      // Clear the serial buffer
+      bufferSerialReset(1);
+      if (!systemUp) {
+        msgToPrint = HOST_MESSAGE_COMMS_DOWN;
+        printMessageToDriverFlag = true;
+        return ACTION_RADIO_SEND_NONE;
+      }
+      if ((uint8_t)buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD] > OPENBCI_STREAM_PARITY_GROUP_MAX
+        || ((uint8_t)buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD] > 0 && (uint8_t)buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD] < OPENBCI_STREAM_PARITY_GROUP_MIN)) {
+        msgToPrint = HOST_MESSAGE_STREAM_PARITY_VERIFY;
+        printMessageToDriverFlag = true;
+        return ACTION_RADIO_SEND_NONE;
+      }
+      // The Host switches when the Device echoes it
+      singleCharMsg[0] = (char)(ORPM_STREAM_PARITY_SET + buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD]);
+      return ACTION_RADIO_SEND_SINGLE_CHAR;
+      case OPENBCI_HOST_CMD_STREAM_RETRANSMIT_SET:
+      // Clear the serial buffer
+      bufferSerialReset(1);
+      if (!systemUp) {
+        msgToPrint = HOST_MESSAGE_COMMS_DOWN;
+        printMessageToDriverFlag = true;
+        return ACTION_RADIO_SEND_NONE;
+      }
+      if ((uint8_t)buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD] > 1) {
+        msgToPrint = HOST_MESSAGE_STREAM_RETRANSMIT_VERIFY;
+        printMessageToDriverFlag = true;
+        return ACTION_RADIO_SEND_NONE;
+      }
+      // The Host switches when the Device echoes it
+      singleCharMsg[0] = (char)(ORPM_STREAM_RETRANSMIT_SET + buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD]);
+      return ACTION_RADIO_SEND_SINGLE_CHAR;
+      case OPENBCI_HOST_CMD_STREAM_DELTA_SET:
+      // Clear the serial buffer
+      bufferSerialReset(1);
+      if (!systemUp) {
+        msgToPrint = HOST_MESSAGE_COMMS_DOWN;
+        printMessageToDriverFlag = true;
+        return ACTION_RADIO_SEND_NONE;
+      }
+      if ((uint8_t)buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD] > 1) {
+        msgToPrint = HOST_MESSAGE_STREAM_DELTA_VERIFY;
+        printMessageToDriverFlag = true;
+        return ACTION_RADIO_SEND_NONE;
+      }
+      // The Host switches when the Device echoes it
+      singleCharMsg[0] = (char)(ORPM_STREAM_DELTA_SET + buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD]);
+      return ACTION_RADIO_SEND_SINGLE_CHAR;
+      case OPENBCI_HOST_CMD_OUTPUT_MODE_SET:
+      // Clear the serial buffer
+      bufferSerialReset(1);
+      // Only the Host's, works with the system down
+      if ((uint8_t)buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD] > OPENBCI_OUTPUT_MODE_THROUGHPUT) {
+        msgToPrint = HOST_MESSAGE_OUTPUT_MODE_VERIFY;
+      } else {
+        outputMode = (uint8_t)buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD];
+        msgToPrint = HOST_MESSAGE_OUTPUT_MODE;
+      }
+      printMessageToDriverFlag = true;
+      return ACTION_RADIO_SEND_NONE;
       case OPENBCI_HOST_CMD_CHANNEL_SET_OVERIDE:
       if (setChannelNumber((uint32_t)buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD])) {
         radioChannel = (uint32_t)buffer[OPENBCI_HOST_PRIVATE_POS_PAYLOAD];
@@ -921,176 +1249,861 @@ void OpenBCI_Radios_Class::sendPacketToDevice(device_t device, boolean lockPacke
 
 /********************************************/
 /********************************************/
-/***********    DEVICE CODE    **************/
+/**********    PERF COUNTER CODE    *********/
 /********************************************/
 /********************************************/
 
+#ifdef OPENBCI_PERF_COUNTERS
+
+#ifndef OPENBCI_PERF_CYCLES
+// TIMER1 is only 16 bits wide on the nRF51, its overflow interrupt keeps the
+//  top half. Gazell has TIMER2 and the radio TIMER0.
+static volatile uint16_t perfTimerHigh = 0;
+
+static void perfTimerOverflow(void) {
+  NRF_TIMER1->EVENTS_COMPARE[0] = 0;
+  perfTimerHigh++;
+}
+#endif
+
 /**
-* @description Private function to handle a request to read serial as a device
-* @return {boolean} - `true` if there is data to read, `false` if not...
+* @description Reads the free running cycle counter. The Cortex-M0 has no DWT
+*  cycle counter, so on the RFduino this is TIMER1 clocked at 16MHz, one tick
+*  per core cycle. A build can supply its own `OPENBCI_PERF_CYCLES()`.
+* @returns {uint32_t} - Cycles since `perfBegin`, wraps after about 268s.
 * @author AJ Keller (@pushtheworldllc)
 */
-boolean OpenBCI_Radios_Class::didPicSendDeviceSerialData(void) {
-  return Serial.available() > 0;
+uint32_t OpenBCI_Radios_Class::perfCycles(void) {
+#ifdef OPENBCI_PERF_CYCLES
+  return OPENBCI_PERF_CYCLES();
+#else
+  uint16_t high;
+  uint32_t low;
+  do {
+    high = perfTimerHigh;
+    NRF_TIMER1->TASKS_CAPTURE[1] = 1;
+    low = NRF_TIMER1->CC[1];
+  } while (high != perfTimerHigh);
+  // Called with interrupts held off right after the timer wrapped
+  if (NRF_TIMER1->EVENTS_COMPARE[0] && low < 0x8000) high++;
+  return ((uint32_t)high << 16) | low;
+#endif
 }
 
 /**
-* @description Sends a null byte to the host
+* @description Starts the cycle counter and opens the first window.
 * @author AJ Keller (@pushtheworldllc)
 */
-void OpenBCI_Radios_Class::sendPollMessageToHost(void) {
-  RFduinoGZLL.sendToHost(NULL,0);
+void OpenBCI_Radios_Class::perfBegin(void) {
+#ifndef OPENBCI_PERF_CYCLES
+  NRF_TIMER1->TASKS_STOP = 1;
+  NRF_TIMER1->MODE = TIMER_MODE_MODE_Timer;
+  NRF_TIMER1->BITMODE = TIMER_BITMODE_BITMODE_16Bit;
+  NRF_TIMER1->PRESCALER = 0;
+  NRF_TIMER1->TASKS_CLEAR = 1;
+  NRF_TIMER1->CC[0] = 0;
+  NRF_TIMER1->INTENSET = TIMER_INTENSET_COMPARE0_Msk;
+  dynamic_attachInterrupt(TIMER1_IRQn, perfTimerOverflow);
+  NRF_TIMER1->TASKS_START = 1;
+#endif
+  perfReset();
+  latencyReset();
 }
 
 /**
-* @description Sends a one byte long message to the host
-* @param msg {byte} - A single byte to send to the host
+* @description Closes one pass of `loop()`. A pass where nothing called
+*  `perfSectionEnd` or `OPENBCI_PERF_WORK` goes to the idle counters.
+* @param `start` {uint32_t} - `perfCycles` at the top of the pass.
 * @author AJ Keller (@pushtheworldllc)
 */
-void OpenBCI_Radios_Class::sendRadioMessageToHost(byte msg) {
-  RFduinoGZLL.sendToHost((const char*)msg,1);
+void OpenBCI_Radios_Class::perfLoopEnd(uint32_t start) {
+  if (perfWork == 0) {
+    perfIdleLoops++;
+    perfIdleCycles += perfCycles() - start;
+  } else {
+    perfSectionEnd(PERF_SECTION_LOOP, start);
+  }
+  perfWork = 0;
 }
 
-void OpenBCI_Radios_Class::setByteIdForPacketBuffer(int packetNumber) {
-  char byteId = byteIdMake(false,packetNumber,(bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->data + 1, (bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->positionWrite - 1);
-
-  // Add the byteId to the packet
-  (bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->data[0] = byteId;
+/**
+* @description Zeros every counter and starts a new window.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::perfReset(void) {
+  for (int i = 0; i < PERF_SECTION_COUNT; i++) {
+    perfSections[i].calls = 0;
+    perfSections[i].cycles = 0;
+    perfSections[i].maxCycles = 0;
+  }
+  perfIdleLoops = 0;
+  perfIdleCycles = 0;
+  perfWork = 0;
+  perfWindowStart = perfCycles();
 }
 
 /**
-* @description Called from Devices to send a packet to Host. Uses global
-*  variables to send the correct packet.
-* @returns {boolean} - The packet number sent.
+* @description Adds one timed call to a section.
+* @param `section` {uint8_t} - A `PERF_SECTION`
+* @param `start` {uint32_t} - `perfCycles` when the call started.
 * @author AJ Keller (@pushtheworldllc)
 */
-boolean OpenBCI_Radios_Class::sendPacketToHost(void) {
-
-  // Reset the stream buffers
-  bufferStreamReset();
-
-  int packetNumber = bufferSerial.numberOfPacketsToSend - bufferSerial.numberOfPacketsSent - 1;
+void OpenBCI_Radios_Class::perfSectionEnd(uint8_t section, uint32_t start) {
+  uint32_t cycles = perfCycles() - start;
+  PerfSection *s = perfSections + section;
+  s->calls++;
+  s->cycles += cycles;
+  if (cycles > s->maxCycles) {
+    s->maxCycles = cycles;
+  }
+  if (section != PERF_SECTION_ON_RECEIVE) {
+    perfWork++;
+  }
+}
 
-  // Make the byteId
-  char byteId = byteIdMake(false,packetNumber,(bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->data + 1, (bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->positionWrite - 1);
+/**
+* @description Prints the counters since the last snapshot and starts a new
+*  window. One line: "Success: Perf cyc/us:16 win:<cycles> util:<permille>
+*  idle:<passes>/<cycles>" then "<section>:<calls>/<cycles>/<max cycles>"
+*  for the loop passes that did work, the ISR, the stream flush, the radio
+*  flush and the driver messages. `util` is the working passes plus the ISR
+*  over the window, an ISR that lands in a working pass counts twice so it
+*  errs high.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::printPerf(void) {
+  // Copy first so printing does not end up in its own numbers
+  PerfSection sections[PERF_SECTION_COUNT];
+  for (int i = 0; i < PERF_SECTION_COUNT; i++) {
+    sections[i] = perfSections[i];
+  }
+  uint32_t window = perfCycles() - perfWindowStart;
+  uint32_t idleLoops = perfIdleLoops;
+  uint32_t idleCycles = perfIdleCycles;
+  perfReset();
+
+  uint32_t busy = sections[PERF_SECTION_LOOP].cycles + sections[PERF_SECTION_ON_RECEIVE].cycles;
+  uint32_t util = 0;
+  if (window >= OPENBCI_PERF_PERMILLE) {
+    util = busy / (window / OPENBCI_PERF_PERMILLE);
+  }
+  if (util > OPENBCI_PERF_PERMILLE) {
+    util = OPENBCI_PERF_PERMILLE;
+  }
 
-  // Add the byteId to the packet
-  (bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->data[0] = byteId;
+  printSuccess();
+  Serial.print("Perf cyc/us:"); Serial.print(OPENBCI_PERF_CYCLES_PER_uS);
+  Serial.print(" win:"); Serial.print(window);
+  Serial.print(" util:"); Serial.print(util);
+  Serial.print(" idle:"); Serial.print(idleLoops);
+  Serial.print("/"); Serial.print(idleCycles);
+  printPerfSection("loop", sections + PERF_SECTION_LOOP);
+  printPerfSection("isr", sections + PERF_SECTION_ON_RECEIVE);
+  printPerfSection("stream", sections + PERF_SECTION_STREAM_FLUSH);
+  printPerfSection("radio", sections + PERF_SECTION_RADIO_FLUSH);
+  printPerfSection("print", sections + PERF_SECTION_PRINT_MESSAGE);
+  printEOT();
+}
 
-  if (RFduinoGZLL.sendToHost((char *)(bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->data, (bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->positionWrite)) {
-    pollRefresh();
+void OpenBCI_Radios_Class::printPerfSection(const char *name, PerfSection *s) {
+  Serial.print(" "); Serial.print(name); Serial.print(":");
+  Serial.print(s->calls); Serial.print("/");
+  Serial.print(s->cycles); Serial.print("/");
+  Serial.print(s->maxCycles);
+}
 
-    bufferSerial.numberOfPacketsSent++;
+/**
+* @description Device: an ACK came back, so the oldest stream packet handed to
+*  Gazell made it. Assumes every ACK is for a stream packet, which holds while
+*  streaming.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::latencyAck(void) {
+  if (latencyAirCount == 0) return;
+  latencyAdd(LATENCY_STAGE_AIR, timeMicros() - latencyAirSentUs[latencyAirHead]);
+  latencyAirHead = (latencyAirHead + 1) % OPENBCI_LATENCY_AIR_SLOTS;
+  latencyAirCount--;
+}
 
-    return true;
+/**
+* @description Counts one packet into a stage's histogram. Bucket n holds
+*  times under `OPENBCI_LATENCY_BUCKET_MIN_uS << n`, the last bucket the rest.
+* @param `stage` {uint8_t} - A `LATENCY_STAGE`
+* @param `us` {unsigned long} - How long the packet spent in the stage.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::latencyAdd(uint8_t stage, unsigned long us) {
+  uint8_t bucket = 0;
+  while (bucket < OPENBCI_LATENCY_BUCKETS - 1 && us >= ((unsigned long)OPENBCI_LATENCY_BUCKET_MIN_uS << bucket)) {
+    bucket++;
   }
-
-  return false;
+  latencyHistogram[stage][bucket]++;
 }
 
 /**
-* @description Test to see if a char follows the stream tail byte format
+* @description Writes " <name>:<count>,<count>,..." for one stage.
+* @param `out` {char *} - At least `OPENBCI_LATENCY_LINE_MAX` chars.
+* @param `name` {char *} - The stage name to print.
+* @param `stage` {uint8_t} - A `LATENCY_STAGE`
+* @returns {int} - The length written, not counting the terminator.
 * @author AJ Keller (@pushtheworldllc)
 */
-boolean OpenBCI_Radios_Class::isATailByte(uint8_t newChar) {
-  return (newChar >> 4) == 0xC;
+int OpenBCI_Radios_Class::latencyFormat(char *out, const char *name, uint8_t stage) {
+  int len = 0;
+  out[len++] = ' ';
+  while (*name) {
+    out[len++] = *name++;
+  }
+  out[len++] = ':';
+  for (int i = 0; i < OPENBCI_LATENCY_BUCKETS; i++) {
+    if (i > 0) {
+      out[len++] = ',';
+    }
+    // Digits come out backwards
+    char digits[10];
+    int n = 0;
+    uint32_t count = latencyHistogram[stage][i];
+    do {
+      digits[n++] = '0' + (count % 10);
+      count /= 10;
+    } while (count > 0);
+    while (n > 0) {
+      out[len++] = digits[--n];
+    }
+  }
+  out[len] = '\0';
+  return len;
 }
 
 /**
-* @description Sends a soft reset command to the Pic 32 incase of an emergency.
+* @description Zeros every histogram and forgets the packets waiting on an ACK.
 * @author AJ Keller (@pushtheworldllc)
 */
-void OpenBCI_Radios_Class::resetPic32(void) {
-  Serial.write('v');
+void OpenBCI_Radios_Class::latencyReset(void) {
+  for (int i = 0; i < LATENCY_STAGE_COUNT; i++) {
+    for (int j = 0; j < OPENBCI_LATENCY_BUCKETS; j++) {
+      latencyHistogram[i][j] = 0;
+    }
+  }
+  latencyAirHead = 0;
+  latencyAirCount = 0;
+  latencyOutputPackets = 0;
 }
 
-/********************************************/
-/********************************************/
-/*************    PASS THRU    **************/
-/********************************************/
-/********************************************/
+/**
+* @description Host: prints the ring and serial histograms since the last
+*  read and starts over. One line: "Success: Latency host ring:<counts>
+*  serial:<counts>$$$", see `latencyAdd` for the buckets.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::printLatency(void) {
+  char line[OPENBCI_LATENCY_LINE_MAX];
+  printSuccess();
+  Serial.print("Latency host");
+  latencyFormat(line, "ring", LATENCY_STAGE_RING);
+  Serial.print(line);
+  latencyFormat(line, "serial", LATENCY_STAGE_SERIAL);
+  Serial.print(line);
+  printEOT();
+  latencyReset();
+}
 
 /**
-* @description Used to flash the led to indicate to the user the device is in pass through mode.
+* @description Device: queues the ingest, queue and air histograms since the
+*  last read for the Host and starts over. One line: "Success: Latency device
+*  ingest:<counts> queue:<counts> air:<counts>$$$". The stream packets share
+*  the serial buffer, so ask while the board is not streaming.
 * @author AJ Keller (@pushtheworldllc)
 */
-void OpenBCI_Radios_Class::ledFeedBackForPassThru(void) {
-  digitalWrite(OPENBCI_PIN_HOST_LED,HIGH);
-  delay(600);
-  digitalWrite(OPENBCI_PIN_HOST_LED,LOW);
-  delay(200);
+void OpenBCI_Radios_Class::bufferSerialAddLatency(void) {
+  char line[OPENBCI_LATENCY_LINE_MAX];
+  bufferSerialAddString("Success: Latency device");
+  latencyFormat(line, "ingest", LATENCY_STAGE_INGEST);
+  bufferSerialAddString(line);
+  latencyFormat(line, "queue", LATENCY_STAGE_QUEUE);
+  bufferSerialAddString(line);
+  latencyFormat(line, "air", LATENCY_STAGE_AIR);
+  bufferSerialAddString(line);
+  bufferSerialAddString("$$$");
+  latencyReset();
 }
 
+#endif
+
 /********************************************/
 /********************************************/
-/********    COMMON MEHTOD CODE    **********/
+/*********    RADIO TRACE CODE    ***********/
 /********************************************/
 /********************************************/
 
+#ifdef OPENBCI_RADIO_TRACE
+
 /**
-* @description Writes a buffer to the serial port of a given length
-* @param buffer [char *] The buffer you want to write out
-* @param length [int] How many bytes to you want to write out?
+* @description Host: empties the trace ring and starts recording.
 * @author AJ Keller (@pushtheworldllc)
 */
-void OpenBCI_Radios_Class::writeBufferToSerial(char *buffer, int length) {
-  // Make sure we don't seg fault
-  if (buffer == NULL) return;
-
-  // Loop through all bytes in buffer
-  for (int i = 0; i < length; i++) {
-    Serial.write(buffer[i]);
+void OpenBCI_Radios_Class::traceReset(void) {
+  traceEnabled = false;
+  traceTotal = 0;
+  for (int i = 0; i < OPENBCI_TRACE_ENTRIES; i++) {
+    traceEntries[i].timeUs = 0;
+    traceEntries[i].len = 0;
+    traceEntries[i].byteId = 0;
+    traceEntries[i].rssi = 0;
+    traceEntries[i].action = 0;
   }
+  traceEnabled = true;
 }
 
 /**
-* @description Private function to clear the given buffer of length
+* @description Host: records one `RFduinoGZLL_onReceive`, call it before the
+*  frame is processed. Overwrites the oldest entry when the ring is full and
+*  does nothing while `printTrace` is reading the ring. The action only says
+*  what kind of frame it was, `traceAction` fills in the processing result.
+* @param `rssi` {int} - The RSSI Gazell reported.
+* @param `data` {char *} - The frame.
+* @param `len` {int} - The length of `data`.
 * @author AJ Keller (@pushtheworldllc)
 */
-void OpenBCI_Radios_Class::bufferCleanChar(char *buffer, int bufferLength) {
-  for (int i = 0; i < bufferLength; i++) {
-    buffer[i] = 0;
+void OpenBCI_Radios_Class::traceReceive(int rssi, char *data, int len) {
+  if (!traceEnabled) return;
+  TraceEntry *entry = traceEntries + (traceTotal & (OPENBCI_TRACE_ENTRIES - 1));
+  entry->timeUs = (uint32_t)timeMicros();
+  entry->len = (uint8_t)len;
+  entry->byteId = len > 0 ? (uint8_t)data[0] : 0;
+  entry->rssi = (int8_t)rssi;
+  if (len == 0) {
+    entry->action = OPENBCI_TRACE_ACTION_EMPTY;
+  } else if (len == 1) {
+    // The whole code is in `byteId`, it takes more than the low nibble
+    entry->action = OPENBCI_TRACE_ACTION_ORPM;
+  } else if (byteIdGetIsStream(data[0])) {
+    entry->action = OPENBCI_TRACE_ACTION_STREAM;
+  } else {
+    entry->action = OPENBCI_TRACE_ACTION_PROCESS;
   }
+  traceTotal++;
 }
 
 /**
-* @description Private function to clean a PacketBuffer.
+* @description Host: sets the action of the newest entry, if that entry is a
+*  multi packet frame still waiting on its `bufferRadioProcessPacket` result.
+* @param `action` {uint8_t} - `OPENBCI_TRACE_ACTION_PROCESS` ORed with the
+*  result.
 * @author AJ Keller (@pushtheworldllc)
 */
-void OpenBCI_Radios_Class::bufferCleanPacketBuffer(PacketBuffer *packetBuffer, int numberOfPackets) {
-  for(int i = 0; i < numberOfPackets; i++) {
-    packetBuffer[i].positionRead = 0;
-    packetBuffer[i].positionWrite = 1;
+void OpenBCI_Radios_Class::traceAction(uint8_t action) {
+  if (!traceEnabled || traceTotal == 0) return;
+  TraceEntry *entry = traceEntries + ((traceTotal - 1) & (OPENBCI_TRACE_ENTRIES - 1));
+  if (entry->action == OPENBCI_TRACE_ACTION_PROCESS) {
+    entry->action = action;
   }
 }
 
 /**
-* @description Private function to clean a PacketBuffer.
+* @description Host: writes the trace ring to the driver, oldest entry first.
+*  A text line "Success: Trace entries:<n> total:<t>$$$" gives the number of
+*  entries that follow and how many frames were recorded since the reset,
+*  then come n entries of OPENBCI_TRACE_ENTRY_BYTES bytes each: time in us
+*  (4 bytes, little endian), length, byte id, RSSI (signed) and action.
+*  Frames that arrive while the ring is written out are not recorded.
+*  Recording carries on afterwards without clearing the ring.
 * @author AJ Keller (@pushtheworldllc)
 */
-void OpenBCI_Radios_Class::bufferCleanCompletePacketBuffer(PacketBuffer *packetBuffer, int numberOfPackets) {
-  for(int i = 0; i < numberOfPackets; i++) {
-    packetBuffer[i].positionRead = 0;
-    packetBuffer[i].positionWrite = 0;
+void OpenBCI_Radios_Class::printTrace(void) {
+  traceEnabled = false;
+  uint32_t total = traceTotal;
+  uint32_t count = total < OPENBCI_TRACE_ENTRIES ? total : OPENBCI_TRACE_ENTRIES;
+  printSuccess();
+  Serial.print("Trace entries:");
+  Serial.print((unsigned long)count);
+  Serial.print(" total:");
+  Serial.print((unsigned long)total);
+  printEOT();
+  uint8_t out[OPENBCI_TRACE_ENTRY_BYTES];
+  for (uint32_t i = total - count; i != total; i++) {
+    TraceEntry *entry = traceEntries + (i & (OPENBCI_TRACE_ENTRIES - 1));
+    out[0] = (uint8_t)entry->timeUs;
+    out[1] = (uint8_t)(entry->timeUs >> 8);
+    out[2] = (uint8_t)(entry->timeUs >> 16);
+    out[3] = (uint8_t)(entry->timeUs >> 24);
+    out[4] = entry->len;
+    out[5] = entry->byteId;
+    out[6] = (uint8_t)entry->rssi;
+    out[7] = entry->action;
+    Serial.write(out, OPENBCI_TRACE_ENTRY_BYTES);
   }
+  traceEnabled = true;
 }
 
+#endif
+
+/********************************************/
+/********************************************/
+/***********    DEVICE CODE    **************/
+/********************************************/
+/********************************************/
+
 /**
-* @description Private function to clean (clear/reset) a Buffer.
+* @description Private function to handle a request to read serial as a device
+* @return {boolean} - `true` if there is data to read, `false` if not...
 * @author AJ Keller (@pushtheworldllc)
 */
-void OpenBCI_Radios_Class::bufferCleanBuffer(Buffer *buffer, int numberOfPacketsToClean) {
-  bufferCleanPacketBuffer(buffer->packetBuffer,numberOfPacketsToClean);
-  buffer->numberOfPacketsToSend = 0;
-  buffer->numberOfPacketsSent = 0;
-  buffer->overflowed = false;
+boolean OpenBCI_Radios_Class::didPicSendDeviceSerialData(void) {
+  return Serial.available() > 0;
 }
 
 /**
-* @description Private function to clean (clear/reset) a Buffer.
+* @description Device: takes every byte the UART holds in one pass, at most
+*  OPENBCI_INGEST_MAX_BYTES, and hands them to `ingestSerial(data, len)`.
+*  Reads nothing while `OPENBCI_STREAM_OVERFLOW_BLOCK` holds a finished packet
+*  at the head of a full ring.
+* @returns {int} - The number of bytes read.
 * @author AJ Keller (@pushtheworldllc)
 */
-void OpenBCI_Radios_Class::bufferCleanCompleteBuffer(Buffer *buffer, int numberOfPacketsToClean) {
+int OpenBCI_Radios_Class::ingestSerial(void) {
+  if (streamOverflowPolicy == OPENBCI_STREAM_OVERFLOW_BLOCK &&
+      streamPacketBuffer[streamPacketBufferHead].state == STREAM_STATE_READY &&
+      bufferStreamFull()) {
+    // A finished packet waits for room in the ring, a 34th byte now would
+    //  turn it into a page
+    return 0;
+  }
+  char chunk[OPENBCI_INGEST_MAX_BYTES];
+  int len = Serial.available();
+  if (len <= 0) return 0;
+  if (len > OPENBCI_INGEST_MAX_BYTES) len = OPENBCI_INGEST_MAX_BYTES;
+  for (int i = 0; i < len; i++) {
+    chunk[i] = (char)Serial.read();
+  }
+  return ingestSerial(chunk, len);
+}
+
+/**
+* @description Device: feeds bytes from the Pic through `ingestChar`, the same
+*  as reading them one loop pass at a time. `lastTimeSerialRead` and the poll
+*  timer are set once for the lot.
+* @param `data` {char *} - The bytes read from the Pic.
+* @param `len` {int} - The length of `data`.
+* @returns {int} - `len`
+* @author AJ Keller (@pushtheworldllc)
+*/
+int OpenBCI_Radios_Class::ingestSerial(const char *data, int len) {
+  if (len <= 0) return 0;
+  // Mark the last serial as now
+  lastTimeSerialRead = timeMicros();
+  for (int i = 0; i < len; i++) {
+    ingestChar(data[i]);
+  }
+  // Reset the poll timer to prevent contacting the host mid read
+  pollRefresh();
+  return len;
+}
+
+/**
+* @description Device: writes one byte from the Pic to exactly one place. A
+*  0x41 seen while the head stream packet buffer is empty starts a candidate
+*  stream packet, which goes only to the stream packet buffer. Everything else
+*  goes only to the serial buffer. A candidate that turns out not to be a
+*  stream packet, a bad tail byte or a 34th byte, is copied to the serial
+*  buffer in order by `ingestRelease`, so pages that happen to contain 0x41
+*  come out the same as before.
+* @param `newChar` {char} - The byte read from the Pic.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::ingestChar(char newChar) {
+  StreamPacketBuffer *buf = streamPacketBuffer + streamPacketBufferHead;
+  if (ingestCandidate) {
+    switch (buf->state) {
+      case STREAM_STATE_STORING:
+      bufferStreamAddChar(buf, newChar);
+      return;
+      case STREAM_STATE_TAIL:
+      if (isATailByte(newChar)) {
+        bufferStreamAddChar(buf, newChar);
+        return;
+      }
+      // Not a stream packet, but this byte may start the next one
+      ingestRelease(buf);
+      break;
+      case STREAM_STATE_READY:
+      // Got a 34th byte before the stream timeout, this is a page
+      ingestRelease(buf);
+      bufferSerialAddChar(newChar);
+      return;
+      default:
+      ingestCandidate = false;
+      break;
+    }
+  } else if (buf->state != STREAM_STATE_INIT) {
+    // A full ring left a committed packet at the head, it goes as before
+    bufferSerialAddChar(newChar);
+    bufferStreamAddChar(buf, newChar);
+    return;
+  }
+
+  if (newChar == OPENBCI_STREAM_PACKET_HEAD) {
+    ingestCandidate = true;
+    bufferStreamAddChar(buf, newChar);
+  } else {
+    bufferSerialAddChar(newChar);
+  }
+}
+
+/**
+* @description Device: gives up on the candidate stream packet in `buf` and
+*  copies its bytes to the serial buffer.
+* @param `buf` {StreamPacketBuffer *} - The head stream packet buffer.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::ingestRelease(StreamPacketBuffer *buf) {
+  for (int i = 0; i < buf->bytesIn; i++) {
+    bufferSerialAddChar(buf->data[i]);
+  }
+  if (buf->state == STREAM_STATE_READY) {
+    bufferSerialAddChar(buf->typeByte);
+  }
+  bufferStreamReset(buf);
+  ingestCandidate = false;
+}
+
+/**
+* @description Device: a candidate stream packet that stopped short of its
+*  tail byte for as long as a serial page takes to time out was the end of a
+*  page. Call from the loop before looking for a page to send.
+* @returns {boolean} - `true` if the candidate's bytes moved to the serial buffer.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::ingestTimeout(void) {
+  StreamPacketBuffer *buf = streamPacketBuffer + streamPacketBufferHead;
+  if (!ingestCandidate || buf->state == STREAM_STATE_READY || !bufferSerialTimeout()) {
+    return false;
+  }
+  ingestRelease(buf);
+  return true;
+}
+
+/**
+* @description Sends a null byte to the host
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::sendPollMessageToHost(void) {
+  RFduinoGZLL.sendToHost(NULL,0);
+}
+
+/**
+* @description Sends a one byte long message to the host
+* @param msg {byte} - A single byte to send to the host
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::sendRadioMessageToHost(byte msg) {
+  RFduinoGZLL.sendToHost((const char*)msg,1);
+}
+
+void OpenBCI_Radios_Class::setByteIdForPacketBuffer(int packetNumber) {
+  char byteId = byteIdMake(false,packetNumber,(bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->data + 1, (bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->positionWrite - 1);
+
+  // Add the byteId to the packet
+  (bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->data[0] = byteId;
+}
+
+/**
+* @description Called from Devices to send a packet to Host. Uses global
+*  variables to send the correct packet.
+* @returns {boolean} - The packet number sent.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::sendPacketToHost(void) {
+
+  // Reset the stream buffers
+  bufferStreamReset();
+
+  int packetNumber = bufferSerial.numberOfPacketsToSend - bufferSerial.numberOfPacketsSent - 1;
+
+  // Make the byteId
+  char byteId = byteIdMake(false,packetNumber,(bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->data + 1, (bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->positionWrite - 1);
+
+  // Add the byteId to the packet
+  (bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->data[0] = byteId;
+
+  if (RFduinoGZLL.sendToHost((char *)(bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->data, (bufferSerial.packetBuffer + bufferSerial.numberOfPacketsSent)->positionWrite)) {
+    pollRefresh();
+
+    bufferSerial.numberOfPacketsSent++;
+
+    return true;
+  }
+
+  return false;
+}
+
+/**
+* @description Test to see if a char follows the stream tail byte format
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::isATailByte(uint8_t newChar) {
+  return (newChar >> 4) == 0xC;
+}
+
+/**
+* @description Sends a soft reset command to the Pic 32 incase of an emergency.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::resetPic32(void) {
+  Serial.write('v');
+}
+
+/********************************************/
+/********************************************/
+/*************    PASS THRU    **************/
+/********************************************/
+/********************************************/
+
+/**
+* @description Used to flash the led to indicate to the user the device is in pass through mode.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::ledFeedBackForPassThru(void) {
+  digitalWrite(OPENBCI_PIN_HOST_LED,HIGH);
+  delay(600);
+  digitalWrite(OPENBCI_PIN_HOST_LED,LOW);
+  delay(200);
+}
+
+/********************************************/
+/********************************************/
+/********    COMMON MEHTOD CODE    **********/
+/********************************************/
+/********************************************/
+
+/**
+* @description Writes a buffer to the serial port of a given length, after
+*  anything waiting in `bufferOutput` so the order holds.
+* @param buffer [char *] The buffer you want to write out
+* @param length [int] How many bytes to you want to write out?
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::writeBufferToSerial(char *buffer, int length) {
+  // Make sure we don't seg fault
+  if (buffer == NULL) return;
+
+  bufferOutputDrain();
+  bufferOutputTxAdd(length);
+  Serial.write((const uint8_t *)buffer, length);
+}
+
+/**
+* @description Host: adds bytes for the PC to `bufferOutput`, writing out what
+*  the UART has room for first if they do not fit. These are pages, often a
+*  reply the driver is waiting on, so if they still do not fit they wait for
+*  the UART with `bufferOutputDrain` rather than being dropped. More than the
+*  whole buffer goes straight to the serial port.
+* @param `data` {const char *} - The bytes to add.
+* @param `len` {int} - How many.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferOutputAddData(const char *data, int len) {
+  if (len > OPENBCI_BUFFER_LENGTH_OUTPUT) {
+    bufferOutputDrain();
+    bufferOutputTxAdd(len);
+    Serial.write((const uint8_t *)data, len);
+    return;
+  }
+  if (bufferOutputLength + len > OPENBCI_BUFFER_LENGTH_OUTPUT) {
+    bufferOutputFlush();
+    if (bufferOutputLength + len > OPENBCI_BUFFER_LENGTH_OUTPUT) {
+      bufferOutputDrain();
+    }
+  }
+  if (bufferOutputLength == 0) {
+    bufferOutputSinceUs = timeMicros();
+  }
+  for (int i = 0; i < len; i++) {
+    bufferOutput[bufferOutputLength + i] = data[i];
+  }
+  bufferOutputLength += len;
+}
+
+/**
+* @description Host: adds a 33 byte stream packet to `bufferOutput`, the head
+*  byte, the 31 bytes of `data` and `stopByte`. A packet there is no room for
+*  even after a flush means the PC is not keeping up, it is thrown away and
+*  counted in `outputDrops`.
+* @param `data` {const char *} - The sample number, channel and aux data.
+* @param `stopByte` {uint8_t} - The tail byte.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferOutputAddStreamPacket(const char *data, uint8_t stopByte) {
+  if (bufferOutputLength + OPENBCI_MAX_PACKET_SIZE_BYTES + 1 > OPENBCI_BUFFER_LENGTH_OUTPUT) {
+    bufferOutputFlush();
+    if (bufferOutputLength + OPENBCI_MAX_PACKET_SIZE_BYTES + 1 > OPENBCI_BUFFER_LENGTH_OUTPUT) {
+      outputDrops++;
+      return;
+    }
+  }
+  if (bufferOutputLength == 0) {
+    bufferOutputSinceUs = timeMicros();
+  }
+  char *out = bufferOutput + bufferOutputLength;
+  out[0] = 0xA0;
+  for (int i = 0; i < OPENBCI_MAX_DATA_BYTES_IN_PACKET; i++) {
+    out[i + 1] = data[i];
+  }
+  out[OPENBCI_MAX_DATA_BYTES_IN_PACKET + 1] = stopByte;
+  bufferOutputLength += OPENBCI_MAX_PACKET_SIZE_BYTES + 1;
+#ifdef OPENBCI_PERF_COUNTERS
+  latencyOutputPackets++;
+#endif
+}
+
+/**
+* @description Host: writes all of `bufferOutput` to the PC, waiting on the
+*  UART if it has to. Only for pages and replies to the driver, which have to
+*  come after what the PC was already owed and must not be dropped.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferOutputDrain(void) {
+  if (bufferOutputLength == 0) return;
+  bufferOutputWrite(bufferOutputLength);
+}
+
+/**
+* @description Host: writes as much of `bufferOutput` to the PC as the UART
+*  has room for, see `bufferOutputRoom`, with one block write, and never
+*  waits for it. What is left goes out on a later pass. Call when
+*  `bufferOutputReady` after the stream and radio buffers are flushed.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferOutputFlush(void) {
+  if (bufferOutputLength == 0) return;
+  int room = bufferOutputRoom();
+  if (room <= 0) return;
+  bufferOutputWrite(room < bufferOutputLength ? room : bufferOutputLength);
+}
+
+/**
+* @description Host: how many bytes `Serial.write` can take right now without
+*  waiting. The RFduino core's Serial has no `availableForWrite()`, so this is
+*  worked out from the bytes `bufferOutputTxAdd` was told about and how long
+*  the UART takes to send them at `outputBaud`. It rounds towards less room,
+*  and nothing holds the UART back, the PC reading or not, so the guess is
+*  never more room than there is.
+* @returns {int} - Free bytes in the UART's TX ring, up to
+*  `OPENBCI_SERIAL_TX_BUFFER_BYTES`.
+* @author AJ Keller (@pushtheworldllc)
+*/
+int OpenBCI_Radios_Class::bufferOutputRoom(void) {
+  long leftUs = (long)(outputTxDoneUs - timeMicros());
+  if (leftUs <= 0) return OPENBCI_SERIAL_TX_BUFFER_BYTES;
+  // Bytes still in the ring, rounded up, at 100 baud a bit per 10ms
+  uint32_t queued = ((uint32_t)leftUs * (outputBaud / 100) + OPENBCI_SERIAL_BITS_PER_BYTE * 10000UL - 1) / (OPENBCI_SERIAL_BITS_PER_BYTE * 10000UL);
+  if (queued >= OPENBCI_SERIAL_TX_BUFFER_BYTES) return 0;
+  return OPENBCI_SERIAL_TX_BUFFER_BYTES - queued;
+}
+
+/**
+* @description Host: call before handing `len` bytes to `Serial.write`, moves
+*  on the time the UART will be done with them for `bufferOutputRoom`.
+* @param `len` {int} - How many.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferOutputTxAdd(int len) {
+  unsigned long now = timeMicros();
+  if ((long)(outputTxDoneUs - now) < 0) {
+    outputTxDoneUs = now;
+  }
+  uint32_t baud = outputBaud / 100;
+  outputTxDoneUs += ((uint32_t)len * OPENBCI_SERIAL_BITS_PER_BYTE * 10000UL + baud - 1) / baud;
+}
+
+/**
+* @description Host: writes the first `len` bytes of `bufferOutput` to the PC
+*  and moves the rest to the front.
+* @param `len` {int} - How many, no more than `bufferOutputLength`.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferOutputWrite(int len) {
+#ifdef OPENBCI_PERF_COUNTERS
+  unsigned long writeUs = timeMicros();
+#endif
+  bufferOutputTxAdd(len);
+  Serial.write((const uint8_t *)bufferOutput, len);
+  bufferOutputLength -= len;
+  if (bufferOutputLength > 0) {
+    memmove(bufferOutput, bufferOutput + len, bufferOutputLength);
+    return;
+  }
+#ifdef OPENBCI_PERF_COUNTERS
+  writeUs = timeMicros() - writeUs;
+  for (; latencyOutputPackets > 0; latencyOutputPackets--) {
+    latencyAdd(LATENCY_STAGE_SERIAL, writeUs);
+  }
+#endif
+}
+
+/**
+* @description Host: is it time to write `bufferOutput` to the PC? In
+*  OPENBCI_OUTPUT_MODE_LATENCY as soon as it has anything, in
+*  OPENBCI_OUTPUT_MODE_THROUGHPUT once it holds `outputBudgetBytes` or its
+*  first byte has waited `outputBudgetUs`, so the PC gets fewer, fuller USB
+*  transfers.
+* @returns {boolean} - `true` to call `bufferOutputFlush`
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferOutputReady(void) {
+  if (bufferOutputLength == 0) return false;
+  if (outputMode != OPENBCI_OUTPUT_MODE_THROUGHPUT) return true;
+  return bufferOutputLength >= outputBudgetBytes || timeElapsedMicros(bufferOutputSinceUs, outputBudgetUs);
+}
+
+/**
+* @description Private function to clear the given buffer of length
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferCleanChar(char *buffer, int bufferLength) {
+  for (int i = 0; i < bufferLength; i++) {
+    buffer[i] = 0;
+  }
+}
+
+/**
+* @description Private function to clean a PacketBuffer.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferCleanPacketBuffer(PacketBuffer *packetBuffer, int numberOfPackets) {
+  for(int i = 0; i < numberOfPackets; i++) {
+    packetBuffer[i].positionRead = 0;
+    packetBuffer[i].positionWrite = 1;
+  }
+}
+
+/**
+* @description Private function to clean a PacketBuffer.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferCleanCompletePacketBuffer(PacketBuffer *packetBuffer, int numberOfPackets) {
+  for(int i = 0; i < numberOfPackets; i++) {
+    packetBuffer[i].positionRead = 0;
+    packetBuffer[i].positionWrite = 0;
+  }
+}
+
+/**
+* @description Private function to clean (clear/reset) a Buffer.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferCleanBuffer(Buffer *buffer, int numberOfPacketsToClean) {
+  bufferCleanPacketBuffer(buffer->packetBuffer,numberOfPacketsToClean);
+  buffer->numberOfPacketsToSend = 0;
+  buffer->numberOfPacketsSent = 0;
+  buffer->overflowed = false;
+}
+
+/**
+* @description Private function to clean (clear/reset) a Buffer.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferCleanCompleteBuffer(Buffer *buffer, int numberOfPacketsToClean) {
   bufferCleanCompletePacketBuffer(buffer->packetBuffer,numberOfPacketsToClean);
   buffer->numberOfPacketsToSend = 0;
   buffer->numberOfPacketsSent = 0;
@@ -1144,19 +2157,20 @@ void OpenBCI_Radios_Class::bufferRadioClean(BufferRadio *buf) {
 * @author AJ Keller (@pushtheworldllc)
 */
 void OpenBCI_Radios_Class::bufferRadioFlush(BufferRadio *buf) {
+  OPENBCI_PERF_START(start);
   // Lock this buffer down!
   buf->flushing = true;
   if (debugMode) {
+    bufferOutputDrain();
     for (int j = 0; j < buf->positionWrite; j++) {
       Serial.print(buf->data[j]);
     }
     Serial.println();
   } else {
-    for (int j = 0; j < buf->positionWrite; j++) {
-      Serial.write(buf->data[j]);
-    }
+    bufferOutputAddData(buf->data, buf->positionWrite);
   }
   buf->flushing = false;
+  OPENBCI_PERF_END(*this, PERF_SECTION_RADIO_FLUSH, start);
 }
 
 /**
@@ -1402,13 +2416,43 @@ boolean OpenBCI_Radios_Class::bufferSerialAddChar(char newChar) {
 }
 
 /**
-* @description If there are packets to be sent in the serial buffer.
-* @return {boolean} - `true` if there are packets waiting to be sent from the
-*  serial buffer, `false` if not...
+* @description Adds every char of a string to the serial buffer, used for the
+*  text replies the Device sends up to the driver.
+* @param `str` {char *} - The null terminated string to add.
 * @author AJ Keller (@pushtheworldllc)
 */
-boolean OpenBCI_Radios_Class::bufferSerialHasData(void) {
-  return bufferSerial.numberOfPacketsSent < bufferSerial.numberOfPacketsToSend;
+void OpenBCI_Radios_Class::bufferSerialAddString(const char *str) {
+  while (*str) {
+    bufferSerialAddChar(*str++);
+  }
+}
+
+/**
+* @description Adds `n` to the serial buffer in decimal.
+* @param `n` {uint32_t} - The number to add.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferSerialAddNumber(uint32_t n) {
+  // Digits come out backwards
+  char digits[10];
+  int len = 0;
+  do {
+    digits[len++] = '0' + (n % 10);
+    n /= 10;
+  } while (n > 0);
+  while (len > 0) {
+    bufferSerialAddChar(digits[--len]);
+  }
+}
+
+/**
+* @description If there are packets to be sent in the serial buffer.
+* @return {boolean} - `true` if there are packets waiting to be sent from the
+*  serial buffer, `false` if not...
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferSerialHasData(void) {
+  return bufferSerial.numberOfPacketsSent < bufferSerial.numberOfPacketsToSend;
 }
 
 /**
@@ -1432,7 +2476,7 @@ void OpenBCI_Radios_Class::bufferSerialReset(uint8_t n) {
 * @author AJ Keller (@pushtheworldllc)
 */
 boolean OpenBCI_Radios_Class::bufferSerialTimeout(void) {
-  return micros() > (lastTimeSerialRead + OPENBCI_TIMEOUT_PACKET_NRML_uS);
+  return timeElapsedMicros(lastTimeSerialRead, timeoutPacketNormalUs);
 }
 
 /**
@@ -1452,6 +2496,10 @@ void OpenBCI_Radios_Class::bufferStreamAddChar(StreamPacketBuffer *buf, char new
       buf->typeByte = newChar;
       // Change the state to ready
       buf->state = STREAM_STATE_READY;
+#ifdef OPENBCI_PERF_COUNTERS
+      // The sketch stamps every byte it reads
+      buf->ingestUs = lastTimeSerialRead;
+#endif
       // Serial.print(33); Serial.print(" state: "); Serial.print("READY-");
       // Serial.println((streamPacketBuffer + streamPacketBufferHead)->state);
     } else {
@@ -1512,138 +2560,1201 @@ void OpenBCI_Radios_Class::bufferStreamAddChar(StreamPacketBuffer *buf, char new
 }
 
 /**
-* @description Used to add a packet to the of steaming data to the current
-*  `streamPacketBufferHead` and then increment the head. Will wrap around if
-*  need be to avoid moving the head past `OPENBCI_NUMBER_STREAM_BUFFERS`.
-* @param `data` {char *} - The data packet you want to add of length
-*  `OPENBCI_MAX_PACKET_SIZE_BYTES` (32)
-* @returns {boolean} - `true` if able to add it. Currently this func will always
-*  return `true`, however this allows for greater flexiblity in the future.
+* @description Used to add a packet to the of steaming data to the current
+*  `streamPacketBufferHead` and then increment the head. Will wrap around if
+*  need be to avoid moving the head past `numberOfStreamBuffers`. When the ring
+*  is full `streamOverflowPolicy` picks the packet that is lost and
+*  `streamDrops` counts it.
+* @param `data` {char *} - The data packet you want to add of length
+*  `OPENBCI_MAX_PACKET_SIZE_BYTES` (32)
+* @returns {boolean} - `true` if able to add it, `false` if the ring was full
+*  and the new packet was dropped.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamAddData(char *data) {
+  if (bufferStreamFull()) {
+    streamDrops++;
+    if (streamOverflowPolicy != OPENBCI_STREAM_OVERFLOW_DROP_OLDEST) {
+      streamDeltaBreak = true;
+      return false;
+    }
+    StreamPacketBuffer *oldest = streamPacketBuffer + streamPacketBufferTail;
+    if (streamPacketBufferTail == streamParityHole) {
+      streamParityHole = OPENBCI_STREAM_PARITY_NO_HOLE;
+    }
+    bufferStreamRetransmitForget(streamPacketBufferTail);
+    bufferStreamReset(oldest);
+    streamPacketBufferTail++;
+    if (streamPacketBufferTail >= numberOfStreamBuffers) {
+      streamPacketBufferTail = 0;
+    }
+    streamPacketBuffer[streamPacketBufferTail].deltaBreak = true;
+  }
+
+  bufferStreamStoreData(streamPacketBuffer + streamPacketBufferHead, data);
+  if (streamDeltaBreak) {
+    streamPacketBuffer[streamPacketBufferHead].deltaBreak = true;
+    streamDeltaBreak = false;
+  }
+#ifdef OPENBCI_PERF_COUNTERS
+  streamPacketBuffer[streamPacketBufferHead].ingestUs = timeMicros();
+#endif
+
+  streamPacketBufferHead++;
+  if (streamPacketBufferHead >= numberOfStreamBuffers) {
+    streamPacketBufferHead = 0;
+  }
+
+  return true;
+}
+
+/**
+* @description Host: called by the radio ISR with a stream packet, copies it
+*  to `streamDeferred` for `bufferStreamProcessDeferred` and nothing else. One
+*  that finds it full is dropped and counted in `streamDeferredDropped`.
+* @param `data` {char *} - A stream packet with its byteId, 32 bytes.
+* @returns {boolean} - `true` if there was room.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamDefer(char *data) {
+  StreamFrame *frame = streamDeferred.back();
+  if (frame == NULL) {
+    streamDeferredDropped++;
+    return false;
+  }
+  for (int i = 0; i < OPENBCI_MAX_PACKET_SIZE_BYTES; i++) {
+    frame->data[i] = data[i];
+  }
+  // Only seen by `loop()` once the copy is done
+  streamDeferred.push();
+  return true;
+}
+
+/**
+* @description Host: takes apart, in order, every stream packet the radio ISR
+*  left in `streamDeferred`, see `bufferStreamReceive`, and the Device's
+*  packing switches between them. Call from `loop()`
+*  before `bufferStreamFlushBuffers`. Packets the ISR had to drop count in
+*  `streamDrops` and break the delta chain like a full ring. Lost packets it
+*  finds are asked for on the next ACK payload.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamProcessDeferred(void) {
+  uint8_t dropped = streamDeferredDropped;
+  if (dropped != streamDeferredDroppedSeen) {
+    streamDrops += (uint8_t)(dropped - streamDeferredDroppedSeen);
+    streamDeferredDroppedSeen = dropped;
+    streamDeltaBreak = true;
+  }
+  StreamFrame *frame;
+  while ((frame = streamDeferred.front()) != NULL) {
+    if (byteIdGetIsStream(frame->data[0])) {
+      bufferStreamReceive(frame->data);
+    } else {
+      bufferStreamDeltaSwitched(frame->data[0]);
+    }
+    // Give the slot back to the ISR only after reading it
+    streamDeferred.pop();
+  }
+  // Ask for lost ones on the next ACK, as the ISR would have when it took
+  //  the packet apart itself
+  if (streamNack) {
+    noInterrupts();
+    bufferStreamNackSend(DEVICE0);
+    interrupts();
+  }
+}
+
+/**
+* @description Host: the Device switched packing, `ORPM_STREAM_DELTA_SET` or
+*  one more. Comes in through `streamDeferred` in line with the stream packets
+*  it was sent between.
+* @param `newChar` {char} - The Device's echo.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamDeltaSwitched(char newChar) {
+  bufferStreamDeltaSet((uint8_t)newChar == ORPM_STREAM_DELTA_SET + 1);
+  msgToPrint = HOST_MESSAGE_STREAM_DELTA;
+  printMessageToDriverFlag = true;
+}
+
+/**
+* @description Host: a stream packet from the Device. A repeat of the last
+*  numbered packet is dropped, one sent again fills its gap marker, a parity
+*  frame may rebuild a lost one, and anything else goes on the ring for
+*  `bufferStreamFlushBuffers`.
+* @param `data` {char *} - A stream packet with its byteId, 32 bytes.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamReceive(char *data) {
+  if (bufferStreamRetransmitCheck(data)) {
+    // Sent again, it went into its gap marker's slot
+  } else if (byteIdGetStreamSequence(data[0]) == 0 && streamSequenceLast != 0) {
+    // Only a Device that numbers its packets sends parity frames
+    bufferStreamParityRebuild(data);
+  } else if (bufferStreamSequenceCheck(data[0])) {
+    streamParityPending = false;
+    if (streamParityGroup > 0) {
+      bufferStreamParityReceive(data);
+    }
+    bufferStreamAddData(data);
+  }
+}
+
+/**
+* @description Host: queues a gap marker in place of `missed` numbered stream
+*  packets that never came. The marker goes out like a stream packet, a head
+*  byte, `missed`, 30 zeros and the tail byte `0xCF`
+*  (OPENBCI_STREAM_PACKET_TYPE_GAP), so the driver sees where the loss was.
+* @param `missed` {uint8_t} - The number of stream packets lost.
+* @returns {boolean} - `true` if the marker was queued.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamAddGap(uint8_t missed) {
+  char marker[OPENBCI_MAX_PACKET_SIZE_BYTES];
+  for (int i = 1; i < OPENBCI_MAX_PACKET_SIZE_BYTES; i++) {
+    marker[i] = 0;
+  }
+  marker[0] = byteIdMake(true,OPENBCI_STREAM_PACKET_TYPE_GAP,marker + 1, OPENBCI_MAX_DATA_BYTES_IN_PACKET);
+  marker[1] = (char)missed;
+  uint8_t slot = streamPacketBufferHead;
+  if (!bufferStreamAddData(marker)) {
+    return false;
+  }
+  streamPacketBuffer[slot].gap = true;
+  return true;
+}
+
+/**
+* @description XORs the packet type and data of a stream packet into
+*  `streamParityFrame`, the same on both radios so a parity frame and the
+*  packets that came cancel out to the one that did not.
+* @param `data` {char *} - A stream packet with its byteId, 32 bytes.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamParityAdd(char *data) {
+  streamParityFrame[0] ^= data[0] & 0x78;
+  for (int i = 1; i < OPENBCI_MAX_PACKET_SIZE_BYTES; i++) {
+    streamParityFrame[i] ^= data[i];
+  }
+}
+
+/**
+* @description Host: adds a numbered stream packet to its parity group. The
+*  numbers count whole groups, so packet `n` is at `(n - 1) % streamParityGroup`
+*  in group `(n - 1) / streamParityGroup`. A packet from another group, or at
+*  a position the group already has, ends the one so far, its parity frame
+*  was lost. A single packet lost right in
+*  front of this one in the same group leaves its gap marker held in the ring
+*  as `streamParityHole`, see `bufferStreamParityHold`.
+* @param `data` {char *} - A stream packet with its byteId, 32 bytes.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamParityReceive(char *data) {
+  uint8_t index = byteIdGetStreamSequence(data[0]) - 1;
+  uint8_t group = index / streamParityGroup;
+  uint8_t position = index % streamParityGroup;
+  if (group != streamParityGroupAt || (streamParityReceived >> position) != 0) {
+    bufferStreamParityReset();
+    streamParityGroupAt = group;
+  }
+  if (streamSequenceGap == 1 && position > 0) {
+    streamParityHole = streamSequenceGapAt;
+    streamParityHoleSinceUs = timeMicros();
+  }
+  streamParityReceived |= 1 << position;
+  bufferStreamParityAdd(data);
+}
+
+/**
+* @description Host: should the packet at `slot` stay in the ring? Only the
+*  gap marker waiting on its parity frame, for up to
+*  OPENBCI_STREAM_PARITY_HOLE_TIMEOUT_uS. A stream that stops mid group, or
+*  whose Device stopped numbering, never sends that frame, so after that the
+*  marker goes out as it is with the packets behind it.
+* @param `slot` {uint8_t} - The index of the ring slot.
+* @returns {boolean} - `true` to hold it.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamParityHold(uint8_t slot) {
+  if (slot != streamParityHole) {
+    return false;
+  }
+  if (!timeElapsedMicros(streamParityHoleSinceUs, OPENBCI_STREAM_PARITY_HOLE_TIMEOUT_uS)) {
+    return true;
+  }
+  streamParityHole = OPENBCI_STREAM_PARITY_NO_HOLE;
+  return false;
+}
+
+/**
+* @description Host: ends the parity group with its parity frame. If exactly
+*  one packet of the group is missing it is rebuilt, into its held gap marker
+*  or, when it was the last of the group, at the head of the ring as no later
+*  packet found it missing yet. Two parity frames in a row mean a whole group
+*  was lost or the Device stopped numbering its packets, either way the Host
+*  stops expecting numbers until the next numbered packet.
+* @param `parity` {char *} - The parity frame, 32 bytes.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamParityRebuild(char *parity) {
+  if (streamParityPending) {
+    streamSequenceLast = 0;
+    bufferStreamParityReset();
+    return;
+  }
+  if (streamParityGroup > 0 && streamParityGroupAt != OPENBCI_STREAM_PARITY_NO_HOLE) {
+    uint8_t missing = ((1 << streamParityGroup) - 1) & ~streamParityReceived;
+    uint8_t last = 1 << (streamParityGroup - 1);
+    boolean fillHole = missing != last && streamParityHole != OPENBCI_STREAM_PARITY_NO_HOLE && (missing & (missing - 1)) == 0;
+    if (missing == last || fillHole) {
+      bufferStreamParityAdd(parity);
+      streamParityFrame[0] = (streamParityFrame[0] & 0x78) | 0x80;
+      if (fillHole) {
+        bufferStreamStoreData(streamPacketBuffer + streamParityHole, streamParityFrame);
+        bufferStreamRetransmitForget(streamParityHole);
+      } else {
+        // Lost on air too, the next packet won't find a gap
+        bufferStreamAddData(streamParityFrame);
+        streamSequenceMissed++;
+        streamSequenceLast = (streamParityGroupAt + 1) * streamParityGroup;
+      }
+      streamParityRecovered++;
+    }
+  }
+  bufferStreamParityReset();
+  streamParityPending = true;
+}
+
+/**
+* @description Starts a new parity group, which lets go of a held gap marker.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamParityReset(void) {
+  for (int i = 0; i < OPENBCI_MAX_PACKET_SIZE_BYTES; i++) {
+    streamParityFrame[i] = 0;
+  }
+  streamParityCount = 0;
+  streamParityPending = false;
+  streamParityReceived = 0;
+  streamParityGroupAt = OPENBCI_STREAM_PARITY_NO_HOLE;
+  streamParityHole = OPENBCI_STREAM_PARITY_NO_HOLE;
+}
+
+/**
+* @description Sets the number of stream packets per parity frame. The
+*  sequence numbers then wrap at the largest multiple of it so every group
+*  starts on a known number, both radios start counting over.
+* @param `n` {uint8_t} - 0, off, or OPENBCI_STREAM_PARITY_GROUP_MIN to
+*  OPENBCI_STREAM_PARITY_GROUP_MAX.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamParitySet(uint8_t n) {
+  streamParityGroup = n;
+  if (n > 0) {
+    streamSequenceModulo = (OPENBCI_STREAM_SEQUENCE_MODULO / n) * n;
+  } else {
+    streamSequenceModulo = OPENBCI_STREAM_SEQUENCE_MODULO;
+  }
+  streamSequenceNext = 1;
+  streamSequenceLast = 0;
+  bufferStreamParityReset();
+}
+
+/**
+* @description Host: asks the Device for the stream packets in `streamNack`
+*  with one ORPM_STREAM_NACK on the ACK payload, unless something else is on
+*  it already or the Device expects a channel, poll time or baud code next.
+* @param `device` {device_t} - The device to send the request to.
+* @returns {boolean} - `true` if the request went on the ACK payload.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamNackSend(device_t device) {
+  if (streamNack == 0 || packetInTXRadioBuffer) {
+    return false;
+  }
+  if (isWaitingForNewChannelNumberConfirmation || isWaitingForNewPollTimeConfirmation || isWaitingForNewBaudRateConfirmation) {
+    return false;
+  }
+  singleCharMsg[0] = (char)(ORPM_STREAM_NACK | streamNack);
+  RFduinoGZLL.sendToDevice(device,singleCharMsg,1);
+  packetInTXRadioBuffer = true;
+  streamNack = 0;
+  return true;
+}
+
+/**
+* @description Host: is this stream packet one the Host asked for again? If
+*  its gap marker still waits it takes the marker's slot in the ring. One that
+*  comes after its marker gave up, or twice, is dropped as a repeat. A number
+*  `bufferStreamRetransmitWindow()` or more behind the last one is a new
+*  packet, the Device has wrapped around and no longer has the old one, as
+*  the Device sent newer packets before any packet it sends again.
+* @param `data` {char *} - A stream packet with its byteId, 32 bytes.
+* @returns {boolean} - `true` if the packet was one asked for again and needs
+*  nothing more.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamRetransmitCheck(char *data) {
+  uint8_t sequence = byteIdGetStreamSequence(data[0]);
+  if (sequence == 0 || (streamRetransmitAsked & (1 << (sequence - 1))) == 0) {
+    return false;
+  }
+  uint8_t bit = 1 << (sequence - 1);
+  if (bufferStreamRetransmitBehind(sequence) >= bufferStreamRetransmitWindow()) {
+    if (streamRetransmitWaiting & bit) {
+      streamRetransmitExpired++;
+    }
+    streamRetransmitAsked &= ~bit;
+    streamRetransmitWaiting &= ~bit;
+    return false;
+  }
+  if (streamRetransmitWaiting & bit) {
+    uint8_t slot = streamRetransmitSlot[sequence - 1];
+    bufferStreamStoreData(streamPacketBuffer + slot, data);
+    if (slot == streamParityHole) {
+      streamParityHole = OPENBCI_STREAM_PARITY_NO_HOLE;
+    }
+    streamRetransmitWaiting &= ~bit;
+    streamRetransmitRecovered++;
+  } else {
+    streamSequenceDuplicates++;
+  }
+  return true;
+}
+
+/**
+* @description Host: stops waiting on the gap marker at `slot`, which is
+*  leaving the ring.
+* @param `slot` {uint8_t} - The index of the ring slot.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamRetransmitForget(uint8_t slot) {
+  for (uint8_t i = 0; i < OPENBCI_STREAM_SEQUENCE_MODULO; i++) {
+    if ((streamRetransmitWaiting & (1 << i)) && streamRetransmitSlot[i] == slot) {
+      streamRetransmitWaiting &= ~(1 << i);
+    }
+  }
+}
+
+/**
+* @description Host: how far the last number is past `sequence`, 0 when it is
+*  the last one or the Host knows no last number.
+* @param `sequence` {uint8_t} - A stream sequence number, 1 or more.
+* @returns {uint8_t} - The number of packets.
+* @author AJ Keller (@pushtheworldllc)
+*/
+uint8_t OpenBCI_Radios_Class::bufferStreamRetransmitBehind(uint8_t sequence) {
+  if (streamSequenceLast == 0) {
+    return 0;
+  }
+  return (streamSequenceLast + streamSequenceModulo - sequence) % streamSequenceModulo;
+}
+
+/**
+* @description Host: should the packet at `slot` stay in the ring? Only a gap
+*  marker waiting on its packet, for up to `streamRetransmitTimeoutUs` and
+*  while the Device can still send it. After that it goes out as it is and
+*  counts in `streamRetransmitExpired`.
+* @param `slot` {uint8_t} - The index of the ring slot.
+* @returns {boolean} - `true` to hold it.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamRetransmitHold(uint8_t slot) {
+  if (streamRetransmitWaiting == 0) {
+    return false;
+  }
+  for (uint8_t i = 0; i < OPENBCI_STREAM_SEQUENCE_MODULO; i++) {
+    if ((streamRetransmitWaiting & (1 << i)) && streamRetransmitSlot[i] == slot) {
+      if (!timeElapsedMicros(streamRetransmitSinceUs[i], streamRetransmitTimeoutUs) && bufferStreamRetransmitBehind(i + 1) < bufferStreamRetransmitWindow()) {
+        return true;
+      }
+      streamRetransmitWaiting &= ~(1 << i);
+      streamRetransmitExpired++;
+      return false;
+    }
+  }
+  return false;
+}
+
+/**
+* @description Forgets every packet asked for, on the Device the requests from
+*  the Host, on the Host the requests to send and the markers waiting.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamRetransmitReset(void) {
+  streamNack = 0;
+  streamRetransmitAsked = 0;
+  streamRetransmitWaiting = 0;
+}
+
+/**
+* @description Device: sends the oldest stream packet the Host asked for again
+*  from `streamHistory`. Requests older than `bufferStreamRetransmitWindow()`
+*  are dropped, their number may be on a newer packet by now.
+* @returns {boolean} - `true` if a packet went on the TX FIFO, `false` if the
+*  FIFO is full, with `streamNack` left as is, or nothing was left to send.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamRetransmitSendToHost(void) {
+  // Oldest first, the Host lets its ring out in order
+  for (uint8_t age = bufferStreamRetransmitWindow(); age > 0; age--) {
+    uint8_t sequence = (streamSequenceNext + streamSequenceModulo - 1 - age) % streamSequenceModulo + 1;
+    uint8_t bit = 1 << (sequence - 1);
+    if (streamNack & bit) {
+      if (!RFduinoGZLL.sendToHost(streamHistory[sequence - 1], OPENBCI_MAX_PACKET_SIZE_BYTES)) {
+        return false;
+      }
+      streamNack &= ~bit;
+      streamRetransmitSent++;
+      pollRefresh();
+      return true;
+    }
+  }
+  streamNack = 0;
+  return false;
+}
+
+/**
+* @description Turns retransmission on or off, forgetting what was asked for.
+*  The Device numbers its packets whenever it is on.
+* @param `on` {boolean} - `true` to keep and ask for lost packets.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamRetransmitSet(boolean on) {
+  streamRetransmit = on;
+  bufferStreamRetransmitReset();
+}
+
+/**
+* @description How many of the last numbered packets can be asked for again,
+*  OPENBCI_STREAM_RETRANSMIT_WINDOW or one less than `streamSequenceModulo`,
+*  whichever is smaller, so a number is never on two packets in the window.
+* @returns {uint8_t} - The number of packets.
+* @author AJ Keller (@pushtheworldllc)
+*/
+uint8_t OpenBCI_Radios_Class::bufferStreamRetransmitWindow(void) {
+  if (streamSequenceModulo - 1 < OPENBCI_STREAM_RETRANSMIT_WINDOW) {
+    return streamSequenceModulo - 1;
+  }
+  return OPENBCI_STREAM_RETRANSMIT_WINDOW;
+}
+
+/**
+* @description Host: checks the sequence number of a stream packet against
+*  the last one. A repeat, a Gazell retry whose ACK was lost, is counted in
+*  `streamSequenceDuplicates` and refused. Numbers skipped are counted in
+*  `streamSequenceMissed` and a gap marker is queued for them, leaving the
+*  gap in `streamSequenceGap` and `streamSequenceGapAt`. With
+*  `streamRetransmit` a gap within `bufferStreamRetransmitWindow()` gets a
+*  marker per packet and the packets are asked for again. A packet
+*  without a number always passes. With `streamSequenceModulo` numbers, 7
+*  unless parity is on, a run of that many or more lost packets is
+*  miscounted, exactly that many even looks like a repeat.
+* @param `byteId` {uint8_t} - The byteId of the stream packet.
+* @returns {boolean} - `true` if the packet should be queued.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamSequenceCheck(uint8_t byteId) {
+  uint8_t sequence = byteIdGetStreamSequence(byteId);
+  streamSequenceGap = 0;
+  streamSequenceGapAt = OPENBCI_STREAM_PARITY_NO_HOLE;
+  if (sequence == 0) {
+    return true;
+  }
+  if (streamSequenceLast != 0) {
+    if (sequence == streamSequenceLast) {
+      streamSequenceDuplicates++;
+      return false;
+    }
+    uint8_t missed = (sequence + streamSequenceModulo - streamSequenceLast - 1) % streamSequenceModulo;
+    if (missed > 0) {
+      streamSequenceMissed += missed;
+      streamSequenceGap = missed;
+      uint8_t at = streamPacketBufferHead;
+      if (streamRetransmit && missed <= bufferStreamRetransmitWindow()) {
+        // A marker each, to be filled in when they come again
+        for (uint8_t i = 0; i < missed; i++) {
+          uint8_t lost = (streamSequenceLast + i) % streamSequenceModulo;
+          uint8_t slot = streamPacketBufferHead;
+          if (bufferStreamAddGap(1)) {
+            streamRetransmitSlot[lost] = slot;
+            streamRetransmitSinceUs[lost] = timeMicros();
+            streamRetransmitWaiting |= 1 << lost;
+            streamRetransmitAsked |= 1 << lost;
+            // The radio ISR sends it and clears it
+            noInterrupts();
+            streamNack |= 1 << lost;
+            interrupts();
+            if (missed == 1) {
+              streamSequenceGapAt = slot;
+            }
+          }
+        }
+      } else if (bufferStreamAddGap(missed) && missed == 1) {
+        streamSequenceGapAt = at;
+      }
+    }
+  }
+  streamSequenceLast = sequence;
+  return true;
+}
+
+/**
+* @description Used to flush a StreamPacketBuffer to `bufferOutput` with a
+*  head byte and a formated tail byte based off the `typeByte`. A `packed`
+*  frame is written out as the samples in it by `bufferStreamDeltaFlush`, any
+*  other 0xCE tail is just the Pic's. Any
+*  other packet becomes the `streamDeltaReference` for the next packed one,
+*  except a gap marker the Host queued, which `gap` tells from a Pic packet
+*  ending in 0xCF.
+* @param `buf` {StreamPacketBuffer *} - The stream packet buffer to add the char to.
+* @author AJ Keller (@pushtheworldllc)
+**/
+void OpenBCI_Radios_Class::bufferStreamFlush(StreamPacketBuffer *buf) {
+  if (buf->deltaBreak) {
+    streamDeltaReferenceValid = false;
+  }
+  if (buf->packed) {
+    bufferStreamDeltaFlush(buf);
+    return;
+  }
+  bufferOutputAddStreamPacket(buf->data, buf->typeByte);
+  if (buf->gap) {
+    streamDeltaReferenceValid = false;
+    return;
+  }
+  for (int i = 0; i < OPENBCI_MAX_DATA_BYTES_IN_PACKET; i++) {
+    streamDeltaReference[i] = buf->data[i];
+  }
+  streamDeltaReferenceValid = true;
+}
+
+/**
+* @description Used to flush every StreamPacketBuffer from `streamPacketBufferTail`
+*  up to `streamPacketBufferHead` into `bufferOutput`. In
+*  OPENBCI_OUTPUT_MODE_LATENCY each one goes to the PC right away, otherwise
+*  a backlog goes in one `bufferOutputFlush`. This function will also reset each
+*  buffer after it is flushed. Further it will increment `streamPacketBufferTail`
+*  and wrap that around if necessary.
+* @author AJ Keller (@pushtheworldllc)
+**/
+void OpenBCI_Radios_Class::bufferStreamFlushBuffers(void) {
+  // A gap marker waiting on its parity frame or its packet sent again holds
+  //  up the ones behind it. Only `bufferStreamProcessDeferred` adds to the
+  //  ring and it runs before this in the same `loop()` pass, so the head
+  //  stands still and one time around the ring is the most there can be.
+  for (uint8_t n = 0; n < numberOfStreamBuffers; n++) {
+    if (streamPacketBufferTail == streamPacketBufferHead || bufferStreamParityHold(streamPacketBufferTail) || bufferStreamRetransmitHold(streamPacketBufferTail)) {
+      return;
+    }
+    OPENBCI_PERF_START(start);
+    StreamPacketBuffer *buf = streamPacketBuffer + streamPacketBufferTail;
+#ifdef OPENBCI_PERF_COUNTERS
+    latencyAdd(LATENCY_STAGE_RING, timeMicros() - buf->ingestUs);
+#endif
+    bufferStreamFlush(buf);
+    bufferStreamReset(buf);
+    streamPacketBufferTail++;
+    if (streamPacketBufferTail >= numberOfStreamBuffers) {
+      streamPacketBufferTail = 0;
+    }
+    if (outputMode == OPENBCI_OUTPUT_MODE_LATENCY) {
+      bufferOutputFlush();
+    }
+    OPENBCI_PERF_END(*this, PERF_SECTION_STREAM_FLUSH, start);
+  }
+}
+
+/**
+* @description Is there room for one more packet in the stream packet ring?
+*  One buffer always stays empty so a full ring is not mistaken for an empty
+*  one, the ring holds `numberOfStreamBuffers - 1` packets.
+* @returns {boolean} - `true` if moving the head on would run into the tail.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamFull(void) {
+  uint8_t next = streamPacketBufferHead + 1;
+  if (next >= numberOfStreamBuffers) {
+    next = 0;
+  }
+  return next == streamPacketBufferTail;
+}
+
+/**
+* @description Used to determine if a stream packet buffer is ready for a new packet
+*  this function is no longer being used with the head/tail system. Will look to
+*  deprecate it soon.
+* @param `buf` {StreamPacketBuffer *} - The stream packet buffer to add the char to.
+* @author AJ Keller (@pushtheworldllc)
+**/
+boolean OpenBCI_Radios_Class::bufferStreamReadyForNewPacket(StreamPacketBuffer *buf) {
+  return buf->bytesIn == 0 && !buf->flushing;
+}
+
+/**
+* @description Utility function to return `true` if the the streamPacketBuffer
+*   is in the STREAM_STATE_READY. Normally used for determining if a stream
+*   packet is ready to be sent.
+* @param `buf` {StreamPacketBuffer *} - The stream packet buffer to send to the Host.
+* @returns {boolean} - `true` is the `buf` is in the ready state, `false` otherwise.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamReadyToSendToHost(StreamPacketBuffer *buf) {
+  return buf->state == STREAM_STATE_READY;
+}
+
+/**
+* @description Device: queues the head stream packet and moves the head on so
+*  the next bytes start a new one, once `bufferStreamTimeout` says no 34th
+*  byte followed. When the ring is full `streamOverflowPolicy` drops the new packet or
+*  the oldest one, counting it in `streamDrops`, or leaves the packet at the
+*  head until the tail moves on.
+* @returns {boolean} - `true` if the packet was queued.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamCommit(void) {
+  StreamPacketBuffer *buf = streamPacketBuffer + streamPacketBufferHead;
+  if (bufferStreamFull()) {
+    if (streamOverflowPolicy == OPENBCI_STREAM_OVERFLOW_BLOCK) {
+      // `ingestSerial` leaves the Pic's bytes in the UART meanwhile
+      return false;
+    }
+    streamDrops++;
+    if (streamOverflowPolicy == OPENBCI_STREAM_OVERFLOW_DROP_OLDEST) {
+      StreamPacketBuffer *oldest = streamPacketBuffer + streamPacketBufferTail;
+      bufferStreamReset(oldest);
+      streamPacketBufferTail++;
+      if (streamPacketBufferTail >= numberOfStreamBuffers) {
+        streamPacketBufferTail = 0;
+      }
+    } else {
+      bufferStreamReset(buf);
+      ingestCandidate = false;
+      return false;
+    }
+  }
+  OPENBCI_LATENCY_COMMIT(*this, buf);
+  ingestCandidate = false;
+  streamPacketBufferHead++;
+  if (streamPacketBufferHead >= numberOfStreamBuffers) {
+    streamPacketBufferHead = 0;
+  }
+  return true;
+}
+
+/**
+* @description Resets the stream packet buffer to default settings
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamReset(void) {
+  for (int i = 0; i < OPENBCI_NUMBER_STREAM_BUFFERS; i++) {
+    bufferStreamReset(streamPacketBuffer + i);
+  }
+  streamPacketBufferHead = 0;
+  streamPacketBufferTail = 0;
+  ingestCandidate = false;
+  streamParityHole = OPENBCI_STREAM_PARITY_NO_HOLE;
+  streamRetransmitWaiting = 0;
+  streamDeltaReferenceValid = false;
+  streamDeltaBreak = false;
+}
+
+/**
+* @description Resets the stream packet buffer to default settings
+* @param `buf` {StreamPacketBuffer *} - Pointer to a stream packet buffer to reset
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamReset(StreamPacketBuffer *buf) {
+  buf->flushing = false;
+  buf->bytesIn = 0;
+  buf->typeByte = 0;
+  buf->state = STREAM_STATE_INIT;
+  buf->deltaBreak = false;
+  buf->gap = false;
+  buf->packed = false;
+}
+
+/**
+* @description Device: moves queued stream packets from the tail of the ring
+*  onto the TX FIFO until the ring is empty or Gazell refuses one. With
+*  `streamSendBurst` that is up to `RFDUINOGZLL_MAX_PACKETS_ON_TX_BUFFER`
+*  packets, so a backlog left by a bad stretch of air drains with both FIFO
+*  slots busy. Without it, one packet per call. Packets the Host asked for
+*  again go first, then a pending parity frame, then the next packet.
+* @returns {uint8_t} - The number of stream packets added to the TX FIFO.
+* @author AJ Keller (@pushtheworldllc)
+*/
+uint8_t OpenBCI_Radios_Class::bufferStreamSendBurst(void) {
+  uint8_t limit = streamSendBurst ? RFDUINOGZLL_MAX_PACKETS_ON_TX_BUFFER : 1;
+  uint8_t sent = 0;
+  while (sent < limit && (streamNack || streamParityPending || streamPacketBufferTail != streamPacketBufferHead)) {
+    if (streamNack) {
+      if (bufferStreamRetransmitSendToHost()) {
+        sent++;
+        continue;
+      }
+      if (streamNack) {
+        break;
+      }
+      continue;
+    }
+    if (streamParityPending) {
+      // Sequence number 0 marks a parity frame
+      streamParityFrame[0] = (streamParityFrame[0] & 0x78) | 0x80;
+      if (!RFduinoGZLL.sendToHost(streamParityFrame, OPENBCI_MAX_PACKET_SIZE_BYTES)) {
+        break;
+      }
+      pollRefresh();
+      bufferStreamParityReset();
+      sent++;
+      continue;
+    }
+    StreamPacketBuffer *buf = streamPacketBuffer + streamPacketBufferTail;
+    if (buf->state != STREAM_STATE_READY) {
+      break;
+    }
+    char frame[OPENBCI_MAX_PACKET_SIZE_BYTES];
+    uint8_t samples = streamDelta ? bufferStreamDeltaPack(frame) : 0;
+    if (samples > 0) {
+      if (!bufferStreamDeltaSendToHost(frame, samples)) {
+        break;
+      }
+    } else if (!bufferStreamDeltaRefuse(buf)) {
+      break;
+    } else if (bufferStreamSendToHost(buf)) {
+      samples = 1;
+    } else {
+      break;
+    }
+    sent++;
+    streamPacketBufferTail = (streamPacketBufferTail + samples) % numberOfStreamBuffers;
+  }
+  return sent;
+}
+
+/**
+* @description Sends the contents of the `streamPacketBuffer` to the HOST,
+*  sends as stream packet with the proper byteId. With `streamDelta` the
+*  sample becomes the `streamDeltaReference` for the next packed frame.
+* @returns {boolean} - `true` when the packet has been added to the TX buffer
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamSendToHost(StreamPacketBuffer *buf) {
+
+  byte packetType = byteIdMakeStreamPacketType(buf->typeByte);
+
+  // Add the byteId to the packet
+  buf->data[0] = byteIdMake(true,packetType,buf->data + 1, OPENBCI_MAX_DATA_BYTES_IN_PACKET); // 31 bytes
+
+  if (bufferStreamFrameSendToHost(buf->data, buf)) {
+    if (streamDelta) {
+      for (int i = 0; i < OPENBCI_MAX_DATA_BYTES_IN_PACKET; i++) {
+        streamDeltaReference[i] = buf->data[i + 1];
+      }
+      streamDeltaReferenceValid = true;
+      streamDeltaRun = 0;
+    }
+
+    // Clean the stream packet buffer
+    bufferStreamReset(buf);
+
+    return true;
+  }
+
+  return false;
+}
+
+/**
+* @description Device: puts a stream frame on the TX FIFO. With
+*  `streamSequence`, a `streamParityGroup`, `streamRetransmit` or `streamDelta`
+*  the byteId carries `streamSequenceNext`, which moves on once Gazell takes
+*  the frame. The frame then goes into the parity frame and `streamHistory`.
+* @param `frame` {char *} - 32 bytes, the byteId first.
+* @param `buf` {StreamPacketBuffer *} - The first ring packet in the frame,
+*  its times go into the latency histograms.
+* @returns {boolean} - `true` when the frame has been added to the TX buffer
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::bufferStreamFrameSendToHost(char *frame, StreamPacketBuffer *buf) {
+  boolean numbered = streamSequence || streamParityGroup > 0 || streamRetransmit || streamDelta;
+  if (numbered) {
+    frame[0] |= streamSequenceNext;
+  }
+
+  if (!RFduinoGZLL.sendToHost(frame, OPENBCI_MAX_PACKET_SIZE_BYTES)) {
+    return false;
+  }
+  // Refresh the poll timeout timer because we just polled the Host by sending
+  //  that last packet
+  pollRefresh();
+
+  if (streamRetransmit) {
+    for (int i = 0; i < OPENBCI_MAX_PACKET_SIZE_BYTES; i++) {
+      streamHistory[streamSequenceNext - 1][i] = frame[i];
+    }
+  }
+  if (numbered) {
+    streamSequenceNext = streamSequenceNext % streamSequenceModulo + 1;
+  }
+  if (streamParityGroup > 0) {
+    bufferStreamParityAdd(frame);
+    streamParityCount++;
+    if (streamParityCount >= streamParityGroup) {
+      streamParityPending = true;
+    }
+  }
+
+#ifdef OPENBCI_PERF_COUNTERS
+  unsigned long now = timeMicros();
+  latencyAdd(LATENCY_STAGE_INGEST, buf->readyUs - buf->ingestUs);
+  latencyAdd(LATENCY_STAGE_QUEUE, now - buf->readyUs);
+  // Gazell only accepts a packet with room in its FIFO, so a full list
+  //  means the oldest one never got an ACK
+  if (latencyAirCount == OPENBCI_LATENCY_AIR_SLOTS) {
+    latencyAirHead = (latencyAirHead + 1) % OPENBCI_LATENCY_AIR_SLOTS;
+    latencyAirCount--;
+  }
+  latencyAirSentUs[(latencyAirHead + latencyAirCount) % OPENBCI_LATENCY_AIR_SLOTS] = now;
+  latencyAirCount++;
+#endif
+  return true;
+}
+
+/**
+* @description Adds a zigzag delta from `bufferStreamDeltaZigzag` to a big
+*  endian value in place, wrapping the way the Pic's two's complement does.
+* @param `value` {char *} - The value, `bytes` long.
+* @param `zigzag` {uint32_t} - The delta, 0, -1, 1, -2, ... as 0, 1, 2, 3, ...
+* @param `bytes` {uint8_t} - 3 for a channel, 2 for an aux value.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::bufferStreamDeltaApply(char *value, uint32_t zigzag, uint8_t bytes) {
+  uint32_t sum = 0;
+  for (int i = 0; i < bytes; i++) {
+    sum = (sum << 8) | (uint8_t)value[i];
+  }
+  sum += (zigzag & 1) ? ~(zigzag >> 1) : zigzag >> 1;
+  for (int i = bytes - 1; i >= 0; i--) {
+    value[i] = (char)sum;
+    sum >>= 8;
+  }
+}
+
+/**
+* @description Host: writes out the samples in a packed frame, each one the
+*  sample before plus its deltas, as standard 33 byte stream packets. Without
+*  a `streamDeltaReference` the samples are lost, a gap marker with their
+*  count goes out in their place.
+* @param `buf` {StreamPacketBuffer *} - A packed frame from the ring.
 * @author AJ Keller (@pushtheworldllc)
 */
-boolean OpenBCI_Radios_Class::bufferStreamAddData(char *data) {
-
-  bufferStreamStoreData(streamPacketBuffer + streamPacketBufferHead, data);
+void OpenBCI_Radios_Class::bufferStreamDeltaFlush(StreamPacketBuffer *buf) {
+  char *packed = buf->data;
+  uint8_t samples = (uint8_t)packed[0] & 0x0F;
+  if (!streamDeltaReferenceValid) {
+    streamDeltaUndecoded += samples;
+    char marker[OPENBCI_MAX_DATA_BYTES_IN_PACKET] = { (char)samples };
+    bufferOutputAddStreamPacket(marker, OPENBCI_STREAM_BYTE_STOP | OPENBCI_STREAM_PACKET_TYPE_GAP);
+    return;
+  }
+  uint8_t stopByte = OPENBCI_STREAM_BYTE_STOP | ((uint8_t)packed[0] >> 4);
+  uint8_t auxWidth = (uint8_t)packed[OPENBCI_STREAM_DELTA_POS_AUX_WIDTH];
+  uint8_t auxModes = (uint8_t)packed[OPENBCI_STREAM_DELTA_POS_AUX_MODES];
+  uint8_t at = 0;
+  char *sample = streamDeltaReference;
+  for (int s = 0; s < samples; s++) {
+    sample[0]++;
+    for (int c = 0; c < OPENBCI_STREAM_CHANNELS; c++) {
+      uint8_t width = ((uint8_t)packed[OPENBCI_STREAM_DELTA_POS_WIDTHS + c / 2] >> ((c & 1) ? 0 : 4)) & 0x0F;
+      bufferStreamDeltaApply(sample + OPENBCI_STREAM_POS_CHANNELS + c * 3, bufferStreamDeltaTake(packed + OPENBCI_STREAM_DELTA_POS_BITS, &at, width), 3);
+    }
+    char *aux = sample + OPENBCI_STREAM_POS_AUX;
+    switch ((auxModes >> (s * 2)) & 0x03) {
+      case OPENBCI_STREAM_DELTA_AUX_DELTA:
+      for (int a = 0; a < OPENBCI_STREAM_AUX; a++) {
+        bufferStreamDeltaApply(aux + a * 2, bufferStreamDeltaTake(packed + OPENBCI_STREAM_DELTA_POS_BITS, &at, auxWidth), 2);
+      }
+      break;
+      case OPENBCI_STREAM_DELTA_AUX_RAW:
+      for (int a = 0; a < OPENBCI_STREAM_AUX * 2; a++) {
+        aux[a] = (char)bufferStreamDeltaTake(packed + OPENBCI_STREAM_DELTA_POS_BITS, &at, 8);
+      }
+      break;
+      default:
+      for (int a = 0; a < OPENBCI_STREAM_AUX * 2; a++) {
+        aux[a] = 0;
+      }
+      break;
+    }
+    bufferOutputAddStreamPacket(sample, stopByte);
+  }
+  streamDeltaSamples += samples;
+}
 
-  streamPacketBufferHead++;
-  if (streamPacketBufferHead > (OPENBCI_NUMBER_STREAM_BUFFERS - 1)) {
-    streamPacketBufferHead = 0;
+/**
+* @description Device: packs as many queued samples from the tail of the ring
+*  as fit, up to OPENBCI_STREAM_DELTA_SAMPLES_MAX, into one frame of deltas
+*  from the sample before. They have to share a tail byte and count on from
+*  `streamDeltaReference`. After the byteId: the tail type and sample count,
+*  a bit width per channel, the aux width and a mode per sample, then each
+*  sample's zigzag channel deltas and its aux. A plain packet goes out when
+*  fewer than two fit, the Host has no reference yet, or every
+*  OPENBCI_STREAM_DELTA_KEY_INTERVAL packed frames.
+* @param `frame` {char *} - Gets the packed frame, 32 bytes.
+* @returns {uint8_t} - The number of samples packed, 0 to send a plain packet.
+* @author AJ Keller (@pushtheworldllc)
+*/
+uint8_t OpenBCI_Radios_Class::bufferStreamDeltaPack(char *frame) {
+  if (!streamDeltaReferenceValid || streamDeltaRun >= OPENBCI_STREAM_DELTA_KEY_INTERVAL) {
+    return 0;
+  }
+  uint8_t typeByte = streamPacketBuffer[streamPacketBufferTail].typeByte;
+  uint8_t widths[OPENBCI_STREAM_CHANNELS + 1] = { 0 }; // The aux width last
+  uint8_t auxModes = 0;
+  uint8_t auxDeltas = 0;
+  uint8_t auxRaws = 0;
+  uint8_t samples = 0;
+  uint8_t index = streamPacketBufferTail;
+  char *previous = streamDeltaReference;
+  while (samples < OPENBCI_STREAM_DELTA_SAMPLES_MAX) {
+    StreamPacketBuffer *buf = streamPacketBuffer + index;
+    if ((samples > 0 && index == streamPacketBufferHead) || buf->state != STREAM_STATE_READY || buf->typeByte != typeByte) {
+      break;
+    }
+    char *sample = buf->data + 1;
+    if ((uint8_t)sample[0] != (uint8_t)(previous[0] + 1)) {
+      break;
+    }
+    uint8_t next[OPENBCI_STREAM_CHANNELS + 1];
+    uint16_t bits = 0;
+    for (int c = 0; c < OPENBCI_STREAM_CHANNELS; c++) {
+      uint8_t width = bufferStreamDeltaWidth(bufferStreamDeltaZigzag(previous + OPENBCI_STREAM_POS_CHANNELS + c * 3, sample + OPENBCI_STREAM_POS_CHANNELS + c * 3, 3));
+      next[c] = width > widths[c] ? width : widths[c];
+      bits += next[c];
+    }
+    bits *= samples + 1;
+    uint8_t mode = OPENBCI_STREAM_DELTA_AUX_ZERO;
+    next[OPENBCI_STREAM_CHANNELS] = widths[OPENBCI_STREAM_CHANNELS];
+    for (int a = 0; a < OPENBCI_STREAM_AUX * 2; a++) {
+      if (sample[OPENBCI_STREAM_POS_AUX + a] != 0) {
+        mode = OPENBCI_STREAM_DELTA_AUX_DELTA;
+      }
+    }
+    if (mode == OPENBCI_STREAM_DELTA_AUX_DELTA) {
+      for (int a = 0; a < OPENBCI_STREAM_AUX; a++) {
+        uint8_t width = bufferStreamDeltaWidth(bufferStreamDeltaZigzag(previous + OPENBCI_STREAM_POS_AUX + a * 2, sample + OPENBCI_STREAM_POS_AUX + a * 2, 2));
+        if (width > next[OPENBCI_STREAM_CHANNELS]) {
+          next[OPENBCI_STREAM_CHANNELS] = width;
+        }
+      }
+      if (next[OPENBCI_STREAM_CHANNELS] > OPENBCI_STREAM_DELTA_WIDTH_MAX) {
+        mode = OPENBCI_STREAM_DELTA_AUX_RAW;
+        next[OPENBCI_STREAM_CHANNELS] = widths[OPENBCI_STREAM_CHANNELS];
+      }
+    }
+    uint8_t deltas = auxDeltas + (mode == OPENBCI_STREAM_DELTA_AUX_DELTA ? 1 : 0);
+    uint8_t raws = auxRaws + (mode == OPENBCI_STREAM_DELTA_AUX_RAW ? 1 : 0);
+    bits += deltas * OPENBCI_STREAM_AUX * next[OPENBCI_STREAM_CHANNELS] + raws * OPENBCI_STREAM_AUX * 16;
+    boolean fits = bits <= OPENBCI_STREAM_DELTA_BITS;
+    for (int c = 0; c < OPENBCI_STREAM_CHANNELS; c++) {
+      if (next[c] > OPENBCI_STREAM_DELTA_WIDTH_MAX) {
+        fits = false;
+      }
+    }
+    if (!fits) {
+      break;
+    }
+    for (int c = 0; c <= OPENBCI_STREAM_CHANNELS; c++) {
+      widths[c] = next[c];
+    }
+    auxModes |= mode << (samples * 2);
+    auxDeltas = deltas;
+    auxRaws = raws;
+    previous = sample;
+    samples++;
+    index = (index + 1) % numberOfStreamBuffers;
+  }
+  if (samples < 2) {
+    return 0;
   }
 
-  return true;
+  for (int i = 0; i < OPENBCI_MAX_PACKET_SIZE_BYTES; i++) {
+    frame[i] = 0;
+  }
+  frame[0] = byteIdMake(true,OPENBCI_STREAM_PACKET_TYPE_DELTA,frame + 1, OPENBCI_MAX_DATA_BYTES_IN_PACKET);
+  char *packed = frame + 1;
+  packed[0] = (char)(((typeByte & 0x0F) << 4) | samples);
+  for (int c = 0; c < OPENBCI_STREAM_CHANNELS; c++) {
+    packed[OPENBCI_STREAM_DELTA_POS_WIDTHS + c / 2] |= widths[c] << ((c & 1) ? 0 : 4);
+  }
+  packed[OPENBCI_STREAM_DELTA_POS_AUX_WIDTH] = widths[OPENBCI_STREAM_CHANNELS];
+  packed[OPENBCI_STREAM_DELTA_POS_AUX_MODES] = auxModes;
+  uint8_t at = 0;
+  previous = streamDeltaReference;
+  for (int s = 0; s < samples; s++) {
+    char *sample = streamPacketBuffer[(streamPacketBufferTail + s) % numberOfStreamBuffers].data + 1;
+    for (int c = 0; c < OPENBCI_STREAM_CHANNELS; c++) {
+      bufferStreamDeltaPut(packed + OPENBCI_STREAM_DELTA_POS_BITS, &at, bufferStreamDeltaZigzag(previous + OPENBCI_STREAM_POS_CHANNELS + c * 3, sample + OPENBCI_STREAM_POS_CHANNELS + c * 3, 3), widths[c]);
+    }
+    switch ((auxModes >> (s * 2)) & 0x03) {
+      case OPENBCI_STREAM_DELTA_AUX_DELTA:
+      for (int a = 0; a < OPENBCI_STREAM_AUX; a++) {
+        bufferStreamDeltaPut(packed + OPENBCI_STREAM_DELTA_POS_BITS, &at, bufferStreamDeltaZigzag(previous + OPENBCI_STREAM_POS_AUX + a * 2, sample + OPENBCI_STREAM_POS_AUX + a * 2, 2), widths[OPENBCI_STREAM_CHANNELS]);
+      }
+      break;
+      case OPENBCI_STREAM_DELTA_AUX_RAW:
+      for (int a = 0; a < OPENBCI_STREAM_AUX * 2; a++) {
+        bufferStreamDeltaPut(packed + OPENBCI_STREAM_DELTA_POS_BITS, &at, (uint8_t)sample[OPENBCI_STREAM_POS_AUX + a], 8);
+      }
+      break;
+      default:
+      break;
+    }
+    previous = sample;
+  }
+  return samples;
 }
 
 /**
-* @description Used to flush a StreamPacketBuffer to the serial port with a
-*  head byte and a formated tail byte based off the `typeByte`.
-* @param `buf` {StreamPacketBuffer *} - The stream packet buffer to add the char to.
+* @description Writes the low `width` bits of `value` at bit `*at` of `bits`,
+*  most significant first, and moves `*at` past them. The bits there have to
+*  be 0.
+* @param `bits` {char *} - The bit field of a packed frame.
+* @param `at` {uint8_t *} - The bit to start at.
+* @param `value` {uint32_t} - The value.
+* @param `width` {uint8_t} - How many bits, 0 writes nothing.
 * @author AJ Keller (@pushtheworldllc)
-**/
-void OpenBCI_Radios_Class::bufferStreamFlush(StreamPacketBuffer *buf) {
-  buf->flushing = true;
-  Serial.write(0xA0);
-  for (int i = 0; i < OPENBCI_MAX_DATA_BYTES_IN_PACKET; i++) {
-    Serial.write(buf->data[i]);
+*/
+void OpenBCI_Radios_Class::bufferStreamDeltaPut(char *bits, uint8_t *at, uint32_t value, uint8_t width) {
+  for (int i = width - 1; i >= 0; i--) {
+    if ((value >> i) & 1) {
+      bits[*at / 8] |= 0x80 >> (*at % 8);
+    }
+    (*at)++;
   }
-  Serial.write(buf->typeByte);
-  buf->flushing = false;
 }
 
 /**
-* @description Used to flush a StreamPacketBuffer if the `streamPacketBufferTail`
-*  is not equal to the `streamPacketBufferHead`. This function will also reset
-*  the buffer after the buffer is flushed. Further it will increment `streamPacketBufferTail`
-*  and wrap that around if necessary.
+* @description Device: sends a frame from `bufferStreamDeltaPack` and takes
+*  its samples off the ring. The last one becomes the `streamDeltaReference`.
+*  The caller moves `streamPacketBufferTail` past them.
+* @param `frame` {char *} - The packed frame, 32 bytes.
+* @param `samples` {uint8_t} - The number of samples in it.
+* @returns {boolean} - `true` when the frame has been added to the TX buffer
 * @author AJ Keller (@pushtheworldllc)
-**/
-void OpenBCI_Radios_Class::bufferStreamFlushBuffers(void) {
-  if (streamPacketBufferTail != streamPacketBufferHead) {
-    bufferStreamFlush(streamPacketBuffer + streamPacketBufferTail);
-    bufferStreamReset(streamPacketBuffer + streamPacketBufferTail);
-    streamPacketBufferTail++;
-    if (streamPacketBufferTail > (OPENBCI_NUMBER_STREAM_BUFFERS - 1)) {
-      streamPacketBufferTail = 0;
+*/
+boolean OpenBCI_Radios_Class::bufferStreamDeltaSendToHost(char *frame, uint8_t samples) {
+  if (!bufferStreamFrameSendToHost(frame, streamPacketBuffer + streamPacketBufferTail)) {
+    return false;
+  }
+  for (int s = 0; s < samples; s++) {
+    StreamPacketBuffer *buf = streamPacketBuffer + (streamPacketBufferTail + s) % numberOfStreamBuffers;
+    if (s == samples - 1) {
+      for (int i = 0; i < OPENBCI_MAX_DATA_BYTES_IN_PACKET; i++) {
+        streamDeltaReference[i] = buf->data[i + 1];
+      }
     }
+    bufferStreamReset(buf);
   }
+  streamDeltaRun++;
+  streamDeltaSamples += samples;
+  return true;
 }
 
 /**
-* @description Used to determine if a stream packet buffer is ready for a new packet
-*  this function is no longer being used with the head/tail system. Will look to
-*  deprecate it soon.
-* @param `buf` {StreamPacketBuffer *} - The stream packet buffer to add the char to.
+* @description Device: call before sending `buf` plain. A Pic packet ending in
+*  0xCE goes over the air as a packed frame would, so with `streamDelta` on
+*  the Device first tells the Host packing is off, `ORPM_STREAM_DELTA_SET` on
+*  the same TX FIFO ahead of the packet, and keeps it off from then on, see
+*  `streamDeltaRefused`.
+* @param `buf` {StreamPacketBuffer *} - The packet about to go out plain.
+* @returns {boolean} - `false` if Gazell had no room for the message, send
+*  nothing before trying again.
 * @author AJ Keller (@pushtheworldllc)
-**/
-boolean OpenBCI_Radios_Class::bufferStreamReadyForNewPacket(StreamPacketBuffer *buf) {
-  return buf->bytesIn == 0 && !buf->flushing;
+*/
+boolean OpenBCI_Radios_Class::bufferStreamDeltaRefuse(StreamPacketBuffer *buf) {
+  if (!streamDelta || buf->typeByte != (OPENBCI_STREAM_BYTE_STOP | OPENBCI_STREAM_PACKET_TYPE_DELTA)) {
+    return true;
+  }
+  singleCharMsg[0] = (char)ORPM_STREAM_DELTA_SET;
+  if (!RFduinoGZLL.sendToHost(singleCharMsg,1)) {
+    return false;
+  }
+  pollRefresh();
+  bufferStreamDeltaSet(false);
+  streamDeltaRefused = true;
+  return true;
 }
 
 /**
-* @description Utility function to return `true` if the the streamPacketBuffer
-*   is in the STREAM_STATE_READY. Normally used for determining if a stream
-*   packet is ready to be sent.
-* @param `buf` {StreamPacketBuffer *} - The stream packet buffer to send to the Host.
-* @returns {boolean} - `true` is the `buf` is in the ready state, `false` otherwise.
+* @description Turns packing on or off. Either way the next sample goes out
+*  plain, or on the Host has to come in plain, to start from. The Device
+*  numbers its packets whenever it is on, so the Host starts counting them
+*  again.
+* @param `on` {boolean} - `true` to pack samples when they fit.
 * @author AJ Keller (@pushtheworldllc)
 */
-boolean OpenBCI_Radios_Class::bufferStreamReadyToSendToHost(StreamPacketBuffer *buf) {
-  return radio.streamPacketBuffer->state == radio.STREAM_STATE_READY;
+void OpenBCI_Radios_Class::bufferStreamDeltaSet(boolean on) {
+  streamDelta = on;
+  streamDeltaReferenceValid = false;
+  streamDeltaRun = 0;
+  streamSequenceLast = 0;
 }
 
 /**
-* @description Resets the stream packet buffer to default settings
+* @description Reads `width` bits at bit `*at` of `bits`, most significant
+*  first, and moves `*at` past them.
+* @param `bits` {char *} - The bit field of a packed frame.
+* @param `at` {uint8_t *} - The bit to start at.
+* @param `width` {uint8_t} - How many bits, 0 reads 0.
+* @returns {uint32_t} - The value.
 * @author AJ Keller (@pushtheworldllc)
 */
-void OpenBCI_Radios_Class::bufferStreamReset(void) {
-  for (int i = 0; i < OPENBCI_NUMBER_STREAM_BUFFERS; i++) {
-    bufferStreamReset(streamPacketBuffer + i);
+uint32_t OpenBCI_Radios_Class::bufferStreamDeltaTake(char *bits, uint8_t *at, uint8_t width) {
+  uint32_t value = 0;
+  for (int i = 0; i < width; i++) {
+    value = (value << 1) | (((uint8_t)bits[*at / 8] >> (7 - *at % 8)) & 1);
+    (*at)++;
   }
-  streamPacketBufferHead = 0;
-  streamPacketBufferTail = 0;
+  return value;
 }
 
 /**
-* @description Resets the stream packet buffer to default settings
-* @param `buf` {StreamPacketBuffer *} - Pointer to a stream packet buffer to reset
+* @description The number of bits it takes to write `zigzag`.
+* @param `zigzag` {uint32_t} - A zigzag delta.
+* @returns {uint8_t} - 0 for 0, else the position of its top bit plus one.
 * @author AJ Keller (@pushtheworldllc)
 */
-void OpenBCI_Radios_Class::bufferStreamReset(StreamPacketBuffer *buf) {
-  buf->flushing = false;
-  buf->bytesIn = 0;
-  buf->typeByte = 0;
-  buf->state = STREAM_STATE_INIT;
+uint8_t OpenBCI_Radios_Class::bufferStreamDeltaWidth(uint32_t zigzag) {
+  uint8_t width = 0;
+  while (zigzag) {
+    width++;
+    zigzag >>= 1;
+  }
+  return width;
 }
 
 /**
-* @description Sends the contents of the `streamPacketBuffer` to the HOST,
-*  sends as stream packet with the proper byteId.
-* @returns {boolean} - `true` when the packet has been added to the TX buffer
+* @description The change from one big endian two's complement value to the
+*  next, wrapped to the same size and zigzag coded so a small step either way
+*  is a small number: 0, -1, 1, -2, ... as 0, 1, 2, 3, ...
+* @param `previous` {char *} - The value before, `bytes` long.
+* @param `current` {char *} - The value now, `bytes` long.
+* @param `bytes` {uint8_t} - 3 for a channel, 2 for an aux value.
+* @returns {uint32_t} - The zigzag delta.
 * @author AJ Keller (@pushtheworldllc)
 */
-boolean OpenBCI_Radios_Class::bufferStreamSendToHost(StreamPacketBuffer *buf) {
-
-  byte packetType = byteIdMakeStreamPacketType(buf->typeByte);
-
-  char byteId = byteIdMake(true,packetType,buf->data + 1, OPENBCI_MAX_DATA_BYTES_IN_PACKET); // 31 bytes
-
-  // Add the byteId to the packet
-  buf->data[0] = byteId;
-
-  // Clean the serial buffer (because these bytes got added to it too)
-  bufferSerialReset(bufferSerial.numberOfPacketsToSend);
-
-  if (RFduinoGZLL.sendToHost((char *)buf->data, OPENBCI_MAX_PACKET_SIZE_BYTES)) {
-    // Refresh the poll timeout timer because we just polled the Host by sending
-    //  that last packet
-    pollRefresh();
-
-    // Clean the stream packet buffer
-    bufferStreamReset(buf);
-
-    return true;
+uint32_t OpenBCI_Radios_Class::bufferStreamDeltaZigzag(char *previous, char *current, uint8_t bytes) {
+  uint32_t from = 0;
+  uint32_t to = 0;
+  for (int i = 0; i < bytes; i++) {
+    from = (from << 8) | (uint8_t)previous[i];
+    to = (to << 8) | (uint8_t)current[i];
   }
-
-  return false;
+  uint8_t shift = 32 - bytes * 8;
+  int32_t delta = (int32_t)((to - from) << shift) >> shift;
+  return delta < 0 ? ~((uint32_t)delta << 1) : (uint32_t)delta << 1;
 }
 
 /**
@@ -1657,6 +3768,8 @@ boolean OpenBCI_Radios_Class::bufferStreamSendToHost(StreamPacketBuffer *buf) {
 void OpenBCI_Radios_Class::bufferStreamStoreData(StreamPacketBuffer *buf, char *data) {
   buf->bytesIn = OPENBCI_MAX_DATA_BYTES_IN_PACKET;
   buf->typeByte = outputGetStopByteFromByteId(data[0]);
+  buf->gap = false;
+  buf->packed = streamDelta && buf->typeByte == (OPENBCI_STREAM_BYTE_STOP | OPENBCI_STREAM_PACKET_TYPE_DELTA);
   for (int i = 0; i < OPENBCI_MAX_DATA_BYTES_IN_PACKET; i++) {
     buf->data[i] = data[i+1];
   }
@@ -1669,7 +3782,7 @@ void OpenBCI_Radios_Class::bufferStreamStoreData(StreamPacketBuffer *buf, char *
 * @author AJ Keller (@pushtheworldllc)
 */
 boolean OpenBCI_Radios_Class::bufferStreamTimeout(void) {
-  return micros() > (lastTimeSerialRead + OPENBCI_TIMEOUT_PACKET_STREAM_uS);
+  return timeElapsedMicros(lastTimeSerialRead, timeoutPacketStreamUs);
 }
 
 /**
@@ -1682,7 +3795,8 @@ boolean OpenBCI_Radios_Class::bufferStreamTimeout(void) {
 * @returns [char] The newly formed byteId where a byteId is defined as
 *           Bit 7 - Streaming byte packet
 *           Bits[6:3] - Packet count
-*           Bits[2:0] - The check sum
+*           Bits[2:0] - The check sum, unused, a numbered stream packet
+*            keeps its sequence number here
 * @author AJ Keller (@pushtheworldllc)
 */
 char OpenBCI_Radios_Class::byteIdMake(boolean isStreamPacket, uint8_t packetNumber, char *data, uint8_t length) {
@@ -1729,6 +3843,16 @@ byte OpenBCI_Radios_Class::byteIdGetStreamPacketType(uint8_t byteId) {
   return (byte)((byteId & 0x78) >> 3);
 }
 
+/**
+* @description Strips and gets the sequence number from a stream byteId
+* @param byteId [char] a byteId (see ::byteIdMake for description of bits)
+* @returns [uint8_t] the sequence number, 1 to 7, or 0 if the packet has none
+* @author AJ Keller (@pushtheworldllc)
+*/
+uint8_t OpenBCI_Radios_Class::byteIdGetStreamSequence(uint8_t byteId) {
+  return byteId & 0x07;
+}
+
 /**
 * @description Strips and gets the packet number from a byteId
 * @returns [byte] the packet type
@@ -1753,7 +3877,7 @@ void OpenBCI_Radios_Class::pollHost(void) {
 * @author AJ Keller (@pushtheworldllc)
 */
 boolean OpenBCI_Radios_Class::pollNow(void) {
-  return millis() - timeOfLastPoll > pollTime;
+  return timeElapsedMillis(timeOfLastPoll, pollTime);
 }
 
 /**
@@ -1761,7 +3885,139 @@ boolean OpenBCI_Radios_Class::pollNow(void) {
 * @author AJ Keller (@pushtheworldllc)
 */
 void OpenBCI_Radios_Class::pollRefresh(void) {
-  timeOfLastPoll = millis();
+  timeOfLastPoll = timeMillis();
+}
+
+/**
+* @description Has more than `interval` microseconds passed since `since`? The
+*  difference is taken unsigned and 32 bits wide, the width of the clock, so
+*  the answer stays right when `micros()` wraps, about every 71 minutes, as
+*  long as the interval is under that.
+* @param `since` {unsigned long} - A `timeMicros()` reading.
+* @param `interval` {unsigned long} - The interval in microseconds.
+* @returns {boolean} - `true` if the interval has passed.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::timeElapsedMicros(unsigned long since, unsigned long interval) {
+  return (uint32_t)(timeMicros() - since) > interval;
+}
+
+/**
+* @description Has more than `interval` milliseconds passed since `since`?
+*  Safe across the `millis()` wrap, see `timeElapsedMicros`.
+* @param `since` {unsigned long} - A `timeMillis()` reading.
+* @param `interval` {unsigned long} - The interval in milliseconds.
+* @returns {boolean} - `true` if the interval has passed.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::timeElapsedMillis(unsigned long since, unsigned long interval) {
+  return (uint32_t)(timeMillis() - since) > interval;
+}
+
+/**
+* @description The library's `micros()`. Every time stamp the library and the
+*  example sketches take goes through here.
+* @returns {unsigned long} - Microseconds from the time source.
+* @author AJ Keller (@pushtheworldllc)
+*/
+unsigned long OpenBCI_Radios_Class::timeMicros(void) {
+  return timeSourceMicros();
+}
+
+/**
+* @description The library's `millis()`, see `timeMicros`.
+* @returns {unsigned long} - Milliseconds from the time source.
+* @author AJ Keller (@pushtheworldllc)
+*/
+unsigned long OpenBCI_Radios_Class::timeMillis(void) {
+  return timeSourceMillis();
+}
+
+/**
+* @description Device: reopens the UART to the Pic at `baud` and scales the
+*  timeouts that are measured in byte times to it. The Pic has to be told to
+*  switch on its own, before this is called.
+* @param `baud` {uint32_t} - The new baud rate, i.e. `OPENBCI_BAUD_RATE_FAST`
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::setBaudRate(uint32_t baud) {
+  // Close the current serial connection
+  Serial.end();
+  if (debugMode) {
+    Serial.begin(baud);
+  } else {
+    // rx = GPIO3, tx = GPIO2
+    Serial.begin(baud, 3, 2);
+  }
+  timeoutsSetBaudRate(baud);
+}
+
+/**
+* @description Sets `timeoutPacketStreamUs` to two byte times at `baud`, plus
+*  a microsecond, but no longer than `OPENBCI_TIMEOUT_PACKET_STREAM_uS`, the
+*  timeout at the default baud rate. One byte time is the gap being looked
+*  for, the other is margin for `loop()` passes that come late.
+*  `timeoutPacketNormalUs` is how long the Pic may think between writes, not a
+*  byte time, so it stays.
+* @param `baud` {uint32_t} - The baud rate of the UART to the Pic
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::timeoutsSetBaudRate(uint32_t baud) {
+  uint32_t byteUs = (OPENBCI_SERIAL_BITS_PER_BYTE * 1000000UL + baud - 1) / baud;
+  timeoutPacketStreamUs = 2 * byteUs + 1;
+  if (timeoutPacketStreamUs > OPENBCI_TIMEOUT_PACKET_STREAM_uS) {
+    timeoutPacketStreamUs = OPENBCI_TIMEOUT_PACKET_STREAM_uS;
+  }
+}
+
+/**
+* @description Device: once the Host has not answered for
+*  `OPENBCI_TIMEOUT_COMMS_MS`, reopens the UART to the Pic at the default baud
+*  rate. The Host forgets the rate it asked for on the same timeout, so both
+*  sides agree again, and the Pic has to be switched back by the driver. The
+*  Device sketch calls it every `loop()`.
+* @returns {boolean} - `true` if the UART went back to the default rate.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::baudRateCommsFailure(void) {
+  if (baudRateCodeDevice == OPENBCI_HOST_CMD_BAUD_DEFAULT || !timeElapsedMillis(lastTimeDeviceHeardFromHost, OPENBCI_TIMEOUT_COMMS_MS)) {
+    return false;
+  }
+  baudRateCodeDevice = OPENBCI_HOST_CMD_BAUD_DEFAULT;
+  setBaudRate(OPENBCI_BAUD_RATE_DEFAULT);
+  return true;
+}
+
+/**
+* @description Maps the code of one of the Host baud commands to its rate.
+* @param `code` {char} - `OPENBCI_HOST_CMD_BAUD_DEFAULT`, `OPENBCI_HOST_CMD_BAUD_FAST`
+*  or `OPENBCI_HOST_CMD_BAUD_HYPER`
+* @returns {uint32_t} - The baud rate, `0` for any other code
+* @author AJ Keller (@pushtheworldllc)
+*/
+uint32_t OpenBCI_Radios_Class::baudRateFromCode(char code) {
+  switch (code) {
+    case OPENBCI_HOST_CMD_BAUD_DEFAULT:
+    return OPENBCI_BAUD_RATE_DEFAULT;
+    case OPENBCI_HOST_CMD_BAUD_FAST:
+    return OPENBCI_BAUD_RATE_FAST;
+    case OPENBCI_HOST_CMD_BAUD_HYPER:
+    return OPENBCI_BAUD_RATE_HYPER;
+    default:
+    return 0;
+  }
+}
+
+/**
+* @description Swaps the clocks the library reads, so tests can start right
+*  before a wrap or step time by hand.
+* @param `microsSource` {TimeSource} - Replaces `micros()`, `NULL` puts it back.
+* @param `millisSource` {TimeSource} - Replaces `millis()`, `NULL` puts it back.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void OpenBCI_Radios_Class::timeSetSource(TimeSource microsSource, TimeSource millisSource) {
+  timeSourceMicros = microsSource ? microsSource : micros;
+  timeSourceMillis = millisSource ? millisSource : millis;
 }
 
 /**
@@ -1794,6 +4050,33 @@ OpenBCI_Radios_Class radio;
 */
 boolean OpenBCI_Radios_Class::processRadioCharHost(device_t device, char newChar) {
 
+  if ((uint8_t)newChar >= ORPM_STREAM_PARITY_SET && (uint8_t)newChar <= ORPM_STREAM_PARITY_SET + OPENBCI_STREAM_PARITY_GROUP_MAX) {
+    // The Device switched its parity group
+    bufferStreamParitySet((uint8_t)newChar - ORPM_STREAM_PARITY_SET);
+    msgToPrint = HOST_MESSAGE_STREAM_PARITY;
+    printMessageToDriverFlag = true;
+    return false;
+  }
+  if ((uint8_t)newChar == ORPM_STREAM_RETRANSMIT_SET || (uint8_t)newChar == ORPM_STREAM_RETRANSMIT_SET + 1) {
+    // The Device switched retransmission
+    bufferStreamRetransmitSet((uint8_t)newChar == ORPM_STREAM_RETRANSMIT_SET + 1);
+    msgToPrint = HOST_MESSAGE_STREAM_RETRANSMIT;
+    printMessageToDriverFlag = true;
+    return false;
+  }
+  if ((uint8_t)newChar == ORPM_STREAM_DELTA_SET || (uint8_t)newChar == ORPM_STREAM_DELTA_SET + 1) {
+    // The Device switched packing, in line with the stream packets around it
+    //  so the ones packed before are still written out as packed, see
+    //  `bufferStreamProcessDeferred`
+    char msg[OPENBCI_MAX_PACKET_SIZE_BYTES] = { newChar };
+    if (streamDeferred.back() != NULL) {
+      bufferStreamDefer(msg);
+    } else {
+      bufferStreamDeltaSwitched(newChar);
+    }
+    return false;
+  }
+
   switch (newChar) {
     case ORPM_PACKET_PAGE_REJECT:
     // Start the page transmission over again
@@ -1837,6 +4120,14 @@ boolean OpenBCI_Radios_Class::processRadioCharHost(device_t device, char newChar
     isWaitingForNewPollTimeConfirmation = true;
     return false;
 
+    case ORPM_CHANGE_BAUD_DEVICE_READY:
+    // Send the baud code saved when the Driver asked for it
+    singleCharMsg[0] = baudRateCodeDevice;
+    RFduinoGZLL.sendToDevice(device,singleCharMsg,1);
+    packetInTXRadioBuffer = true;
+    isWaitingForNewBaudRateConfirmation = true;
+    return false;
+
     case ORPM_DEVICE_SERIAL_OVERFLOW:
     Serial.print("Failure: Board RFduino buffer overflowed. Soft reset command sent to Board.$$$");
     // TODO : Decide if this is a good idea
@@ -1884,6 +4175,19 @@ boolean OpenBCI_Radios_Class::processRadioCharDevice(char newChar) {
     }
     return false;
 
+  } else if (isWaitingForNewBaudRate) {
+    isWaitingForNewBaudRate = false;
+    // Refresh poll
+    pollRefresh();
+    uint32_t baud = baudRateFromCode(newChar);
+    if (baud > 0) {
+      baudRateCodeDevice = newChar;
+      // Poll the host, the Pic should be at the new rate already
+      pollHost();
+      setBaudRate(baud);
+    }
+    return false;
+
   } else if (isWaitingForNewPollTime) {
     isWaitingForNewPollTime = false;
     // Refresh poll
@@ -1898,6 +4202,37 @@ boolean OpenBCI_Radios_Class::processRadioCharDevice(char newChar) {
     }
     return false;
 
+  } else if ((uint8_t)newChar >= ORPM_STREAM_PARITY_SET && (uint8_t)newChar <= ORPM_STREAM_PARITY_SET + OPENBCI_STREAM_PARITY_GROUP_MAX) {
+    // Start a new group and tell the Host to do the same
+    bufferStreamParitySet((uint8_t)newChar - ORPM_STREAM_PARITY_SET);
+    singleCharMsg[0] = newChar;
+    RFduinoGZLL.sendToHost(singleCharMsg,1);
+    pollRefresh();
+    return false;
+
+  } else if ((uint8_t)newChar == ORPM_STREAM_RETRANSMIT_SET || (uint8_t)newChar == ORPM_STREAM_RETRANSMIT_SET + 1) {
+    bufferStreamRetransmitSet((uint8_t)newChar == ORPM_STREAM_RETRANSMIT_SET + 1);
+    singleCharMsg[0] = newChar;
+    RFduinoGZLL.sendToHost(singleCharMsg,1);
+    pollRefresh();
+    return false;
+
+  } else if ((uint8_t)newChar == ORPM_STREAM_DELTA_SET || (uint8_t)newChar == ORPM_STREAM_DELTA_SET + 1) {
+    // The next packet goes out plain so the Host has one to start from. Not
+    //  with a Pic that sends tail 0xCE, the echo then says it stayed off
+    bufferStreamDeltaSet((uint8_t)newChar == ORPM_STREAM_DELTA_SET + 1 && !streamDeltaRefused);
+    singleCharMsg[0] = (char)(ORPM_STREAM_DELTA_SET + (streamDelta ? 1 : 0));
+    RFduinoGZLL.sendToHost(singleCharMsg,1);
+    pollRefresh();
+    return false;
+
+  } else if ((uint8_t)newChar & ORPM_STREAM_NACK) {
+    // Sent again from the loop, before anything new
+    if (streamRetransmit) {
+      streamNack |= (uint8_t)newChar & ~ORPM_STREAM_NACK;
+    }
+    return false;
+
   } else {
     switch (newChar) {
       case ORPM_PACKET_PAGE_REJECT:
@@ -1935,6 +4270,14 @@ boolean OpenBCI_Radios_Class::processRadioCharDevice(char newChar) {
       pollRefresh();
       return false;
 
+      case ORPM_CHANGE_BAUD_HOST_REQUEST:
+      // Now we have to wait for the new baud code
+      isWaitingForNewBaudRate = true;
+      singleCharMsg[0] = (char)ORPM_CHANGE_BAUD_DEVICE_READY;
+      RFduinoGZLL.sendToHost(singleCharMsg,1);
+      pollRefresh();
+      return false;
+
       case ORPM_GET_POLL_TIME:
       // If there are no packets to send
       bufferSerialAddChar('S');
@@ -1955,6 +4298,28 @@ boolean OpenBCI_Radios_Class::processRadioCharDevice(char newChar) {
       pollRefresh();
       return true;
 
+      case ORPM_GET_LATENCY:
+#ifdef OPENBCI_PERF_COUNTERS
+      bufferSerialAddLatency();
+#else
+      bufferSerialAddString("Failure: Latency histograms not compiled in$$$");
+#endif
+      pollRefresh();
+      return true;
+
+      case ORPM_GET_STREAM_DROPS:
+      bufferSerialAddString("Success: Stream drops device:");
+      bufferSerialAddNumber(streamDrops);
+      bufferSerialAddString(" policy:");
+      bufferSerialAddNumber(streamOverflowPolicy);
+      bufferSerialAddString(" resent:");
+      bufferSerialAddNumber(streamRetransmitSent);
+      bufferSerialAddString(" packed:");
+      bufferSerialAddNumber(streamDeltaSamples);
+      bufferSerialAddString("$$$");
+      pollRefresh();
+      return true;
+
       case ORPM_INVALID_CODE_RECEIVED:
       // Working theory
       return false;
@@ -1995,7 +4360,7 @@ boolean OpenBCI_Radios_Class::packetsInSerialBuffer(void) {
 * @author AJ Keller (@pushtheworldllc)
 */
 boolean OpenBCI_Radios_Class::serialWriteTimeOut(void) {
-  return micros() > (lastTimeSerialRead + OPENBCI_TIMEOUT_PACKET_NRML_uS);
+  return timeElapsedMicros(lastTimeSerialRead, timeoutPacketNormalUs);
 }
 
 /**
@@ -2046,7 +4411,9 @@ boolean OpenBCI_Radios_Class::processDeviceRadioCharData(char *data, int len) {
 
 /**
 * @description Entered from RFduinoGZLL_onReceive if the Host receives a
-*  packet of length greater than 1.
+*  packet of length greater than 1. A stream packet is taken apart right
+*  away, the Host sketch leaves that to `loop()` with
+*  `processHostRadioStreamData`.
 * @param `device` {device_t} - The device that sent a packet to the Host.
 * @param `data` {volatile char *} - The data buffer to process.
 * @param `len` {int} - The length of `data`
@@ -2056,15 +4423,21 @@ boolean OpenBCI_Radios_Class::processDeviceRadioCharData(char *data, int len) {
 boolean OpenBCI_Radios_Class::processHostRadioCharData(device_t device, char *data, int len) {
 
   if (byteIdGetIsStream(data[0])) {
-    // We don't actually read to serial port yet, we simply move it
-    //  into a buffer in an effort to not write to the Serial port
-    //  from an ISR.
-    bufferStreamAddData(data);
-    // Check to see if there is a packet to send back
-    return hostPacketToSend();
+    bufferStreamReceive(data);
+    // Check to see if there is a packet to send back, else ask for lost ones
+    if (hostPacketToSend()) {
+      return true;
+    }
+    bufferStreamNackSend(device);
+    return false;
   }
 
-  switch (bufferRadioProcessPacket(data,len)) {
+  byte processResult = bufferRadioProcessPacket(data,len);
+#ifdef OPENBCI_RADIO_TRACE
+  traceAction(OPENBCI_TRACE_ACTION_PROCESS | processResult);
+#endif
+
+  switch (processResult) {
     case OPENBCI_PROCESS_RADIO_FAIL_SWITCH_LAST:
     case OPENBCI_PROCESS_RADIO_FAIL_SWITCH_NOT_LAST:
     singleCharMsg[0] = (char)ORPM_PACKET_PAGE_REJECT;
@@ -2091,5 +4464,25 @@ boolean OpenBCI_Radios_Class::processHostRadioCharData(device_t device, char *da
     bufferSerialReset(bufferSerial.numberOfPacketsSent);
     return false;
   }
+  return false;
+}
 
+/**
+* @description Entered from RFduinoGZLL_onReceive on the Host with a stream
+*  packet. Leaves the packet for `bufferStreamProcessDeferred` in `loop()`, so
+*  all the radio ISR does is pick the ACK payload, same as
+*  `processHostRadioCharData`.
+* @param `device` {device_t} - The device that sent a packet to the Host.
+* @param `data` {char *} - A stream packet with its byteId, 32 bytes.
+* @returns {boolean} - `true` if there is a packet to send to the Device.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean OpenBCI_Radios_Class::processHostRadioStreamData(device_t device, char *data) {
+  bufferStreamDefer(data);
+  // Check to see if there is a packet to send back, else ask for lost ones
+  if (hostPacketToSend()) {
+    return true;
+  }
+  bufferStreamNackSend(device);
+  return false;
 }
@@ -23,6 +23,7 @@
 // needed for enum and callback support
 // #include "libRFduinoGZLL.h"
 #include "OpenBCI_Radios_Definitions.h"
+#include "OpenBCI_Radios_Ring.h"
 
 class OpenBCI_Radios_Class {
 
@@ -49,8 +50,48 @@ public:
         HOST_MESSAGE_CHAN_VERIFY,
         HOST_MESSAGE_CHAN_GET_FAILURE,
         HOST_MESSAGE_CHAN_GET_SUCCESS,
-        HOST_MESSAGE_POLL_TIME
+        HOST_MESSAGE_POLL_TIME,
+        HOST_MESSAGE_PERF,
+        HOST_MESSAGE_LATENCY,
+        HOST_MESSAGE_TRACE,
+        HOST_MESSAGE_BAUD_DEVICE,
+        HOST_MESSAGE_BAUD_DEVICE_VERIFY,
+        HOST_MESSAGE_COMMS_DOWN_BAUD_DEVICE,
+        HOST_MESSAGE_STREAM_DROPS,
+        HOST_MESSAGE_STREAM_PARITY,
+        HOST_MESSAGE_STREAM_PARITY_VERIFY,
+        HOST_MESSAGE_STREAM_RETRANSMIT,
+        HOST_MESSAGE_STREAM_RETRANSMIT_VERIFY,
+        HOST_MESSAGE_STREAM_DELTA,
+        HOST_MESSAGE_STREAM_DELTA_VERIFY,
+        HOST_MESSAGE_OUTPUT_MODE,
+        HOST_MESSAGE_OUTPUT_MODE_VERIFY
     };
+#ifdef OPENBCI_PERF_COUNTERS
+    typedef enum PERF_SECTION {
+        PERF_SECTION_LOOP,
+        PERF_SECTION_ON_RECEIVE,
+        PERF_SECTION_STREAM_FLUSH,
+        PERF_SECTION_RADIO_FLUSH,
+        PERF_SECTION_PRINT_MESSAGE,
+        PERF_SECTION_COUNT
+    };
+    typedef enum LATENCY_STAGE {
+        // Device: tail byte in until the packet is committed
+        LATENCY_STAGE_INGEST,
+        // Device: committed until handed to Gazell
+        LATENCY_STAGE_QUEUE,
+        // Device: handed to Gazell until the Host's ACK
+        LATENCY_STAGE_AIR,
+        // Host: received until the flush starts
+        LATENCY_STAGE_RING,
+        // Host: the flush to the PC
+        LATENCY_STAGE_SERIAL,
+        LATENCY_STAGE_COUNT
+    };
+#endif
+    // Reads a free running clock that wraps at 2^32, like `micros()`
+    typedef unsigned long (*TimeSource)(void);
     // STRUCTS
     typedef struct {
         char      data[OPENBCI_MAX_PACKET_SIZE_BYTES];
@@ -71,6 +112,21 @@ public:
         uint8_t         bytesIn;
         boolean         flushing;
         STREAM_STATE    state;
+        // Host: packets before this one were lost, so packed samples from
+        //  here on have nothing to add their deltas to
+        boolean         deltaBreak;
+        // Host: a gap marker it queued itself, not a Pic packet that happens
+        //  to end in 0xCF
+        boolean         gap;
+        // Host: a packed frame, stored while `streamDelta` was on, not a Pic
+        //  packet that happens to end in 0xCE
+        boolean         packed;
+#ifdef OPENBCI_PERF_COUNTERS
+        // Device: when the tail byte came in, Host: when the packet arrived
+        unsigned long   ingestUs;
+        // Device: when the packet was committed
+        unsigned long   readyUs;
+#endif
     } StreamPacketBuffer;
 
     typedef struct {
@@ -81,6 +137,29 @@ public:
         uint8_t previousPacketNumber;
     } BufferRadio;
 
+    typedef struct {
+        char    data[OPENBCI_MAX_PACKET_SIZE_BYTES];
+    } StreamFrame;
+
+#ifdef OPENBCI_PERF_COUNTERS
+    typedef struct {
+        uint32_t calls;
+        uint32_t cycles;
+        uint32_t maxCycles;
+    } PerfSection;
+#endif
+
+#ifdef OPENBCI_RADIO_TRACE
+    typedef struct {
+        uint32_t    timeUs;
+        uint8_t     len;
+        // The first byte of the frame, the whole ORPM code for a single char
+        uint8_t     byteId;
+        int8_t      rssi;
+        uint8_t     action;
+    } TraceEntry;
+#endif
+
 // SHARED
     OpenBCI_Radios_Class();
     void        begin(uint8_t);
@@ -92,8 +171,18 @@ public:
     void        bufferCleanCompletePacketBuffer(PacketBuffer *, int);
     void        bufferCleanPacketBuffer(PacketBuffer *,int);
     void        bufferCleanBuffer(Buffer *, int);
+    void        bufferOutputAddData(const char *, int);
+    void        bufferOutputAddStreamPacket(const char *, uint8_t);
+    void        bufferOutputDrain(void);
+    void        bufferOutputFlush(void);
+    int         bufferOutputRoom(void);
+    void        bufferOutputTxAdd(int);
+    boolean     bufferOutputReady(void);
+    void        bufferOutputWrite(int);
     boolean     bufferRadioAddData(BufferRadio *, char *, int, boolean);
     void        bufferRadioClean(BufferRadio *);
+    boolean     baudRateCommsFailure(void);
+    uint32_t    baudRateFromCode(char);
     boolean     bufferRadioHasData(BufferRadio *);
     void        bufferRadioFlush(BufferRadio *);
     void        bufferRadioFlushBuffers(void);
@@ -105,24 +194,62 @@ public:
     boolean     bufferRadioSwitchToOtherBuffer(void);
     void        bufferResetStreamPacketBuffer(void);
     boolean     bufferSerialAddChar(char);
+    void        bufferSerialAddNumber(uint32_t);
+    void        bufferSerialAddString(const char *);
     boolean     bufferSerialHasData(void);
     void        bufferSerialProcessCommsFailure(void);
     void        bufferSerialReset(uint8_t);
     boolean     bufferSerialTimeout(void);
     void        bufferStreamAddChar(StreamPacketBuffer *, char);
+    boolean     bufferStreamCommit(void);
     boolean     bufferStreamAddData(char *);
+    boolean     bufferStreamAddGap(uint8_t);
+    boolean     bufferStreamDefer(char *);
+    void        bufferStreamDeltaApply(char *, uint32_t, uint8_t);
+    void        bufferStreamDeltaFlush(StreamPacketBuffer *);
+    uint8_t     bufferStreamDeltaPack(char *);
+    void        bufferStreamDeltaPut(char *, uint8_t *, uint32_t, uint8_t);
+    boolean     bufferStreamDeltaRefuse(StreamPacketBuffer *);
+    boolean     bufferStreamDeltaSendToHost(char *, uint8_t);
+    void        bufferStreamDeltaSet(boolean);
+    void        bufferStreamDeltaSwitched(char);
+    uint32_t    bufferStreamDeltaTake(char *, uint8_t *, uint8_t);
+    uint8_t     bufferStreamDeltaWidth(uint32_t);
+    uint32_t    bufferStreamDeltaZigzag(char *, char *, uint8_t);
     void        bufferStreamFlush(StreamPacketBuffer *);
     void        bufferStreamFlushBuffers(void);
+    boolean     bufferStreamFrameSendToHost(char *, StreamPacketBuffer *);
+    boolean     bufferStreamFull(void);
     boolean     bufferStreamReadyForNewPacket(StreamPacketBuffer *);
     boolean     bufferStreamReadyToSendToHost(StreamPacketBuffer *buf);
+    void        bufferStreamParityAdd(char *);
+    boolean     bufferStreamParityHold(uint8_t);
+    void        bufferStreamParityReceive(char *);
+    void        bufferStreamParityRebuild(char *);
+    void        bufferStreamParityReset(void);
+    void        bufferStreamParitySet(uint8_t);
+    void        bufferStreamProcessDeferred(void);
+    void        bufferStreamReceive(char *);
     void        bufferStreamReset(void);
     void        bufferStreamReset(StreamPacketBuffer *);
+    boolean     bufferStreamNackSend(device_t);
+    uint8_t     bufferStreamRetransmitBehind(uint8_t);
+    boolean     bufferStreamRetransmitCheck(char *);
+    void        bufferStreamRetransmitForget(uint8_t);
+    boolean     bufferStreamRetransmitHold(uint8_t);
+    void        bufferStreamRetransmitReset(void);
+    boolean     bufferStreamRetransmitSendToHost(void);
+    void        bufferStreamRetransmitSet(boolean);
+    uint8_t     bufferStreamRetransmitWindow(void);
+    uint8_t     bufferStreamSendBurst(void);
     boolean     bufferStreamSendToHost(StreamPacketBuffer *buf);
+    boolean     bufferStreamSequenceCheck(uint8_t);
     void        bufferStreamStoreData(StreamPacketBuffer *, char *);
     boolean     bufferStreamTimeout(void);
     boolean     byteIdGetIsStream(uint8_t);
     int         byteIdGetPacketNumber(uint8_t);
     byte        byteIdGetStreamPacketType(uint8_t);
+    uint8_t     byteIdGetStreamSequence(uint8_t);
     char        byteIdMake(boolean, uint8_t, char *, uint8_t);
     byte        byteIdMakeStreamPacketType(uint8_t);
     boolean     commsFailureTimeout(void);
@@ -137,6 +264,11 @@ public:
     uint32_t    getPollTime(void);
     boolean     hasStreamPacket(void);
     boolean     hostPacketToSend(void);
+    void        ingestChar(char);
+    void        ingestRelease(StreamPacketBuffer *);
+    int         ingestSerial(void);
+    int         ingestSerial(const char *, int);
+    boolean     ingestTimeout(void);
     boolean     isATailByte(uint8_t);
     void        ledFeedBackForPassThru(void);
     // void        moveStreamPacketToTempBuffer(volatile char *data);
@@ -147,6 +279,27 @@ public:
     boolean     pollNow(void);
     boolean     packetToSend(void);
     boolean     packetsInSerialBuffer(void);
+#ifdef OPENBCI_PERF_COUNTERS
+    void        latencyAck(void);
+    void        latencyAdd(uint8_t, unsigned long);
+    int         latencyFormat(char *, const char *, uint8_t);
+    void        latencyReset(void);
+    static uint32_t perfCycles(void);
+    void        perfBegin(void);
+    void        perfLoopEnd(uint32_t);
+    void        perfReset(void);
+    void        perfSectionEnd(uint8_t, uint32_t);
+    void        bufferSerialAddLatency(void);
+    void        printLatency(void);
+    void        printPerf(void);
+    void        printPerfSection(const char *, PerfSection *);
+#endif
+#ifdef OPENBCI_RADIO_TRACE
+    void        printTrace(void);
+    void        traceAction(uint8_t);
+    void        traceReceive(int, char *, int);
+    void        traceReset(void);
+#endif
     void        pollRefresh(void);
     void        pushRadioBuffer(void);
     void        printBaudRateChangeTo(int);
@@ -157,11 +310,13 @@ public:
     void        printFailure(void);
     void        printMessageToDriver(uint8_t);
     void        printPollTime(char);
+    void        printStreamDrops(void);
     void        printSuccess(void);
     void        printValidatedCommsTimeout(void);
     void        processCommsFailureSinglePacket(void);
     boolean     processDeviceRadioCharData(char *, int);
     boolean     processHostRadioCharData(device_t, char *, int);
+    boolean     processHostRadioStreamData(device_t, char *);
     byte        processOutboundBuffer(PacketBuffer *);
     byte        processOutboundBufferCharDouble(char *);
     byte        processOutboundBufferCharTriple(char *);
@@ -178,8 +333,15 @@ public:
     void        sendStreamPackets(void);
     boolean     serialWriteTimeOut(void);
     void        setByteIdForPacketBuffer(int);
+    void        setBaudRate(uint32_t);
     boolean     setChannelNumber(uint32_t);
     boolean     setPollTime(uint32_t);
+    boolean     timeElapsedMicros(unsigned long, unsigned long);
+    boolean     timeElapsedMillis(unsigned long, unsigned long);
+    unsigned long timeMicros(void);
+    unsigned long timeMillis(void);
+    void        timeSetSource(TimeSource, TimeSource);
+    void        timeoutsSetBaudRate(uint32_t);
     void        writeBufferToSerial(char *,int);
 
     //////////////////////
@@ -189,10 +351,29 @@ public:
     BufferRadio bufferRadio[OPENBCI_NUMBER_RADIO_BUFFERS];
     uint8_t currentRadioBufferNum;
     BufferRadio *currentRadioBuffer;
+    // Only `loop()` reads or moves these on either role, the Host's radio ISR
+    //  hands its stream packets over through `streamDeferred`
     uint8_t streamPacketBufferHead;
     uint8_t streamPacketBufferTail;
     Buffer bufferSerial;
     PacketBuffer *currentPacketBufferSerial;
+    // Host: stream packets and pages waiting to go to the PC as one block
+    char bufferOutput[OPENBCI_BUFFER_LENGTH_OUTPUT];
+    int bufferOutputLength;
+    // Host: when the first byte in `bufferOutput` went in
+    unsigned long bufferOutputSinceUs;
+    // Host: one of OPENBCI_OUTPUT_MODE_*, in throughput mode `bufferOutput`
+    //  waits for `outputBudgetBytes` or `outputBudgetUs`, whichever comes first
+    volatile uint8_t outputMode;
+    int outputBudgetBytes;
+    unsigned long outputBudgetUs;
+    // Host: stream packets thrown away because the PC did not read fast
+    //  enough and `bufferOutput` was full
+    uint32_t outputDrops;
+    // Host: the rate of the UART to the PC, and when it will have sent the
+    //  last byte handed to it, see `bufferOutputRoom`
+    uint32_t outputBaud;
+    unsigned long outputTxDoneUs;
     // BOOLEANS
     boolean debugMode;
     // CHARS
@@ -203,6 +384,7 @@ public:
     volatile boolean sendingMultiPacket;
     volatile boolean isWaitingForNewChannelNumber;
     volatile boolean isWaitingForNewPollTime;
+    volatile boolean isWaitingForNewBaudRate;
     volatile unsigned long timeOfLastPoll;
     unsigned long timeOfLastMultipacketSendToHost;
 
@@ -210,6 +392,7 @@ public:
     boolean streamPacketsHaveHeads;
     volatile boolean isWaitingForNewChannelNumberConfirmation;
     volatile boolean isWaitingForNewPollTimeConfirmation;
+    volatile boolean isWaitingForNewBaudRateConfirmation;
     volatile boolean sendSerialAck;
     volatile boolean printMessageToDriverFlag;
     volatile boolean systemUp;
@@ -222,12 +405,145 @@ public:
     volatile uint8_t ackCounter;
 
     unsigned long lastTimeHostHeardFromDevice;
+    // Device: the last ACK from the Host, in ms
+    unsigned long lastTimeDeviceHeardFromHost;
     volatile unsigned long lastTimeSerialRead;
 
 
     uint32_t radioChannel;
     uint32_t previousRadioChannel;
     uint32_t pollTime;
+
+    // Start out as the defines of the same name, change them before the
+    //  radio is in use. `numberOfStreamBuffers` can only shrink the ring.
+    uint8_t numberOfStreamBuffers;
+    uint32_t timeoutPacketNormalUs;
+    uint32_t timeoutPacketStreamUs;
+    // The rate of the Device's UART to the Pic, as the code of the Host baud
+    //  command that matches it. On the Host, the rate asked of the Device.
+    char baudRateCodeDevice;
+
+    // Device: the head stream packet buffer holds bytes `ingestChar` has not
+    //  written to the serial buffer, they are a stream packet until proven
+    //  otherwise
+    boolean ingestCandidate;
+
+    // Device: `bufferStreamSendBurst` keeps the TX FIFO full instead of sending
+    //  one stream packet per loop pass
+    boolean streamSendBurst;
+    // What a full stream packet ring does, one of OPENBCI_STREAM_OVERFLOW_*
+    uint8_t streamOverflowPolicy;
+    // Stream packets this radio's ring dropped since power on, the Device's
+    //  from the Pic and the Host's from the air
+    volatile uint32_t streamDrops;
+    // Device: number stream packets so the Host can find gaps and duplicates
+    boolean streamSequence;
+    // Device: the number the next stream packet goes out with, 1 to 7
+    uint8_t streamSequenceNext;
+    // Host: the number of the last stream packet in, 0 if none is known
+    volatile uint8_t streamSequenceLast;
+    // Host: numbered stream packets found missing and repeats thrown away
+    volatile uint32_t streamSequenceMissed;
+    volatile uint32_t streamSequenceDuplicates;
+    // Numbered packets count 1 to this, with parity on a multiple of the group
+    uint8_t streamSequenceModulo;
+    // Host: the gap the last `bufferStreamSequenceCheck` found and the ring
+    //  slot of its marker, OPENBCI_STREAM_PARITY_NO_HOLE unless it was one packet
+    uint8_t streamSequenceGap;
+    uint8_t streamSequenceGapAt;
+    // Stream packets per XOR parity frame, 0 is off
+    uint8_t streamParityGroup;
+    // The XOR of the packet types and data of the group so far, sent by the
+    //  Device or come in at the Host
+    char streamParityFrame[OPENBCI_MAX_PACKET_SIZE_BYTES];
+    // Device: packets in the group so far
+    uint8_t streamParityCount;
+    // Device: the group is complete and its parity frame goes out next. Host:
+    //  the last stream frame was a parity frame
+    boolean streamParityPending;
+    // Host: the group the packets so far are in and a bit per one that came
+    uint8_t streamParityGroupAt;
+    uint8_t streamParityReceived;
+    // Host: the ring slot of a gap marker `bufferStreamFlushBuffers` holds back
+    //  until the parity frame can fill it in, and since when
+    volatile uint8_t streamParityHole;
+    unsigned long streamParityHoleSinceUs;
+    // Host: stream packets rebuilt from a parity frame
+    volatile uint32_t streamParityRecovered;
+    // Device: keep the numbered packets sent to send again. Host: ask for the
+    //  lost ones and hold their gap markers
+    boolean streamRetransmit;
+    // Device: the last packet sent with each sequence number, as sent
+    char streamHistory[OPENBCI_STREAM_SEQUENCE_MODULO][OPENBCI_MAX_PACKET_SIZE_BYTES];
+    // A bit per sequence number, bit 0 is 1. Device: asked for again. Host:
+    //  still to ask for
+    volatile uint8_t streamNack;
+    // Host: asked for and not seen new since, and of those the ones whose gap
+    //  marker waits in the ring at `streamRetransmitSlot` since
+    //  `streamRetransmitSinceUs`
+    volatile uint8_t streamRetransmitAsked;
+    volatile uint8_t streamRetransmitWaiting;
+    uint8_t streamRetransmitSlot[OPENBCI_STREAM_SEQUENCE_MODULO];
+    unsigned long streamRetransmitSinceUs[OPENBCI_STREAM_SEQUENCE_MODULO];
+    // Host: how long a gap marker waits, starts out as OPENBCI_STREAM_RETRANSMIT_TIMEOUT_uS
+    unsigned long streamRetransmitTimeoutUs;
+    // Device: packets sent again. Host: packets that came again in time and
+    //  gap markers that gave up waiting
+    volatile uint32_t streamRetransmitSent;
+    volatile uint32_t streamRetransmitRecovered;
+    volatile uint32_t streamRetransmitExpired;
+    // Device: pack queued stream samples as deltas when they fit. The Host
+    //  writes out packed frames whether or not it is on
+    boolean streamDelta;
+    // The last sample sent or written out, the sample number, channels and
+    //  aux, that the next packed one is a delta from, if valid
+    char streamDeltaReference[OPENBCI_MAX_DATA_BYTES_IN_PACKET];
+    boolean streamDeltaReferenceValid;
+    // Device: packed frames sent since the last plain packet
+    uint8_t streamDeltaRun;
+    // Device: the Pic sends packets ending in 0xCE, which the Host would take
+    //  for packed frames, so packing stays off
+    boolean streamDeltaRefused;
+    // Host: lost packets, the next one stored gets `deltaBreak`
+    volatile boolean streamDeltaBreak;
+    // Device: samples sent packed. Host: samples written out from packed
+    //  frames and ones that could not be, with a gap marker in their place
+    volatile uint32_t streamDeltaSamples;
+    volatile uint32_t streamDeltaUndecoded;
+    // Host: stream frames the radio ISR copied for `loop()` to take apart, the
+    //  ISR pushes and `loop()` pops
+    OpenBCI_Radios_Ring<StreamFrame, OPENBCI_NUMBER_STREAM_DEFERRED> streamDeferred;
+    // Host: frames the ISR had no room for, and how many of them `loop()`
+    //  has counted in `streamDrops`
+    volatile uint8_t streamDeferredDropped;
+    uint8_t streamDeferredDroppedSeen;
+
+    TimeSource timeSourceMicros;
+    TimeSource timeSourceMillis;
+
+#ifdef OPENBCI_PERF_COUNTERS
+    // PERF_SECTION_ON_RECEIVE is only written by the ISR, the rest only by
+    //  the loop
+    PerfSection perfSections[PERF_SECTION_COUNT];
+    uint32_t perfIdleLoops;
+    uint32_t perfIdleCycles;
+    uint32_t perfWindowStart;
+    // Bumped by anything in a loop pass that did real work
+    uint32_t perfWork;
+    uint32_t latencyHistogram[LATENCY_STAGE_COUNT][OPENBCI_LATENCY_BUCKETS];
+    // Device: when the stream packets still waiting on an ACK went to Gazell
+    unsigned long latencyAirSentUs[OPENBCI_LATENCY_AIR_SLOTS];
+    uint8_t latencyAirHead;
+    uint8_t latencyAirCount;
+    // Host: stream packets in `bufferOutput`, each one waits on its write
+    uint8_t latencyOutputPackets;
+#endif
+#ifdef OPENBCI_RADIO_TRACE
+    // Written by the ISR, entry n lives at n & (OPENBCI_TRACE_ENTRIES - 1)
+    TraceEntry traceEntries[OPENBCI_TRACE_ENTRIES];
+    volatile uint32_t traceTotal;
+    volatile boolean traceEnabled;
+#endif
 };
 
 // Very important, major key to success #christmas
@@ -20,20 +20,68 @@
 
 #define OPENBCI_TIMEOUT_PACKET_NRML_uS 500 // The time to wait before determining a multipart packet is ready to be send
 #define OPENBCI_TIMEOUT_PACKET_STREAM_uS 88 // Slightly longer than it takes to send a serial byte at 115200
+#define OPENBCI_STREAM_SEND_BURST true // Fill every free TX FIFO slot from the stream ring each loop pass, not just one
 #define OPENBCI_TIMEOUT_PACKET_POLL_MS 48 // Poll time out length for sending null packet from device to host
-#define OPENBCI_TIMEOUT_COMMS_MS 270 // Comms failure time out length. Used only by Host.
+#define OPENBCI_TIMEOUT_COMMS_MS 270 // Comms failure time out length. The Device only uses it to drop its baud rate.
 
 // Stream byte stuff
 #define OPENBCI_STREAM_BYTE_START 0xA0
 #define OPENBCI_STREAM_BYTE_STOP 0xC0
+#define OPENBCI_STREAM_SEQUENCE false // Device: number stream packets in bits[2:0] of the byteId
+#define OPENBCI_STREAM_SEQUENCE_MODULO 7 // Numbered packets count 1 to 7, 0 is a packet without a number or a parity frame
+// Tail byte 0xCF, the Host's marker for numbered packets lost on air. The Pic
+//  may send 0xCF too and the driver sees the same tail, so with sequence
+//  numbers on only a Pic that doesn't send 0xCF gives markers that mean loss
+#define OPENBCI_STREAM_PACKET_TYPE_GAP 0x0F
+#define OPENBCI_STREAM_PARITY_GROUP 0 // Stream packets per XOR parity frame, 0 sends none
+#define OPENBCI_STREAM_PARITY_GROUP_MIN 2 // One packet per parity frame looks like two parity frames in a row
+#define OPENBCI_STREAM_PARITY_GROUP_MAX 6 // A group has to fit in the sequence numbers
+#define OPENBCI_STREAM_PARITY_NO_HOLE 0xFF // No gap marker waiting on a parity frame
+#define OPENBCI_STREAM_PARITY_HOLE_TIMEOUT_uS 30000 // Host: how long a gap marker waits on its parity frame, a group of 6 and its parity frame take 28ms at 250Hz
+#define OPENBCI_STREAM_RETRANSMIT false // Device: keep sent stream packets to send again, Host: ask for lost ones
+#define OPENBCI_STREAM_RETRANSMIT_WINDOW 4 // The last 4 numbered packets can be asked for, fewer if the numbers wrap sooner
+#define OPENBCI_STREAM_RETRANSMIT_TIMEOUT_uS 12000 // Host: how long a gap marker waits for its packet to come again
+#define OPENBCI_STREAM_PACKET_TYPE_DELTA 0x0E // Tail byte 0xCE, samples packed as deltas, the Host writes them out one by one
+#define OPENBCI_STREAM_DELTA false // Device: pack queued stream samples as deltas from the one before when they fit
+#define OPENBCI_STREAM_DELTA_SAMPLES_MAX 3 // Samples in one packed frame, at least 2
+#define OPENBCI_STREAM_DELTA_KEY_INTERVAL 8 // Device: a plain packet after this many packed ones, so a Host that lost one picks up again
+#define OPENBCI_STREAM_DELTA_WIDTH_MAX 15 // Bits for a zigzag delta, a wider one goes out plain
+#define OPENBCI_STREAM_DELTA_POS_WIDTHS 1 // A nibble per channel, the first one high
+#define OPENBCI_STREAM_DELTA_POS_AUX_WIDTH 5
+#define OPENBCI_STREAM_DELTA_POS_AUX_MODES 6 // Two bits per sample, the first one low
+#define OPENBCI_STREAM_DELTA_POS_BITS 7
+#define OPENBCI_STREAM_DELTA_BITS 192 // (31 - 7) * 8
+#define OPENBCI_STREAM_DELTA_AUX_ZERO 0 // All six aux bytes are 0
+#define OPENBCI_STREAM_DELTA_AUX_DELTA 1 // Three 16 bit deltas from the sample before
+#define OPENBCI_STREAM_DELTA_AUX_RAW 2 // The six aux bytes as they are
+#define OPENBCI_STREAM_POS_CHANNELS 1 // In a sample: the sample number, 8 channels of 3 bytes, 3 aux of 2 bytes
+#define OPENBCI_STREAM_POS_AUX 25
+#define OPENBCI_STREAM_CHANNELS 8
+#define OPENBCI_STREAM_AUX 3
 
 // Max buffer lengths
 #define OPENBCI_BUFFER_LENGTH_MULTI 528 // 16 * 33
+#define OPENBCI_BUFFER_LENGTH_OUTPUT 528 // Host: 16 stream packets to the PC in one write
+
+// When the Host writes `bufferOutput` to the PC
+#define OPENBCI_OUTPUT_MODE_LATENCY 0 // Every stream packet as soon as it leaves the ring
+#define OPENBCI_OUTPUT_MODE_THROUGHPUT 1 // Once the byte or time budget is used up
+#define OPENBCI_OUTPUT_MODE OPENBCI_OUTPUT_MODE_LATENCY
+#define OPENBCI_OUTPUT_BUDGET_BYTES 495 // 15 stream packets, 8 full 62 byte FTDI USB packets
+#define OPENBCI_OUTPUT_BUDGET_uS 1000 // One full speed USB frame
 
 // Number of buffers
 #define OPENBCI_NUMBER_RADIO_BUFFERS 1
 #define OPENBCI_NUMBER_SERIAL_BUFFERS 16
 #define OPENBCI_NUMBER_STREAM_BUFFERS 25 // This should be at least one greater than poll time divided by packet interval to allow for the ack counter.
+#define OPENBCI_INGEST_MAX_BYTES 64 // The RFduino's UART RX ring
+#define OPENBCI_NUMBER_STREAM_DEFERRED 8 // Host: stream frames the radio ISR leaves for loop(), a power of 2
+
+// What a full stream packet ring does with one more packet
+#define OPENBCI_STREAM_OVERFLOW_DROP_NEWEST 0 // Refuse the new packet
+#define OPENBCI_STREAM_OVERFLOW_DROP_OLDEST 1 // Give up the oldest packet not sent yet
+#define OPENBCI_STREAM_OVERFLOW_BLOCK 2 // Device only: stop reading the Pic until there is room
+#define OPENBCI_STREAM_OVERFLOW_POLICY OPENBCI_STREAM_OVERFLOW_DROP_NEWEST
 
 // These are the three different possible configuration modes for this library
 #define OPENBCI_MODE_DEVICE 0
@@ -78,6 +126,14 @@
 #define ORPM_CHANGE_POLL_TIME_HOST_REQUEST 0x07 //
 #define ORPM_CHANGE_POLL_TIME_DEVICE_READY 0x08 //
 #define ORPM_GET_POLL_TIME 0x09 //
+#define ORPM_GET_LATENCY 0x0A // Send the Device's latency histograms
+#define ORPM_CHANGE_BAUD_HOST_REQUEST 0x0B // The Host wants the Device's UART at a new rate
+#define ORPM_CHANGE_BAUD_DEVICE_READY 0x0C //
+#define ORPM_GET_STREAM_DROPS 0x0D // Send the Device's stream ring drop counter
+#define ORPM_STREAM_PARITY_SET 0x10 // 0x10 + N, send a parity frame every N stream packets, the Device echoes it
+#define ORPM_STREAM_RETRANSMIT_SET 0x18 // 0x18 off, 0x19 on, the Device echoes it
+#define ORPM_STREAM_DELTA_SET 0x1A // 0x1A off, 0x1B on, the Device echoes it
+#define ORPM_STREAM_NACK 0x80 // 0x80 | a bit per lost stream packet, bit 0 is sequence number 1
 
 // Used to determine what to send after a proccess out bound buffer
 #define ACTION_RADIO_SEND_NONE 0x00
@@ -120,6 +176,15 @@
 #define OPENBCI_HOST_CMD_TIME_PIN_HIGH          0x08
 #define OPENBCI_HOST_CMD_TIME_PIN_LOW           0x09
 #define OPENBCI_HOST_CMD_BAUD_HYPER             0x0A
+#define OPENBCI_HOST_CMD_PERF_GET               0x0B
+#define OPENBCI_HOST_CMD_LATENCY_GET            0x0C
+#define OPENBCI_HOST_CMD_TRACE_DUMP             0x0D
+#define OPENBCI_HOST_CMD_BAUD_DEVICE_SET        0x0E
+#define OPENBCI_HOST_CMD_STREAM_DROPS_GET       0x0F
+#define OPENBCI_HOST_CMD_STREAM_PARITY_SET      0x10
+#define OPENBCI_HOST_CMD_STREAM_RETRANSMIT_SET  0x11
+#define OPENBCI_HOST_CMD_STREAM_DELTA_SET       0x12
+#define OPENBCI_HOST_CMD_OUTPUT_MODE_SET        0x13
 
 // Raw data packet types/codes
 #define OPENBCI_PACKET_TYPE_RAW_AUX      = 3; // 0011
@@ -131,10 +196,63 @@
 #define OPENBCI_BAUD_RATE_DEFAULT 115200
 #define OPENBCI_BAUD_RATE_FAST 230400
 #define OPENBCI_BAUD_RATE_HYPER 921600
+#define OPENBCI_SERIAL_BITS_PER_BYTE 10 // Start, eight data and stop
 
 // Private Radio Places
 #define OPENBCI_HOST_PRIVATE_POS_KEY 1
 #define OPENBCI_HOST_PRIVATE_POS_CODE 2
 #define OPENBCI_HOST_PRIVATE_POS_PAYLOAD 3
 
+// Bytes the core's UART TX ring holds, SERIAL_BUFFER_SIZE in the RFduino core.
+//  Serial.write only waits for bytes past it, see bufferOutputRoom
+#define OPENBCI_SERIAL_TX_BUFFER_BYTES 64
+
+// Performance counters. Uncomment to count the cycles the Host spends in its
+//  loop, in RFduinoGZLL_onReceive and in the flush paths, then send
+//  OPENBCI_HOST_CMD_PERF_GET to read them. Also keeps per stage histograms of
+//  how long each stream packet takes from the Device's UART to the Host's,
+//  read with OPENBCI_HOST_CMD_LATENCY_GET. Commented out, every hook below
+//  compiles to nothing.
+// #define OPENBCI_PERF_COUNTERS
+#define OPENBCI_PERF_CYCLES_PER_uS 16 // The counter ticks at the 16MHz core clock
+#define OPENBCI_PERF_PERMILLE 1000
+#define OPENBCI_LATENCY_BUCKETS 10
+#define OPENBCI_LATENCY_BUCKET_MIN_uS 64 // Bucket n is under 64us << n, the last one is the rest
+#define OPENBCI_LATENCY_AIR_SLOTS RFDUINOGZLL_MAX_PACKETS_ON_TX_BUFFER // One per TX FIFO slot
+#define OPENBCI_LATENCY_LINE_MAX 128
+
+#ifdef OPENBCI_PERF_COUNTERS
+#define OPENBCI_PERF_START(_start) uint32_t _start = OpenBCI_Radios_Class::perfCycles()
+#define OPENBCI_PERF_END(_radio, _section, _start) (_radio).perfSectionEnd(OpenBCI_Radios_Class::_section, _start)
+#define OPENBCI_PERF_LOOP_END(_radio, _start) (_radio).perfLoopEnd(_start)
+#define OPENBCI_PERF_WORK(_radio) (_radio).perfWork++
+#define OPENBCI_LATENCY_COMMIT(_radio, _buf) (_buf)->readyUs = (_radio).timeMicros()
+#define OPENBCI_LATENCY_ACK(_radio) (_radio).latencyAck()
+#else
+#define OPENBCI_PERF_START(_start)
+#define OPENBCI_PERF_END(_radio, _section, _start)
+#define OPENBCI_PERF_LOOP_END(_radio, _start)
+#define OPENBCI_PERF_WORK(_radio)
+#define OPENBCI_LATENCY_COMMIT(_radio, _buf)
+#define OPENBCI_LATENCY_ACK(_radio)
+#endif
+
+// Radio frame trace. Uncomment to have the Host record every
+//  RFduinoGZLL_onReceive into a RAM ring, then send
+//  OPENBCI_HOST_CMD_TRACE_DUMP to get the ring back in binary, oldest first.
+// #define OPENBCI_RADIO_TRACE
+#define OPENBCI_TRACE_ENTRIES 64 // Must be a power of two
+#define OPENBCI_TRACE_ENTRY_BYTES 8
+// The action byte, the high nibble says what kind of frame it was
+#define OPENBCI_TRACE_ACTION_EMPTY 0x00 // No payload, a poll or an ACK
+#define OPENBCI_TRACE_ACTION_ORPM 0x10 // A single char, the ORPM code is the byte id
+#define OPENBCI_TRACE_ACTION_STREAM 0x20 // Moved to the stream ring
+#define OPENBCI_TRACE_ACTION_PROCESS 0x30 // Low nibble is the OPENBCI_PROCESS_RADIO_* result
+
+#ifdef OPENBCI_RADIO_TRACE
+#define OPENBCI_TRACE_RECEIVE(_radio, _rssi, _data, _len) (_radio).traceReceive(_rssi, _data, _len)
+#else
+#define OPENBCI_TRACE_RECEIVE(_radio, _rssi, _data, _len)
+#endif
+
 #endif
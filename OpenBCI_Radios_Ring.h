@@ -0,0 +1,136 @@
+/**
+* Name: OpenBCI_Radios_Ring.h
+* Date: 10/16/2026
+* Purpose: Ring indices and a single producer, single consumer ring for data
+*   that goes between the radio ISR and loop().
+*
+* Author: Push The World LLC (AJ Keller)
+*/
+
+#ifndef __OpenBCI_Radios_Ring__
+#define __OpenBCI_Radios_Ring__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+* A ring index only one side ever moves. The other side reads it with acquire
+*  semantics, so the slots it counts are read after it, and the side that
+*  moves it writes it with release semantics, so the slots are written before
+*  it. The nRF51 has one core and the radio ISR runs on it, so the order only
+*  has to hold against the compiler: signal fences do that and cost nothing,
+*  a DMB is not needed. A byte load or store can't be torn on the M0.
+*
+* Reads and writes like the `uint8_t` it holds, `index++` and
+*  `index = (index + n) % size` as well, which is only safe from the one side
+*  that moves it.
+*/
+class OpenBCI_Radios_RingIndex {
+
+public:
+    OpenBCI_Radios_RingIndex() : value(0) {}
+
+    /**
+    * @description Reads the index, then whatever it counts.
+    * @returns {uint8_t} - The index.
+    */
+    uint8_t load(void) const {
+        uint8_t v = value;
+        __atomic_signal_fence(__ATOMIC_ACQUIRE);
+        return v;
+    }
+
+    /**
+    * @description Writes whatever the index counts, then the index.
+    * @param `v` {uint8_t} - The new index.
+    */
+    void store(uint8_t v) {
+        __atomic_signal_fence(__ATOMIC_RELEASE);
+        value = v;
+    }
+
+    operator uint8_t() const { return load(); }
+    OpenBCI_Radios_RingIndex &operator=(uint8_t v) { store(v); return *this; }
+    OpenBCI_Radios_RingIndex &operator=(const OpenBCI_Radios_RingIndex &o) { store(o.load()); return *this; }
+    OpenBCI_Radios_RingIndex &operator++() { store(load() + 1); return *this; }
+    uint8_t operator++(int) { uint8_t v = load(); store(v + 1); return v; }
+
+private:
+    volatile uint8_t value;
+
+    // One index per ring, a copy would be a second index nobody moves
+    OpenBCI_Radios_RingIndex(const OpenBCI_Radios_RingIndex &);
+};
+
+/**
+* A ring of `N` slots of `T` with one producer and one consumer, for example
+*  the radio ISR and loop(). The producer fills `back()` in place and
+*  publishes it with `push()`, the consumer reads `front()` in place and gives
+*  it back with `pop()`. Neither side has to turn interrupts off. The indices
+*  count up and wrap at 256, so `N` has to be a power of 2 no larger than 128.
+*/
+template <typename T, uint8_t N>
+class OpenBCI_Radios_Ring {
+
+public:
+    /**
+    * @description Producer: the slot to fill next.
+    * @returns {T *} - The slot, NULL if the ring is full.
+    */
+    T *back(void) {
+        uint8_t h = head.load();
+        if ((uint8_t)(h - tail.load()) >= N) {
+            return NULL;
+        }
+        return slots + (h & (N - 1));
+    }
+
+    /**
+    * @description Producer: hands the slot from `back()` to the consumer.
+    */
+    void push(void) {
+        head.store(head.load() + 1);
+    }
+
+    /**
+    * @description Consumer: the oldest slot pushed.
+    * @returns {T *} - The slot, NULL if the ring is empty.
+    */
+    T *front(void) {
+        uint8_t t = tail.load();
+        if (t == head.load()) {
+            return NULL;
+        }
+        return slots + (t & (N - 1));
+    }
+
+    /**
+    * @description Consumer: gives the slot from `front()` back to the
+    *  producer, after the last read of it.
+    */
+    void pop(void) {
+        tail.store(tail.load() + 1);
+    }
+
+    /**
+    * @returns {uint8_t} - The number of slots pushed and not popped.
+    */
+    uint8_t size(void) const {
+        return head.load() - tail.load();
+    }
+
+    /**
+    * @description Empties the ring, only while neither side uses it.
+    */
+    void reset(void) {
+        head.store(0);
+        tail.store(0);
+    }
+
+private:
+    T slots[N];
+    OpenBCI_Radios_RingIndex head;
+    OpenBCI_Radios_RingIndex tail;
+};
+
+#endif // __OpenBCI_Radios_Ring__
@@ -24,6 +24,9 @@ void setup() {
 
 void loop() {
 
+  // Lost the Host? It forgets the baud rate it set, so go back to the default
+  radio.baudRateCommsFailure();
+
   // First we must ask if an emergency stop flag has been triggered, as a Device
   //  we must frequently ask this question as we are the only one that can
   //  initiaite a communication between back to the Driver.
@@ -47,40 +50,25 @@ void loop() {
       radio.bufferSerial.overflowed = false;
     }
   } else {
-    if (Serial.available()) { // Is there new serial data available?
-      char newChar = Serial.read();
-      // Mark the last serial as now;
-      radio.lastTimeSerialRead = micros();
-      // Store it to serial buffer
-      radio.bufferSerialAddChar(newChar);
-      // Get one char and process it
-      radio.bufferStreamAddChar((radio.streamPacketBuffer + radio.streamPacketBufferHead), newChar);
-      // Reset the poll timer to prevent contacting the host mid read
-      radio.pollRefresh();
+    if (radio.didPicSendDeviceSerialData()) { // Is there new serial data available?
+      // Store everything the UART has to either the serial buffer or the
+      //  stream packet buffer, marks the last serial read as now
+      radio.ingestSerial();
     }
 
     if ((radio.streamPacketBuffer + radio.streamPacketBufferHead)->state == radio.STREAM_STATE_READY) { // Is there a stream packet waiting to get sent to the Host?
       // Has 92uS passed since the last time we read from the serial port?
       if (radio.bufferStreamTimeout()) {
         // We are sure this is a streaming packet.
-        radio.streamPacketBufferHead++;
-        if (radio.streamPacketBufferHead > (OPENBCI_NUMBER_STREAM_BUFFERS - 1)) {
-          radio.streamPacketBufferHead = 0;
-        }
+        radio.bufferStreamCommit();
       }
     }
 
-    if ((radio.streamPacketBuffer + radio.streamPacketBufferTail)->state == radio.STREAM_STATE_READY) { // Is there a stream packet waiting to get sent to the Host?
-      if (radio.streamPacketBufferHead != radio.streamPacketBufferTail) {
-        // Try to add the tail to the TX buffer
-        if (radio.bufferStreamSendToHost(radio.streamPacketBuffer + radio.streamPacketBufferTail)) {
-          radio.streamPacketBufferTail++;
-          if (radio.streamPacketBufferTail > (OPENBCI_NUMBER_STREAM_BUFFERS - 1)) {
-            radio.streamPacketBufferTail = 0;
-          }
-        }
-      }
-    }
+    // Move queued stream packets onto the TX buffer, as many as fit
+    radio.bufferStreamSendBurst();
+
+    // A stream packet that never got its tail byte was the end of a page
+    radio.ingestTimeout();
 
     if (radio.bufferSerialHasData()) { // Is there data from the Pic waiting to get sent to Host
       // Has 3ms passed since the last time the serial port was read. Only the
@@ -94,7 +82,7 @@ void loop() {
 
     radio.bufferRadioFlushBuffers();
 
-    if (millis() > (radio.timeOfLastPoll + radio.pollTime)) {  // Has more than the poll time passed?
+    if (radio.pollNow()) {  // Has more than the poll time passed?
       // Refresh the poll timer
       radio.pollRefresh();
       // Poll the host
@@ -114,6 +102,10 @@ void loop() {
 * @param len {int} - The length of the `data` packet
 */
 void RFduinoGZLL_onReceive(device_t device, int rssi, char *data, int len) {
+  // Every call is the ACK for a packet we sent
+  OPENBCI_LATENCY_ACK(radio);
+  // The Host is still there
+  radio.lastTimeDeviceHeardFromHost = radio.timeMillis();
   // Set send data packet flag to false
   boolean sendDataPacket = false;
   // Is the length of the packer equal to one?
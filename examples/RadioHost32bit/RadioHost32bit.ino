@@ -31,22 +31,33 @@ void setup() {
 }
 
 void loop() {
-  
+  OPENBCI_PERF_START(loopStart);
+
   if (radio.printMessageToDriverFlag) {
     radio.printMessageToDriverFlag = false;
     radio.printMessageToDriver(radio.msgToPrint);
   }
 
+  // Stream packets the radio ISR left for the loop go on the ring
+  radio.bufferStreamProcessDeferred();
+
   radio.bufferStreamFlushBuffers();
 
   radio.bufferRadioFlushBuffers();
 
+  // Everything the two above queued goes to the PC in one write, now or
+  //  once the output mode's budget is used up
+  if (radio.bufferOutputReady()) {
+    radio.bufferOutputFlush();
+  }
+
   // Is there new data from the PC/Driver?
   // While loop to read successive bytes
   if (radio.didPCSendDataToHost()) {
+    OPENBCI_PERF_WORK(radio);
     char newChar = Serial.read();
     // Save the last time serial data was read to now
-    radio.lastTimeSerialRead = micros();
+    radio.lastTimeSerialRead = radio.timeMicros();
     // Get data and put it on the serial buffer
     boolean success = radio.bufferSerialAddChar(newChar);
     if (!success) {
@@ -58,6 +69,17 @@ void loop() {
   if (radio.commsFailureTimeout()) {
     // Mark the system as down
     radio.systemUp = false;
+    // Stream packet numbers wrap every 7, they can't tell how many were lost
+    //  in an outage
+    radio.streamSequenceLast = 0;
+    // and lets go of gap markers waiting on a parity frame or a packet sent
+    //  again
+    radio.bufferStreamParityReset();
+    radio.bufferStreamRetransmitReset();
+    // and a packed frame after it has lost the sample it follows
+    radio.streamDeltaBreak = true;
+    // The Device goes back to the default baud rate on the same timeout
+    radio.baudRateCodeDevice = (char)OPENBCI_HOST_CMD_BAUD_DEFAULT;
     // Check to see if data was left in the radio buffer from an incomplete
     //  multi packet transfer.. i.e. a failed over the air upload
     if (radio.bufferRadioHasData(radio.currentRadioBuffer)) {
@@ -90,7 +112,7 @@ void loop() {
             RFduinoGZLL.end();
             RFduinoGZLL.channel = radio.getChannelNumber();
             RFduinoGZLL.begin(RFDUINOGZLL_ROLE_HOST);
-            radio.lastTimeHostHeardFromDevice = millis();
+            radio.lastTimeHostHeardFromDevice = radio.timeMillis();
             radio.channelNumberSaveAttempted = true;
           } else {
             radio.bufferSerialProcessCommsFailure();
@@ -106,6 +128,7 @@ void loop() {
     }
   }
 
+  OPENBCI_PERF_LOOP_END(radio, loopStart);
 }
 
 /**
@@ -114,11 +137,13 @@ void loop() {
 *                  a packet with no length is a NULL packet that indicates a
 *                  successful message transmission
 * @param device {device_t} - The host in this case
-* @param rssi {int} - NOT used
+* @param rssi {int} - Only recorded by the radio trace
 * @param data {char *} - The packet of data sent in the packet
 * @param len {int} - The length of the `data` packet
 */
 void RFduinoGZLL_onReceive(device_t device, int rssi, char *data, int len) {
+  OPENBCI_PERF_START(isrStart);
+  OPENBCI_TRACE_RECEIVE(radio, rssi, data, len);
   // We know that the last packet was just sent
   if (radio.packetInTXRadioBuffer) {
     radio.packetInTXRadioBuffer = false;
@@ -133,13 +158,16 @@ void RFduinoGZLL_onReceive(device_t device, int rssi, char *data, int len) {
   radio.systemUp = true;
 
   // Reset the last time heard from host timer
-  radio.lastTimeHostHeardFromDevice = millis();
+  radio.lastTimeHostHeardFromDevice = radio.timeMillis();
   // Set send data packet flag to false
   boolean sendDataPacket = false;
   // Is the length of the packer equal to one?
   if (len == 1) {
     // Enter process single char subroutine
     sendDataPacket = radio.processRadioCharHost(device,data[0]);
+    // A stream packet? The loop takes it apart
+  } else if (len > 1 && radio.byteIdGetIsStream(data[0])) {
+    sendDataPacket = radio.processHostRadioStreamData(device,data);
     // Is the length of the packet greater than one?
   } else if (len > 1) {
     // Enter process char data packet subroutine
@@ -160,6 +188,10 @@ void RFduinoGZLL_onReceive(device_t device, int rssi, char *data, int len) {
       radio.msgToPrint = radio.HOST_MESSAGE_POLL_TIME;
       radio.printMessageToDriverFlag = true;
       radio.isWaitingForNewPollTimeConfirmation = false;
+    } else if (radio.isWaitingForNewBaudRateConfirmation) {
+      radio.msgToPrint = radio.HOST_MESSAGE_BAUD_DEVICE;
+      radio.printMessageToDriverFlag = true;
+      radio.isWaitingForNewBaudRateConfirmation = false;
     }
     // Are there packets waiting to be sent and was the Serial port read
     //  more then 3 ms ago?
@@ -175,4 +207,5 @@ void RFduinoGZLL_onReceive(device_t device, int rssi, char *data, int len) {
   if (sendDataPacket) {
     radio.sendPacketToDevice(device, false);
   }
+  OPENBCI_PERF_END(radio, PERF_SECTION_ON_RECEIVE, isrStart);
 }
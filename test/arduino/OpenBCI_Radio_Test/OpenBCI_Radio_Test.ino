@@ -4,6 +4,10 @@
 
 int ledPin = 2;
 
+// Clocks for testTime, stepped by hand
+unsigned long fakeMicrosNow = 0;
+unsigned long fakeMillisNow = 0;
+
 void setup() {
     pinMode(ledPin,OUTPUT);
     Serial.begin(115200);
@@ -26,6 +30,10 @@ void go() {
     testByteId();
     testOutput();
     testBuffer();
+    testTime();
+#ifdef OPENBCI_RADIO_TRACE
+    testTrace();
+#endif
     // testNonVolatileFunctions();
 
     test.end();
@@ -117,6 +125,168 @@ void testOutput() {
 
 }
 
+unsigned long fakeMicros(void) {
+    return fakeMicrosNow;
+}
+
+unsigned long fakeMillis(void) {
+    return fakeMillisNow;
+}
+
+void testTime() {
+    radio.timeSetSource(fakeMicros, fakeMillis);
+    testTimeSource();
+    testTimeMicrosWrap();
+    testTimeMillisWrap();
+    testTimeoutsSetBaudRate();
+    radio.timeSetSource(NULL, NULL);
+}
+
+void testTimeSource() {
+    test.describe("timeSetSource");
+
+    fakeMicrosNow = 1234;
+    fakeMillisNow = 56;
+    test.assertBoolean(radio.timeMicros() == 1234,true,"Reads the injected micros");
+    test.assertBoolean(radio.timeMillis() == 56,true,"Reads the injected millis");
+}
+
+void testTimeMicrosWrap() {
+    test.describe("micros wrap");
+
+    // Stamped right before the wrap
+    radio.lastTimeSerialRead = 0xFFFFFFFF - 10;
+    fakeMicrosNow = 0xFFFFFFFF - 5;
+    test.assertBoolean(radio.bufferStreamTimeout(),false,"Stream timeout not early before the wrap");
+    test.assertBoolean(radio.bufferSerialTimeout(),false,"Serial timeout not early before the wrap");
+    test.assertBoolean(radio.serialWriteTimeOut(),false,"Write timeout not early before the wrap");
+    fakeMicrosNow = 50;
+    test.assertBoolean(radio.bufferStreamTimeout(),false,"Stream timeout not early after the wrap");
+    fakeMicrosNow = OPENBCI_TIMEOUT_PACKET_STREAM_uS;
+    test.assertBoolean(radio.bufferStreamTimeout(),true,"Stream timeout fires after the wrap");
+    fakeMicrosNow = OPENBCI_TIMEOUT_PACKET_NRML_uS;
+    test.assertBoolean(radio.bufferSerialTimeout(),true,"Serial timeout fires after the wrap");
+    test.assertBoolean(radio.serialWriteTimeOut(),true,"Write timeout fires after the wrap");
+
+    radio.lastTimeSerialRead = 0;
+}
+
+void testTimeMillisWrap() {
+    test.describe("millis wrap");
+
+    uint32_t pollTime = radio.pollTime;
+    radio.pollTime = OPENBCI_TIMEOUT_PACKET_POLL_MS;
+    fakeMillisNow = 0xFFFFFFFF - 10;
+    radio.lastTimeHostHeardFromDevice = fakeMillisNow;
+    radio.pollRefresh();
+    fakeMillisNow = 5;
+    test.assertBoolean(radio.commsFailureTimeout(),false,"Comms timeout not early across the wrap");
+    test.assertBoolean(radio.pollNow(),false,"Poll not early across the wrap");
+    fakeMillisNow = OPENBCI_TIMEOUT_COMMS_MS;
+    test.assertBoolean(radio.commsFailureTimeout(),true,"Comms timeout fires after the wrap");
+    test.assertBoolean(radio.pollNow(),true,"Poll fires after the wrap");
+
+    radio.lastTimeHostHeardFromDevice = 0;
+    radio.pollTime = pollTime;
+}
+
+void testTimeoutsSetBaudRate() {
+    test.describe("timeoutsSetBaudRate");
+
+    test.assertEqualInt(radio.baudRateFromCode(OPENBCI_HOST_CMD_BAUD_DEFAULT),OPENBCI_BAUD_RATE_DEFAULT,"Maps the default baud code");
+    test.assertEqualInt(radio.baudRateFromCode(OPENBCI_HOST_CMD_BAUD_FAST),OPENBCI_BAUD_RATE_FAST,"Maps the fast baud code");
+    test.assertEqualInt(radio.baudRateFromCode(OPENBCI_HOST_CMD_BAUD_HYPER),OPENBCI_BAUD_RATE_HYPER,"Maps the hyper baud code");
+    test.assertEqualInt(radio.baudRateFromCode(OPENBCI_HOST_CMD_SYS_UP),0,"Rejects any other code");
+
+    uint32_t timeoutNormal = radio.timeoutPacketNormalUs;
+    radio.timeoutsSetBaudRate(OPENBCI_BAUD_RATE_DEFAULT);
+    test.assertEqualInt(radio.timeoutPacketStreamUs,OPENBCI_TIMEOUT_PACKET_STREAM_uS,"Keeps the stream timeout at the default baud");
+    radio.timeoutsSetBaudRate(OPENBCI_BAUD_RATE_FAST);
+    test.assertEqualInt(radio.timeoutPacketStreamUs,OPENBCI_TIMEOUT_PACKET_STREAM_uS,"Waits two byte times at the fast baud");
+    radio.timeoutsSetBaudRate(OPENBCI_BAUD_RATE_HYPER);
+    test.assertEqualInt(radio.timeoutPacketStreamUs,23,"Waits two byte times at the hyper baud");
+    test.assertEqualInt(radio.timeoutPacketNormalUs,timeoutNormal,"Leaves the serial timeout alone");
+
+    radio.lastTimeSerialRead = 0;
+    fakeMicrosNow = 23;
+    test.assertBoolean(radio.bufferStreamTimeout(),false,"Stream timeout not early at the hyper baud");
+    fakeMicrosNow = 24;
+    test.assertBoolean(radio.bufferStreamTimeout(),true,"Stream timeout fires after two hyper byte times");
+
+    radio.timeoutsSetBaudRate(OPENBCI_BAUD_RATE_DEFAULT);
+
+    test.describe("baudRateCommsFailure");
+    radio.baudRateCodeDevice = (char)OPENBCI_HOST_CMD_BAUD_HYPER;
+    radio.timeoutsSetBaudRate(OPENBCI_BAUD_RATE_HYPER);
+    fakeMillisNow = 1000;
+    radio.lastTimeDeviceHeardFromHost = fakeMillisNow;
+    fakeMillisNow += OPENBCI_TIMEOUT_COMMS_MS;
+    test.assertBoolean(radio.baudRateCommsFailure(),false,"Keeps the rate while the Host answers");
+    test.assertEqualChar(radio.baudRateCodeDevice,(char)OPENBCI_HOST_CMD_BAUD_HYPER,"Keeps the baud code");
+    fakeMillisNow++;
+    test.assertBoolean(radio.baudRateCommsFailure(),true,"Drops the rate once the Host is gone");
+    test.assertEqualChar(radio.baudRateCodeDevice,(char)OPENBCI_HOST_CMD_BAUD_DEFAULT,"Goes back to the default baud code");
+    test.assertEqualInt(radio.timeoutPacketStreamUs,OPENBCI_TIMEOUT_PACKET_STREAM_uS,"Goes back to the default stream timeout");
+    test.assertBoolean(radio.baudRateCommsFailure(),false,"Does nothing at the default rate");
+
+    radio.lastTimeDeviceHeardFromHost = 0;
+}
+
+#ifdef OPENBCI_RADIO_TRACE
+void testTrace() {
+    test.describe("radio trace");
+    char stream[] = " AJ Keller is da best programmer";
+    char page[] = " hey there, my name is AJ Keller";
+    char orpm = (char)ORPM_PACKET_MISSED;
+    radio.timeSetSource(fakeMicros, fakeMillis);
+    stream[0] = radio.byteIdMake(true,0x01,stream + 1,31);
+    page[0] = radio.byteIdMake(false,0,page + 1,31);
+
+    radio.traceReset();
+    fakeMicrosNow = 0x12345678;
+    radio.traceReceive(-40,stream,32);
+    test.assertEqualInt(radio.traceTotal,1,"Records one frame",__LINE__);
+    test.assertBoolean(radio.traceEntries[0].timeUs == 0x12345678,true,"Stamps the frame",__LINE__);
+    test.assertEqualInt(radio.traceEntries[0].len,32,"Keeps the length",__LINE__);
+    test.assertEqualByte(radio.traceEntries[0].byteId,stream[0],"Keeps the byte id",__LINE__);
+    test.assertEqualInt(radio.traceEntries[0].rssi,-40,"Keeps the RSSI",__LINE__);
+    test.assertEqualByte(radio.traceEntries[0].action,OPENBCI_TRACE_ACTION_STREAM,"Marks a stream frame",__LINE__);
+
+    radio.traceReceive(-41,&orpm,1);
+    test.assertEqualByte(radio.traceEntries[1].action,OPENBCI_TRACE_ACTION_ORPM,"Marks an ORPM code",__LINE__);
+    test.assertEqualByte(radio.traceEntries[1].byteId,ORPM_PACKET_MISSED,"Keeps the ORPM code",__LINE__);
+    radio.traceReceive(-42,NULL,0);
+    test.assertEqualByte(radio.traceEntries[2].action,OPENBCI_TRACE_ACTION_EMPTY,"Marks an empty frame",__LINE__);
+
+    radio.traceReceive(-43,page,32);
+    radio.traceAction(OPENBCI_TRACE_ACTION_PROCESS | OPENBCI_PROCESS_RADIO_PASS_LAST_SINGLE);
+    test.assertEqualByte(radio.traceEntries[3].action,OPENBCI_TRACE_ACTION_PROCESS | OPENBCI_PROCESS_RADIO_PASS_LAST_SINGLE,"Takes the process result",__LINE__);
+    radio.traceAction(OPENBCI_TRACE_ACTION_PROCESS | OPENBCI_PROCESS_RADIO_FAIL_MISSED_LAST);
+    test.assertEqualByte(radio.traceEntries[3].action,OPENBCI_TRACE_ACTION_PROCESS | OPENBCI_PROCESS_RADIO_PASS_LAST_SINGLE,"Takes only one result per frame",__LINE__);
+
+    for (int i = 0; i < OPENBCI_TRACE_ENTRIES; i++) {
+        radio.traceReceive(-44,stream,32);
+    }
+    test.assertEqualInt(radio.traceTotal,OPENBCI_TRACE_ENTRIES + 4,"Counts every frame",__LINE__);
+    test.assertEqualInt(radio.traceEntries[3].rssi,-44,"Overwrites the oldest once full",__LINE__);
+
+    radio.traceEnabled = false;
+    radio.traceReceive(-45,stream,32);
+    test.assertEqualInt(radio.traceTotal,OPENBCI_TRACE_ENTRIES + 4,"Records nothing while paused",__LINE__);
+
+    radio.traceReset();
+    orpm = (char)(ORPM_STREAM_NACK | 0x06);
+    radio.traceReceive(-46,&orpm,1);
+    test.assertEqualByte(radio.traceEntries[0].byteId,ORPM_STREAM_NACK | 0x06,"Keeps an ORPM code above the low nibble",__LINE__);
+    orpm = (char)(ORPM_STREAM_PARITY_SET + 2);
+    radio.traceReceive(-47,&orpm,1);
+    test.assertEqualByte(radio.traceEntries[1].byteId,ORPM_STREAM_PARITY_SET + 2,"Tells it from the code in its low nibble",__LINE__);
+
+    radio.traceReset();
+    radio.timeSetSource(NULL, NULL);
+}
+#endif
+
 void testNonVolatileFunctions() {
     testNonVolatileFlashNonVolatileMemory();
 }
@@ -818,6 +988,15 @@ void testBufferStream() {
     testBufferStreamReadyForNewPacket();
     testBufferStreamReset();
     testBufferStreamStoreData();
+    testIngestSerial();
+    testBufferStreamOverflow();
+    testBufferStreamSequenceCheck();
+    testBufferStreamParity();
+    testBufferStreamRetransmit();
+    testBufferStreamDelta();
+    testBufferOutput();
+    testBufferStreamDefer();
+    testRing();
 }
 
 void testBufferStreamAddData() {
@@ -887,12 +1066,863 @@ void testBufferStreamAddData() {
 
 }
 
+void testIngestSerial() {
+    test.describe("ingestSerial");
+    char sample[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES];
+    sample[0] = (char)OPENBCI_STREAM_PACKET_HEAD;
+    for (int i = 1; i < OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES - 1; i++) {
+        sample[i] = (char)i;
+    }
+    sample[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES - 1] = (char)OPENBCI_STREAM_PACKET_TAIL;
+    char extra = 'A';
+
+    testBufferStreamCleanUp();
+    radio.bufferSerialReset(OPENBCI_NUMBER_SERIAL_BUFFERS);
+    radio.timeSetSource(fakeMicros, fakeMillis);
+    fakeMicrosNow = 5000;
+
+    test.it("should take a whole stream packet in one call");
+    test.assertEqualInt(radio.ingestSerial(sample,OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES),OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES,"should take every byte",__LINE__);
+    test.assertEqualInt(radio.streamPacketBuffer->state,radio.STREAM_STATE_READY,"should leave the head stream packet ready",__LINE__);
+    test.assertEqualByte(radio.streamPacketBuffer->typeByte,OPENBCI_STREAM_PACKET_TAIL,"should keep the tail byte",__LINE__);
+    test.assertEqualBuffer(radio.streamPacketBuffer->data,sample,OPENBCI_MAX_PACKET_SIZE_BYTES,"should store the packet",__LINE__);
+    test.assertEqualInt(radio.bufferSerial.numberOfPacketsToSend,0,"should not write the packet to the serial buffer",__LINE__);
+    test.assertBoolean(radio.lastTimeSerialRead == 5000,true,"should mark the last serial read",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,0,"should not move the head",__LINE__);
+
+    test.it("should move a stream packet with a 34th byte to the serial buffer");
+    test.assertEqualInt(radio.ingestSerial(&extra,1),1,"should take the extra byte",__LINE__);
+    test.assertEqualInt(radio.streamPacketBuffer->state,radio.STREAM_STATE_INIT,"should drop the stream packet",__LINE__);
+    test.assertBoolean(radio.ingestCandidate,false,"should not have a candidate",__LINE__);
+    test.assertEqualInt(radio.bufferSerial.numberOfPacketsToSend,2,"should have two pages",__LINE__);
+    test.assertEqualBuffer(radio.bufferSerial.packetBuffer->data + 1,sample,OPENBCI_MAX_PACKET_SIZE_BYTES - 1,"should keep the bytes in order",__LINE__);
+    test.assertEqualInt((radio.bufferSerial.packetBuffer + 1)->positionWrite,4,"should have the last three bytes in the second page",__LINE__);
+    test.assertEqualByte((radio.bufferSerial.packetBuffer + 1)->data[2],OPENBCI_STREAM_PACKET_TAIL,"should keep the tail byte",__LINE__);
+    test.assertEqualByte((radio.bufferSerial.packetBuffer + 1)->data[3],extra,"should end with the extra byte",__LINE__);
+    test.assertEqualInt(radio.ingestSerial(&extra,0),0,"should take nothing from an empty read",__LINE__);
+
+    test.it("should move text with a bad tail byte to the serial buffer");
+    testBufferStreamCleanUp();
+    radio.bufferSerialReset(OPENBCI_NUMBER_SERIAL_BUFFERS);
+    char text[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES];
+    memcpy(text,sample,OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES);
+    text[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES - 1] = 'x';
+    radio.ingestSerial(text,OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES);
+    test.assertEqualInt(radio.streamPacketBuffer->state,radio.STREAM_STATE_INIT,"should not have a stream packet",__LINE__);
+    test.assertBoolean(radio.ingestCandidate,false,"should not have a candidate",__LINE__);
+    test.assertEqualBuffer(radio.bufferSerial.packetBuffer->data + 1,text,OPENBCI_MAX_PACKET_SIZE_BYTES - 1,"should keep the bytes in order",__LINE__);
+    test.assertEqualInt((radio.bufferSerial.packetBuffer + 1)->positionWrite,3,"should have the last two bytes in the second page",__LINE__);
+    test.assertEqualByte((radio.bufferSerial.packetBuffer + 1)->data[2],'x',"should end with the bad tail byte",__LINE__);
+
+    test.it("should start a new candidate on a head byte that fails a tail");
+    testBufferStreamCleanUp();
+    radio.bufferSerialReset(OPENBCI_NUMBER_SERIAL_BUFFERS);
+    text[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES - 1] = (char)OPENBCI_STREAM_PACKET_HEAD;
+    radio.ingestSerial(text,OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES);
+    test.assertBoolean(radio.ingestCandidate,true,"should have a candidate",__LINE__);
+    test.assertEqualInt(radio.streamPacketBuffer->bytesIn,1,"should hold the head byte",__LINE__);
+    test.assertEqualInt((radio.bufferSerial.packetBuffer + 1)->positionWrite,2,"should move the rest to the serial buffer",__LINE__);
+
+    test.it("should move a stalled candidate to the serial buffer on the serial timeout");
+    testBufferStreamCleanUp();
+    radio.bufferSerialReset(OPENBCI_NUMBER_SERIAL_BUFFERS);
+    char stalled[] = "nAme";
+    radio.ingestSerial(stalled,4);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,2,"should hold the text after the head byte back",__LINE__);
+    test.assertBoolean(radio.ingestTimeout(),false,"should wait for the serial timeout",__LINE__);
+    fakeMicrosNow += OPENBCI_TIMEOUT_PACKET_NRML_uS + 1;
+    test.assertBoolean(radio.ingestTimeout(),true,"should release the candidate",__LINE__);
+    test.assertBoolean(radio.ingestCandidate,false,"should not have a candidate",__LINE__);
+    test.assertEqualInt(radio.streamPacketBuffer->state,radio.STREAM_STATE_INIT,"should reset the stream packet",__LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,5,"should have all the text",__LINE__);
+    test.assertEqualBuffer(radio.bufferSerial.packetBuffer->data + 1,stalled,4,"should keep the bytes in order",__LINE__);
+    test.assertBoolean(radio.ingestTimeout(),false,"should do nothing without a candidate",__LINE__);
+
+    test.it("should leave the serial buffer alone when a stream packet commits");
+    testBufferStreamCleanUp();
+    radio.bufferSerialReset(OPENBCI_NUMBER_SERIAL_BUFFERS);
+    radio.ingestSerial(sample,OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES);
+    fakeMicrosNow += OPENBCI_TIMEOUT_PACKET_NRML_uS + 1;
+    test.assertBoolean(radio.ingestTimeout(),false,"should not release a ready stream packet",__LINE__);
+    radio.bufferStreamCommit();
+    test.assertEqualInt(radio.streamPacketBufferHead,1,"should move the head",__LINE__);
+    test.assertBoolean(radio.ingestCandidate,false,"should not have a candidate",__LINE__);
+    test.assertEqualInt(radio.bufferSerial.numberOfPacketsToSend,0,"should not have a page to send",__LINE__);
+
+    testBufferStreamCleanUp();
+    radio.bufferSerialReset(OPENBCI_NUMBER_SERIAL_BUFFERS);
+    radio.lastTimeSerialRead = 0;
+    radio.timeSetSource(NULL, NULL);
+}
+
+void testBufferStreamOverflow() {
+    test.describe("bufferStreamOverflow");
+    char sample[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES];
+    sample[0] = (char)OPENBCI_STREAM_PACKET_HEAD;
+    for (int i = 1; i < OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES - 1; i++) {
+        sample[i] = (char)i;
+    }
+    sample[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES - 1] = (char)OPENBCI_STREAM_PACKET_TAIL;
+    char buffer32[] = " AJ Keller is da best programmer";
+    buffer32[0] = radio.byteIdMake(true,0x01,(char *)buffer32 + 1, 31);
+    int last = OPENBCI_NUMBER_STREAM_BUFFERS - 1;
+
+    radio.timeSetSource(fakeMicros, fakeMillis);
+    fakeMicrosNow = 5000;
+
+    test.it("should only be full when the head is one behind the tail");
+    testBufferStreamCleanUp();
+    test.assertBoolean(radio.bufferStreamFull(),false,"should not be full when empty",__LINE__);
+    radio.streamPacketBufferHead = last;
+    test.assertBoolean(radio.bufferStreamFull(),true,"should be full with the tail at 0",__LINE__);
+    radio.streamPacketBufferHead = 4;
+    radio.streamPacketBufferTail = 5;
+    test.assertBoolean(radio.bufferStreamFull(),true,"should be full with the tail just ahead",__LINE__);
+    radio.streamPacketBufferTail = 6;
+    test.assertBoolean(radio.bufferStreamFull(),false,"should have room for one more",__LINE__);
+
+    test.it("should drop the newest packet on the device when the ring is full");
+    testBufferStreamCleanUp();
+    radio.streamDrops = 0;
+    radio.streamOverflowPolicy = OPENBCI_STREAM_OVERFLOW_DROP_NEWEST;
+    radio.streamPacketBufferHead = last;
+    radio.ingestSerial(sample,OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES);
+    test.assertBoolean(radio.bufferStreamCommit(),false,"should not queue the packet",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,last,"should keep the head",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferTail,0,"should keep the tail",__LINE__);
+    test.assertEqualInt(radio.streamPacketBuffer[last].state,radio.STREAM_STATE_INIT,"should reset the head stream packet",__LINE__);
+    test.assertBoolean(radio.ingestCandidate,false,"should not have a candidate",__LINE__);
+    test.assertEqualInt(radio.streamDrops,1,"should count the drop",__LINE__);
+
+    test.it("should drop the oldest packet on the device when the ring is full");
+    testBufferStreamCleanUp();
+    radio.streamDrops = 0;
+    radio.streamOverflowPolicy = OPENBCI_STREAM_OVERFLOW_DROP_OLDEST;
+    radio.streamPacketBufferHead = last;
+    radio.streamPacketBuffer->state = radio.STREAM_STATE_READY;
+    radio.ingestSerial(sample,OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES);
+    test.assertBoolean(radio.bufferStreamCommit(),true,"should queue the packet",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,0,"should wrap the head",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferTail,1,"should move the tail past the oldest packet",__LINE__);
+    test.assertEqualInt(radio.streamPacketBuffer->state,radio.STREAM_STATE_INIT,"should reset the oldest packet",__LINE__);
+    test.assertEqualInt(radio.streamPacketBuffer[last].state,radio.STREAM_STATE_READY,"should keep the new packet",__LINE__);
+    test.assertEqualInt(radio.streamDrops,1,"should count the drop",__LINE__);
+
+    test.it("should hold the packet and the uart on the device when blocking");
+    testBufferStreamCleanUp();
+    radio.streamDrops = 0;
+    radio.streamOverflowPolicy = OPENBCI_STREAM_OVERFLOW_BLOCK;
+    radio.streamPacketBufferHead = last;
+    radio.ingestSerial(sample,OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES);
+    test.assertBoolean(radio.bufferStreamCommit(),false,"should not queue the packet",__LINE__);
+    test.assertEqualInt(radio.streamPacketBuffer[last].state,radio.STREAM_STATE_READY,"should keep the packet at the head",__LINE__);
+    test.assertEqualInt(radio.ingestSerial(),0,"should not read the uart",__LINE__);
+    test.assertEqualInt(radio.streamDrops,0,"should not count a drop",__LINE__);
+    radio.streamPacketBufferTail = 1;
+    test.assertBoolean(radio.bufferStreamCommit(),true,"should queue the packet once the tail moves",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,0,"should wrap the head",__LINE__);
+
+    test.it("should drop the newest packet on the host when the ring is full");
+    testBufferStreamCleanUp();
+    radio.streamDrops = 0;
+    radio.streamOverflowPolicy = OPENBCI_STREAM_OVERFLOW_DROP_NEWEST;
+    radio.streamPacketBufferHead = last;
+    test.assertBoolean(radio.bufferStreamAddData((char *)buffer32),false,"should not add the packet",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,last,"should keep the head",__LINE__);
+    test.assertEqualInt(radio.streamPacketBuffer[last].bytesIn,0,"should not store the packet",__LINE__);
+    test.assertEqualInt(radio.streamDrops,1,"should count the drop",__LINE__);
+
+    test.it("should drop the oldest packet on the host when the ring is full");
+    testBufferStreamCleanUp();
+    radio.streamDrops = 0;
+    radio.streamOverflowPolicy = OPENBCI_STREAM_OVERFLOW_DROP_OLDEST;
+    radio.streamPacketBufferHead = last;
+    radio.streamPacketBuffer->bytesIn = 31;
+    test.assertBoolean(radio.bufferStreamAddData((char *)buffer32),true,"should add the packet",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,0,"should wrap the head",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferTail,1,"should move the tail past the oldest packet",__LINE__);
+    test.assertEqualInt(radio.streamPacketBuffer->bytesIn,0,"should reset the oldest packet",__LINE__);
+    test.assertEqualBuffer(radio.streamPacketBuffer[last].data,buffer32 + 1,31,"should store the new packet",__LINE__);
+    test.assertEqualInt(radio.streamDrops,1,"should count the drop",__LINE__);
+
+    testBufferStreamCleanUp();
+    radio.bufferSerialReset(OPENBCI_NUMBER_SERIAL_BUFFERS);
+    radio.streamDrops = 0;
+    radio.streamOverflowPolicy = OPENBCI_STREAM_OVERFLOW_POLICY;
+    radio.lastTimeSerialRead = 0;
+    radio.timeSetSource(NULL, NULL);
+}
+
+void testBufferStreamSequenceCheck() {
+    test.describe("bufferStreamSequenceCheck");
+    char buffer32[] = " AJ Keller is da best programmer";
+    uint8_t byteId = (uint8_t)radio.byteIdMake(true,0x00,(char *)buffer32 + 1, 31);
+
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+    radio.streamSequenceMissed = 0;
+    radio.streamSequenceDuplicates = 0;
+
+    test.it("should get the sequence number from a byteId");
+    test.assertEqualInt(radio.byteIdGetStreamSequence(0xCD),5,"should get bits 2 to 0",__LINE__);
+    test.assertEqualInt(radio.byteIdGetStreamSequence(byteId),0,"should be 0 for a packet without a number",__LINE__);
+
+    test.it("should always pass a packet without a number");
+    test.assertBoolean(radio.bufferStreamSequenceCheck(byteId),true,"should pass",__LINE__);
+    test.assertBoolean(radio.bufferStreamSequenceCheck(byteId),true,"should pass again",__LINE__);
+    test.assertEqualInt(radio.streamSequenceLast,0,"should not know a number",__LINE__);
+
+    test.it("should pass the next number in order");
+    test.assertBoolean(radio.bufferStreamSequenceCheck(byteId | 6),true,"should pass the first number",__LINE__);
+    test.assertBoolean(radio.bufferStreamSequenceCheck(byteId | 7),true,"should pass the next",__LINE__);
+    test.assertBoolean(radio.bufferStreamSequenceCheck(byteId | 1),true,"should wrap from 7 to 1",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,0,"should not queue a gap marker",__LINE__);
+    test.assertEqualInt(radio.streamSequenceMissed,0,"should not count missed packets",__LINE__);
+
+    test.it("should refuse a repeat of the last number");
+    test.assertBoolean(radio.bufferStreamSequenceCheck(byteId | 1),false,"should refuse the repeat",__LINE__);
+    test.assertEqualInt(radio.streamSequenceDuplicates,1,"should count the repeat",__LINE__);
+
+    test.it("should queue a gap marker for skipped numbers");
+    test.assertBoolean(radio.bufferStreamSequenceCheck(byteId | 5),true,"should pass the packet after the gap",__LINE__);
+    test.assertEqualInt(radio.streamSequenceMissed,3,"should count 2, 3 and 4 as missed",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,1,"should queue the marker",__LINE__);
+    test.assertEqualByte(radio.streamPacketBuffer->typeByte,OPENBCI_STREAM_BYTE_STOP | OPENBCI_STREAM_PACKET_TYPE_GAP,"should end the marker with 0xCF",__LINE__);
+    test.assertEqualByte(radio.streamPacketBuffer->data[0],3,"should hold the number missed",__LINE__);
+    test.assertEqualByte(radio.streamPacketBuffer->data[30],0,"should fill the rest with zeros",__LINE__);
+    test.assertBoolean(radio.bufferStreamSequenceCheck(byteId | 3),true,"should count a wrap as a gap",__LINE__);
+    test.assertEqualInt(radio.streamSequenceMissed,7,"should count 6, 7, 1 and 2 as missed",__LINE__);
+    test.assertEqualInt(radio.streamSequenceLast,3,"should remember the last number",__LINE__);
+
+    test.it("should start over after the last number is forgotten");
+    radio.streamSequenceLast = 0;
+    test.assertBoolean(radio.bufferStreamSequenceCheck(byteId | 6),true,"should pass any number",__LINE__);
+    test.assertEqualInt(radio.streamSequenceMissed,7,"should not count missed packets",__LINE__);
+
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+    radio.streamSequenceMissed = 0;
+    radio.streamSequenceDuplicates = 0;
+}
+
+// A stream packet of type `type` numbered `sequence`, all data bytes `fill`
+void testBufferStreamParity_Packet(char *data, uint8_t type, uint8_t sequence, char fill) {
+    data[0] = (char)(0x80 | (type << 3) | sequence);
+    for (int i = 1; i < OPENBCI_MAX_PACKET_SIZE_BYTES; i++) {
+        data[i] = fill;
+    }
+}
+
+// What the Device sends after the packets filled with `fills`, one type each
+void testBufferStreamParity_Frame(char *data, const uint8_t *types, const char *fills, uint8_t n) {
+    testBufferStreamParity_Packet(data, 0, 0, 0);
+    for (uint8_t i = 0; i < n; i++) {
+        data[0] ^= types[i] << 3;
+        for (int j = 1; j < OPENBCI_MAX_PACKET_SIZE_BYTES; j++) {
+            data[j] ^= fills[i];
+        }
+    }
+}
+
+void testBufferStreamParity() {
+    test.describe("bufferStreamParity");
+    char data[OPENBCI_MAX_PACKET_SIZE_BYTES];
+    char parity[OPENBCI_MAX_PACKET_SIZE_BYTES];
+    const uint8_t types[] = { 0x00, 0x05, 0x02 };
+    const char fills[] = { 'a', 'b', 'c' };
+
+    testBufferStreamCleanUp();
+    radio.streamSequenceMissed = 0;
+    radio.streamSequenceDuplicates = 0;
+    radio.streamParityRecovered = 0;
+
+    test.it("should wrap the numbers on a multiple of the group");
+    radio.bufferStreamParitySet(3);
+    test.assertEqualInt(radio.streamSequenceModulo,6,"should count 1 to 6 for groups of 3",__LINE__);
+    radio.bufferStreamParitySet(4);
+    test.assertEqualInt(radio.streamSequenceModulo,4,"should count 1 to 4 for groups of 4",__LINE__);
+    radio.bufferStreamParitySet(0);
+    test.assertEqualInt(radio.streamSequenceModulo,OPENBCI_STREAM_SEQUENCE_MODULO,"should count 1 to 7 with parity off",__LINE__);
+
+    test.it("should fill in a gap marker held for one missing packet");
+    radio.bufferStreamParitySet(3);
+    testBufferStreamParity_Packet(data, types[0], 1, fills[0]);
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    testBufferStreamParity_Packet(data, types[2], 3, fills[2]);
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamPacketBufferHead,3,"should queue the packets and a marker",__LINE__);
+    test.assertEqualInt(radio.streamParityHole,1,"should hold the marker",__LINE__);
+    radio.bufferStreamFlushBuffers();
+    radio.bufferStreamFlushBuffers();
+    test.assertEqualInt(radio.streamPacketBufferTail,1,"should not flush the held marker",__LINE__);
+    testBufferStreamParity_Frame(parity, types, fills, 3);
+    radio.processHostRadioCharData(DEVICE0, parity, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamParityRecovered,1,"should rebuild one packet",__LINE__);
+    test.assertEqualInt(radio.streamParityHole,OPENBCI_STREAM_PARITY_NO_HOLE,"should let go of the marker",__LINE__);
+    test.assertEqualByte((radio.streamPacketBuffer + 1)->typeByte,OPENBCI_STREAM_BYTE_STOP | types[1],"should rebuild the packet type",__LINE__);
+    test.assertEqualByte((radio.streamPacketBuffer + 1)->data[0],fills[1],"should rebuild the first data byte",__LINE__);
+    test.assertEqualByte((radio.streamPacketBuffer + 1)->data[30],fills[1],"should rebuild the last data byte",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,3,"should not queue another packet",__LINE__);
+
+    test.it("should queue the last packet of the group when it is missing");
+    testBufferStreamCleanUp();
+    testBufferStreamParity_Packet(data, types[0], 4, fills[0]);
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    testBufferStreamParity_Packet(data, types[1], 5, fills[1]);
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    radio.processHostRadioCharData(DEVICE0, parity, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamParityRecovered,2,"should rebuild one more packet",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,3,"should queue it after the others",__LINE__);
+    test.assertEqualByte((radio.streamPacketBuffer + 2)->typeByte,OPENBCI_STREAM_BYTE_STOP | types[2],"should rebuild the packet type",__LINE__);
+    test.assertEqualByte((radio.streamPacketBuffer + 2)->data[15],fills[2],"should rebuild the data",__LINE__);
+    test.assertEqualInt(radio.streamSequenceLast,6,"should take its number",__LINE__);
+    test.assertEqualInt(radio.streamSequenceMissed,2,"should count it as missed on air",__LINE__);
+    testBufferStreamParity_Packet(data, types[0], 1, fills[0]);
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamPacketBufferHead,4,"should not see a gap after it",__LINE__);
+
+    test.it("should not rebuild two missing packets");
+    radio.processHostRadioCharData(DEVICE0, parity, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamParityRecovered,2,"should not rebuild",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,4,"should not queue anything",__LINE__);
+
+    test.it("should start a new group when the parity frame was lost");
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        testBufferStreamParity_Packet(data, types[i], 4 + i, fills[i]);
+        radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    }
+    testBufferStreamParity_Packet(data, types[0], 1, fills[0]);
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    testBufferStreamParity_Packet(data, types[1], 2, fills[1]);
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamParityReceived,0x03,"should only hold the new group",__LINE__);
+    radio.processHostRadioCharData(DEVICE0, parity, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamParityRecovered,3,"should rebuild the last of the new group",__LINE__);
+    test.assertEqualByte((radio.streamPacketBuffer + 5)->data[0],fills[2],"should rebuild it from the new group",__LINE__);
+
+    test.it("should stop expecting numbers after two parity frames in a row");
+    radio.processHostRadioCharData(DEVICE0, parity, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamSequenceLast,0,"should forget the last number",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,6,"should drop the frame",__LINE__);
+    radio.processHostRadioCharData(DEVICE0, parity, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamPacketBufferHead,7,"should queue a packet without a number",__LINE__);
+
+    test.it("should let a held marker go when the stream stops mid group");
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+    radio.timeSetSource(fakeMicros, fakeMillis);
+    fakeMicrosNow = 1000;
+    testBufferStreamParity_Packet(data, types[0], 1, fills[0]);
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    testBufferStreamParity_Packet(data, types[2], 3, fills[2]);
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamParityHole,1,"should hold the marker",__LINE__);
+    fakeMicrosNow += OPENBCI_STREAM_PARITY_HOLE_TIMEOUT_uS - 1;
+    radio.bufferStreamFlushBuffers();
+    test.assertEqualInt(radio.streamPacketBufferTail,1,"should wait for the parity frame",__LINE__);
+    fakeMicrosNow += 2;
+    radio.bufferStreamFlushBuffers();
+    test.assertEqualInt(radio.streamPacketBufferTail,3,"should flush the marker and the packet behind it",__LINE__);
+    test.assertEqualInt(radio.streamParityHole,OPENBCI_STREAM_PARITY_NO_HOLE,"should stop holding",__LINE__);
+    radio.timeSetSource(NULL, NULL);
+    radio.bufferOutputDrain();
+
+    radio.bufferStreamParitySet(OPENBCI_STREAM_PARITY_GROUP);
+    testBufferStreamCleanUp();
+    radio.streamSequenceMissed = 0;
+    radio.streamSequenceDuplicates = 0;
+    radio.streamParityRecovered = 0;
+}
+
+void testBufferStreamRetransmit() {
+    test.describe("bufferStreamRetransmit");
+    char data[OPENBCI_MAX_PACKET_SIZE_BYTES];
+
+    radio.timeSetSource(fakeMicros, fakeMillis);
+    fakeMicrosNow = 1000;
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+    radio.streamSequenceMissed = 0;
+    radio.streamSequenceDuplicates = 0;
+    radio.streamRetransmitRecovered = 0;
+    radio.streamRetransmitExpired = 0;
+    radio.packetInTXRadioBuffer = false;
+    radio.bufferStreamRetransmitSet(true);
+
+    test.it("should only take back numbers the Device still has");
+    test.assertEqualInt(radio.bufferStreamRetransmitWindow(),OPENBCI_STREAM_RETRANSMIT_WINDOW,"should keep the window with 7 numbers",__LINE__);
+    radio.streamSequenceModulo = 4;
+    test.assertEqualInt(radio.bufferStreamRetransmitWindow(),3,"should shrink the window below the wrap",__LINE__);
+    radio.streamSequenceModulo = OPENBCI_STREAM_SEQUENCE_MODULO;
+
+    test.it("should hold a marker per lost packet and ask for them");
+    testBufferStreamParity_Packet(data, 0x00, 1, 'a');
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    testBufferStreamParity_Packet(data, 0x00, 4, 'd');
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamPacketBufferHead,4,"should queue two markers and the packets",__LINE__);
+    test.assertEqualByte((radio.streamPacketBuffer + 1)->data[0],1,"should mark one packet in each",__LINE__);
+    test.assertEqualInt(radio.streamRetransmitWaiting,0x06,"should wait on 2 and 3",__LINE__);
+    test.assertEqualByte(radio.singleCharMsg[0],ORPM_STREAM_NACK | 0x06,"should ask for 2 and 3 on the ACK",__LINE__);
+    test.assertBoolean(radio.packetInTXRadioBuffer,true,"should fill the ACK payload",__LINE__);
+    test.assertEqualInt(radio.streamNack,0,"should have asked",__LINE__);
+    radio.bufferStreamFlushBuffers();
+    radio.bufferStreamFlushBuffers();
+    test.assertEqualInt(radio.streamPacketBufferTail,1,"should hold the first marker",__LINE__);
+
+    test.it("should put a packet sent again in its marker's place");
+    testBufferStreamParity_Packet(data, 0x03, 2, 'b');
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamRetransmitRecovered,1,"should count it",__LINE__);
+    test.assertEqualByte((radio.streamPacketBuffer + 1)->typeByte,0xC3,"should store it in the first marker",__LINE__);
+    test.assertEqualByte((radio.streamPacketBuffer + 1)->data[0],'b',"should store its data",__LINE__);
+    test.assertEqualInt(radio.streamSequenceLast,4,"should not move the last number",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,4,"should not queue it",__LINE__);
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamSequenceDuplicates,1,"should drop it the second time",__LINE__);
+    radio.bufferStreamFlushBuffers();
+    test.assertEqualInt(radio.streamPacketBufferTail,2,"should let it out",__LINE__);
+
+    test.it("should let a marker out when it waited too long");
+    radio.bufferStreamFlushBuffers();
+    test.assertEqualInt(radio.streamPacketBufferTail,2,"should hold the second marker",__LINE__);
+    fakeMicrosNow += radio.streamRetransmitTimeoutUs + 1;
+    radio.bufferStreamFlushBuffers();
+    test.assertEqualInt(radio.streamPacketBufferTail,4,"should let it out and the one behind it",__LINE__);
+    test.assertEqualInt(radio.streamRetransmitExpired,1,"should count it",__LINE__);
+    testBufferStreamParity_Packet(data, 0x00, 3, 'c');
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamSequenceDuplicates,2,"should drop it when it comes late",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,4,"should not queue it",__LINE__);
+
+    test.it("should take a number as new once the Device can't send it again");
+    radio.packetInTXRadioBuffer = false;
+    testBufferStreamParity_Packet(data, 0x00, 6, 'f');
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamRetransmitWaiting,0x10,"should wait on 5",__LINE__);
+    testBufferStreamParity_Packet(data, 0x00, 2, 'b');
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamRetransmitWaiting,0x10 | 0x40 | 0x01,"should wait on 5, 7 and 1",__LINE__);
+    testBufferStreamParity_Packet(data, 0x00, 5, 'e');
+    radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamSequenceLast,5,"should take 5 as the next packet",__LINE__);
+    test.assertEqualInt(radio.streamRetransmitWaiting & 0x10,0,"should stop waiting on the old 5",__LINE__);
+    test.assertEqualInt(radio.streamRetransmitWaiting,0x40 | 0x01 | 0x04 | 0x08,"should wait on 3 and 4 in front of it",__LINE__);
+
+    radio.bufferStreamRetransmitSet(OPENBCI_STREAM_RETRANSMIT);
+    radio.packetInTXRadioBuffer = false;
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+    radio.streamSequenceMissed = 0;
+    radio.streamSequenceDuplicates = 0;
+    radio.timeSetSource(NULL, NULL);
+}
+
+// Queues a ready Device stream packet, sample `number`, channel `c` at
+//  `base + c * step` and every aux value at `aux`
+void testBufferStreamDelta_Sample(uint8_t index, uint8_t number, int32_t base, int32_t step, uint16_t aux) {
+    OpenBCI_Radios_Class::StreamPacketBuffer *buf = radio.streamPacketBuffer + index;
+    buf->data[1] = number;
+    for (int c = 0; c < OPENBCI_STREAM_CHANNELS; c++) {
+        int32_t value = base + c * step;
+        buf->data[1 + OPENBCI_STREAM_POS_CHANNELS + c * 3] = (char)(value >> 16);
+        buf->data[2 + OPENBCI_STREAM_POS_CHANNELS + c * 3] = (char)(value >> 8);
+        buf->data[3 + OPENBCI_STREAM_POS_CHANNELS + c * 3] = (char)value;
+    }
+    for (int a = 0; a < OPENBCI_STREAM_AUX; a++) {
+        buf->data[1 + OPENBCI_STREAM_POS_AUX + a * 2] = (char)(aux >> 8);
+        buf->data[2 + OPENBCI_STREAM_POS_AUX + a * 2] = (char)aux;
+    }
+    buf->typeByte = 0xC0;
+    buf->state = radio.STREAM_STATE_READY;
+}
+
+void testBufferStreamDelta() {
+    test.describe("bufferStreamDelta");
+    char previous[3] = { 0x7F, (char)0xFF, (char)0xFF };
+    char current[3] = { (char)0x80, 0x00, 0x00 };
+    char frame[OPENBCI_MAX_PACKET_SIZE_BYTES];
+    char expected[OPENBCI_MAX_DATA_BYTES_IN_PACKET];
+
+    test.it("should zigzag a delta so small steps either way are small");
+    test.assertEqualInt(radio.bufferStreamDeltaZigzag(previous, previous, 3),0,"should be 0 for no change",__LINE__);
+    test.assertEqualInt(radio.bufferStreamDeltaZigzag(previous, current, 3),2,"should wrap +1 across the top",__LINE__);
+    test.assertEqualInt(radio.bufferStreamDeltaZigzag(current, previous, 3),1,"should wrap -1 across the top",__LINE__);
+    radio.bufferStreamDeltaApply(previous, 2, 3);
+    test.assertEqualByte(previous[0],0x80,"should add it back with the same wrap",__LINE__);
+    test.assertEqualByte(previous[2],0x00,"should carry through every byte",__LINE__);
+    test.assertEqualInt(radio.bufferStreamDeltaWidth(0),0,"should need no bits for 0",__LINE__);
+    test.assertEqualInt(radio.bufferStreamDeltaWidth(0x7FFF),15,"should need 15 bits for 0x7FFF",__LINE__);
+
+    test.it("should read back the bits it wrote");
+    uint8_t at = 0;
+    for (int i = 0; i < OPENBCI_MAX_PACKET_SIZE_BYTES; i++) {
+        frame[i] = 0;
+    }
+    radio.bufferStreamDeltaPut(frame, &at, 5, 3);
+    radio.bufferStreamDeltaPut(frame, &at, 0x1FF, 9);
+    test.assertEqualInt(at,12,"should move past both",__LINE__);
+    at = 0;
+    test.assertEqualInt(radio.bufferStreamDeltaTake(frame, &at, 3),5,"should read the first",__LINE__);
+    test.assertEqualInt(radio.bufferStreamDeltaTake(frame, &at, 9),0x1FF,"should read the second",__LINE__);
+
+    test.it("should pack samples that follow the reference");
+    testBufferStreamCleanUp();
+    radio.bufferStreamDeltaSet(true);
+    test.assertEqualInt(radio.bufferStreamDeltaPack(frame),0,"should send plain with no reference",__LINE__);
+    for (int i = 0; i < OPENBCI_MAX_DATA_BYTES_IN_PACKET; i++) {
+        radio.streamDeltaReference[i] = 0;
+    }
+    radio.streamDeltaReference[0] = 9;
+    radio.streamDeltaReferenceValid = true;
+    testBufferStreamDelta_Sample(0, 10, -5, 1, 0);
+    testBufferStreamDelta_Sample(1, 11, 3, -1, 0x7234);
+    testBufferStreamDelta_Sample(2, 12, 1, -1, 0x7236);
+    radio.streamPacketBufferHead = 3;
+    test.assertEqualInt(radio.bufferStreamDeltaPack(frame),3,"should pack all three",__LINE__);
+    test.assertEqualInt(radio.byteIdGetStreamPacketType(frame[0]),OPENBCI_STREAM_PACKET_TYPE_DELTA,"should mark it packed",__LINE__);
+    test.assertEqualInt(frame[1] & 0x0F,3,"should count the samples",__LINE__);
+    test.assertEqualInt(frame[1 + OPENBCI_STREAM_DELTA_POS_AUX_MODES],OPENBCI_STREAM_DELTA_AUX_ZERO | (OPENBCI_STREAM_DELTA_AUX_RAW << 2) | (OPENBCI_STREAM_DELTA_AUX_DELTA << 4),"should send aux as zero, raw then delta",__LINE__);
+    for (int i = 0; i < OPENBCI_MAX_DATA_BYTES_IN_PACKET; i++) {
+        expected[i] = radio.streamPacketBuffer[2].data[i + 1];
+    }
+
+    test.it("should write out the samples on the Host");
+    radio.bufferStreamStoreData(radio.streamPacketBuffer + 3, frame);
+    test.assertEqualByte(radio.streamPacketBuffer[3].typeByte,0xCE,"should store it as packed",__LINE__);
+    radio.streamDeltaSamples = 0;
+    radio.bufferStreamFlush(radio.streamPacketBuffer + 3);
+    test.assertEqualInt(radio.streamDeltaSamples,3,"should count them",__LINE__);
+    boolean same = true;
+    for (int i = 0; i < OPENBCI_MAX_DATA_BYTES_IN_PACKET; i++) {
+        if (radio.streamDeltaReference[i] != expected[i]) {
+            same = false;
+        }
+    }
+    test.assertBoolean(same,true,"should end on the last sample exactly",__LINE__);
+
+    test.it("should send plain when the samples don't follow on or don't fit");
+    testBufferStreamCleanUp();
+    radio.streamDeltaReference[0] = 9;
+    radio.streamDeltaReferenceValid = true;
+    testBufferStreamDelta_Sample(0, 10, 0, 0, 0);
+    testBufferStreamDelta_Sample(1, 12, 0, 0, 0);
+    radio.streamPacketBufferHead = 2;
+    test.assertEqualInt(radio.bufferStreamDeltaPack(frame),0,"should not pack a skipped sample number",__LINE__);
+    testBufferStreamDelta_Sample(1, 11, 0x100000, 0, 0);
+    test.assertEqualInt(radio.bufferStreamDeltaPack(frame),0,"should not pack a jump wider than 15 bits",__LINE__);
+    testBufferStreamDelta_Sample(1, 11, 0, 0, 0);
+    radio.streamDeltaRun = OPENBCI_STREAM_DELTA_KEY_INTERVAL;
+    test.assertEqualInt(radio.bufferStreamDeltaPack(frame),0,"should send plain every key interval",__LINE__);
+    radio.streamDeltaRun = 0;
+
+    test.it("should stand a gap marker in for samples after a lost packet");
+    radio.bufferStreamParitySet(OPENBCI_STREAM_PARITY_GROUP);
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+    radio.streamDeltaUndecoded = 0;
+    radio.streamDeltaReferenceValid = true;
+    frame[0] = (frame[0] & 0xF8) | 1;
+    radio.processHostRadioCharData(DEVICE0, frame, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    frame[0] = (frame[0] & 0xF8) | 3;
+    radio.processHostRadioCharData(DEVICE0, frame, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertEqualInt(radio.streamPacketBufferHead,3,"should queue a marker between them",__LINE__);
+    radio.bufferStreamFlushBuffers();
+    radio.bufferStreamFlushBuffers();
+    test.assertBoolean(radio.streamDeltaReferenceValid,false,"should lose the reference at the marker",__LINE__);
+    radio.bufferStreamFlushBuffers();
+    test.assertEqualInt(radio.streamDeltaUndecoded,3,"should count the samples after it",__LINE__);
+
+    test.it("should pass a Pic packet with tail 0xCE through with packing off");
+    radio.bufferStreamDeltaSet(false);
+    testBufferStreamCleanUp();
+    radio.bufferOutputDrain();
+    radio.streamSequenceLast = 0;
+    radio.streamDeltaUndecoded = 0;
+    radio.streamDeltaSamples = 0;
+    radio.streamDeltaReferenceValid = true;
+    testBufferStreamParity_Packet(frame, OPENBCI_STREAM_PACKET_TYPE_DELTA, 0, 'r');
+    radio.processHostRadioCharData(DEVICE0, frame, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    radio.bufferStreamFlush(radio.streamPacketBuffer);
+    test.assertEqualInt(radio.bufferOutputLength,OPENBCI_MAX_PACKET_SIZE_BYTES + 1,"should write one packet",__LINE__);
+    test.assertEqualByte(radio.bufferOutput[1],'r',"should keep the data as it is",__LINE__);
+    test.assertEqualByte(radio.bufferOutput[OPENBCI_MAX_PACKET_SIZE_BYTES],0xCE,"should keep the tail",__LINE__);
+    test.assertEqualInt(radio.streamDeltaUndecoded,0,"should not count it undecoded",__LINE__);
+    test.assertEqualInt(radio.streamDeltaSamples,0,"should not decode it",__LINE__);
+    radio.bufferOutputDrain();
+
+    test.it("should write out frames packed before the Device turned delta off as packed");
+    radio.bufferStreamDeltaSet(true);
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+    radio.streamDeltaSamples = 0;
+    radio.streamDeltaUndecoded = 0;
+    testBufferStreamParity_Packet(frame, OPENBCI_STREAM_PACKET_TYPE_DELTA, 0, 2);
+    radio.processHostRadioStreamData(DEVICE0, frame);
+    radio.processRadioCharHost(DEVICE0, (char)ORPM_STREAM_DELTA_SET);
+    test.assertBoolean(radio.streamDelta,true,"should wait for the frames before it",__LINE__);
+    testBufferStreamParity_Packet(frame, OPENBCI_STREAM_PACKET_TYPE_DELTA, 0, 'r');
+    radio.processHostRadioStreamData(DEVICE0, frame);
+    radio.bufferStreamProcessDeferred();
+    test.assertBoolean(radio.streamDelta,false,"should turn delta off",__LINE__);
+    test.assertBoolean(radio.streamPacketBuffer[0].packed,true,"should keep the first as packed",__LINE__);
+    test.assertBoolean(radio.streamPacketBuffer[1].packed,false,"should take the second as the Pic's",__LINE__);
+    radio.bufferStreamFlush(radio.streamPacketBuffer);
+    radio.bufferStreamFlush(radio.streamPacketBuffer + 1);
+    test.assertEqualInt(radio.streamDeltaUndecoded,2,"should decode the packed one",__LINE__);
+    test.assertEqualByte(radio.bufferOutput[radio.bufferOutputLength - OPENBCI_MAX_PACKET_SIZE_BYTES],'r',"should pass the Pic's through",__LINE__);
+    radio.bufferOutputDrain();
+
+    test.it("should only take the Host's own gap markers for a loss");
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+    radio.streamDeltaReferenceValid = false;
+    testBufferStreamParity_Packet(frame, OPENBCI_STREAM_PACKET_TYPE_GAP, 0, 'g');
+    radio.processHostRadioCharData(DEVICE0, frame, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    test.assertBoolean(radio.streamPacketBuffer[0].gap,false,"should not mark a Pic packet ending in 0xCF",__LINE__);
+    radio.bufferStreamFlush(radio.streamPacketBuffer);
+    test.assertBoolean(radio.streamDeltaReferenceValid,true,"should keep it as the reference",__LINE__);
+    test.assertEqualByte(radio.streamDeltaReference[0],'g',"should copy it",__LINE__);
+    radio.bufferStreamAddGap(1);
+    test.assertBoolean(radio.streamPacketBuffer[1].gap,true,"should mark its own marker",__LINE__);
+    radio.bufferStreamFlush(radio.streamPacketBuffer + 1);
+    test.assertBoolean(radio.streamDeltaReferenceValid,false,"should lose the reference at its marker",__LINE__);
+    radio.bufferOutputDrain();
+
+    radio.bufferStreamDeltaSet(OPENBCI_STREAM_DELTA);
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+    radio.streamSequenceMissed = 0;
+    radio.streamDeltaSamples = 0;
+    radio.streamDeltaUndecoded = 0;
+}
+
+void testBufferOutput() {
+    char data[OPENBCI_MAX_PACKET_SIZE_BYTES];
+    char page[OPENBCI_BUFFER_LENGTH_OUTPUT + 1];
+    char staged[99];
+    test.describe("bufferOutput");
+
+    test.it("should stage every ready stream packet in one pass");
+    testBufferStreamCleanUp();
+    radio.bufferOutputDrain();
+    radio.outputMode = OPENBCI_OUTPUT_MODE_THROUGHPUT;
+    radio.streamSequenceLast = 0;
+    radio.timeSetSource(fakeMicros, fakeMillis);
+    fakeMicrosNow = 5000;
+    radio.outputTxDoneUs = fakeMicrosNow;
+    for (uint8_t i = 1; i <= 3; i++) {
+        testBufferStreamParity_Packet(data, 0x00, i, 'a' + i);
+        radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+    }
+    radio.bufferStreamFlushBuffers();
+    test.assertEqualInt(radio.streamPacketBufferTail,3,"should flush all three",__LINE__);
+    test.assertEqualInt(radio.bufferOutputLength,99,"should hold three stream packets",__LINE__);
+    test.assertEqualByte(radio.bufferOutput[0],0xA0,"should start with a head byte",__LINE__);
+    test.assertEqualByte(radio.bufferOutput[1],'b',"should copy the data",__LINE__);
+    test.assertEqualByte(radio.bufferOutput[32],0xC0,"should end with the tail byte",__LINE__);
+    test.assertEqualByte(radio.bufferOutput[67],'d',"should keep them in order",__LINE__);
+
+    test.it("should wait for the budget in throughput mode");
+    test.assertBoolean(radio.bufferOutputReady(),false,"should hold less than the budget",__LINE__);
+    fakeMicrosNow += radio.outputBudgetUs + 1;
+    test.assertBoolean(radio.bufferOutputReady(),true,"should be ready after a USB frame",__LINE__);
+    fakeMicrosNow -= radio.outputBudgetUs + 1;
+    radio.outputBudgetBytes = 99;
+    test.assertBoolean(radio.bufferOutputReady(),true,"should be ready with the budget in bytes",__LINE__);
+    radio.outputBudgetBytes = OPENBCI_OUTPUT_BUDGET_BYTES;
+
+    test.it("should work out the UART's room from the baud rate");
+    test.assertEqualInt(radio.bufferOutputRoom(),OPENBCI_SERIAL_TX_BUFFER_BYTES,"should be empty",__LINE__);
+    radio.bufferOutputTxAdd(OPENBCI_SERIAL_TX_BUFFER_BYTES);
+    test.assertEqualInt(radio.bufferOutputRoom(),0,"should be full",__LINE__);
+    fakeMicrosNow += 10 * 87; // Ten byte times at 115200
+    test.assertEqualInt(radio.bufferOutputRoom(),10,"should free a byte each byte time",__LINE__);
+    fakeMicrosNow += OPENBCI_SERIAL_TX_BUFFER_BYTES * 87;
+    test.assertEqualInt(radio.bufferOutputRoom(),OPENBCI_SERIAL_TX_BUFFER_BYTES,"should empty",__LINE__);
+
+    test.it("should write as much as the UART has room for and keep the rest");
+    for (int i = 0; i < 99; i++) {
+        staged[i] = radio.bufferOutput[i];
+    }
+    radio.bufferOutputFlush();
+    test.assertEqualInt(radio.bufferOutputLength,99 - OPENBCI_SERIAL_TX_BUFFER_BYTES,"should write what fits",__LINE__);
+    test.assertEqualByte(radio.bufferOutput[0],staged[OPENBCI_SERIAL_TX_BUFFER_BYTES],"should keep the rest in order",__LINE__);
+    radio.bufferOutputFlush();
+    test.assertEqualInt(radio.bufferOutputLength,99 - OPENBCI_SERIAL_TX_BUFFER_BYTES,"should not wait on a full UART",__LINE__);
+
+    test.it("should write the rest once the UART drains");
+    fakeMicrosNow += 10000;
+    radio.bufferOutputFlush();
+    test.assertEqualInt(radio.bufferOutputLength,0,"should empty it",__LINE__);
+    test.assertBoolean(radio.bufferOutputReady(),false,"should have nothing to write",__LINE__);
+
+    test.it("should write each stream packet as it leaves the ring in latency mode");
+    radio.outputMode = OPENBCI_OUTPUT_MODE_LATENCY;
+    for (uint8_t i = 4; i <= 5; i++) {
+        fakeMicrosNow += 10000;
+        testBufferStreamParity_Packet(data, 0x00, i, 'a' + i);
+        radio.processHostRadioCharData(DEVICE0, data, OPENBCI_MAX_PACKET_SIZE_BYTES);
+        radio.bufferStreamFlushBuffers();
+        test.assertEqualInt(radio.bufferOutputLength,0,"should not hold it",__LINE__);
+    }
+    test.assertEqualInt(radio.streamPacketBufferTail,5,"should flush both",__LINE__);
+    radio.bufferOutputAddData(page, 10);
+    test.assertBoolean(radio.bufferOutputReady(),true,"should be ready with anything in it",__LINE__);
+    radio.bufferOutputDrain();
+
+    uint32_t drops = radio.outputDrops;
+    for (int i = 0; i <= OPENBCI_BUFFER_LENGTH_OUTPUT; i++) {
+        page[i] = 'p' + (i % 3);
+    }
+    test.it("should drop a stream packet that does not fit while the PC is not reading");
+    fakeMicrosNow += 10000;
+    radio.bufferOutputAddData(page, OPENBCI_BUFFER_LENGTH_OUTPUT - 10);
+    radio.bufferOutputTxAdd(OPENBCI_SERIAL_TX_BUFFER_BYTES);
+    radio.bufferOutputAddStreamPacket(data, 0xC0);
+    int held = radio.bufferOutputLength;
+    test.assertEqualInt(radio.outputDrops,drops + 1,"should count the stream packet",__LINE__);
+    test.assertEqualInt(held,OPENBCI_BUFFER_LENGTH_OUTPUT - 10,"should keep what it had",__LINE__);
+
+    test.it("should keep a page that does not fit while the PC is not reading");
+    radio.bufferOutputAddData(page, 20);
+    test.assertEqualInt(radio.outputDrops,drops + 1,"should not drop the page",__LINE__);
+    test.assertEqualInt(radio.bufferOutputLength,20,"should wait for the UART to write what it had",__LINE__);
+    test.assertEqualByte(radio.bufferOutput[19],page[19],"should hold the page",__LINE__);
+    radio.bufferOutputDrain();
+
+    test.it("should keep a page that does not fit behind a throughput budget");
+    drops = radio.outputDrops;
+    radio.outputMode = OPENBCI_OUTPUT_MODE_THROUGHPUT;
+    radio.bufferOutputAddData(page, OPENBCI_OUTPUT_BUDGET_BYTES - 1);
+    Serial.flush();
+    radio.bufferOutputAddData(page, 300);
+    test.assertEqualInt(radio.outputDrops,drops,"should not drop the reply",__LINE__);
+    test.assertEqualInt(radio.bufferOutputLength,300,"should hold the whole reply",__LINE__);
+    test.assertEqualByte(radio.bufferOutput[299],page[299],"should keep the reply in order",__LINE__);
+    radio.bufferOutputDrain();
+    test.assertEqualInt(radio.bufferOutputLength,0,"should wait for the UART to write it all",__LINE__);
+    radio.bufferOutputAddData(page, OPENBCI_BUFFER_LENGTH_OUTPUT + 1);
+    test.assertEqualInt(radio.bufferOutputLength,0,"should write more than it holds straight out",__LINE__);
+
+    radio.outputMode = OPENBCI_OUTPUT_MODE;
+    radio.timeSetSource(NULL, NULL);
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+}
+
+void testRing() {
+    OpenBCI_Radios_Ring<uint8_t, 4> ring;
+    test.describe("OpenBCI_Radios_Ring");
+
+    test.it("should start empty");
+    ring.reset();
+    test.assertBoolean(ring.front() == NULL,true,"should have nothing to pop",__LINE__);
+    test.assertEqualInt(ring.size(),0,"should hold none",__LINE__);
+
+    test.it("should pop in the order pushed");
+    *ring.back() = 1;
+    ring.push();
+    *ring.back() = 2;
+    ring.push();
+    test.assertEqualInt(ring.size(),2,"should hold two",__LINE__);
+    test.assertEqualInt(*ring.front(),1,"should pop the first one first",__LINE__);
+    ring.pop();
+    test.assertEqualInt(*ring.front(),2,"should pop the second one next",__LINE__);
+    ring.pop();
+    test.assertBoolean(ring.front() == NULL,true,"should be empty again",__LINE__);
+
+    test.it("should refuse to push when full, across the wrap");
+    for (uint8_t i = 0; i < 254; i++) {
+        ring.back();
+        ring.push();
+        ring.pop();
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        *ring.back() = 10 + i;
+        ring.push();
+    }
+    test.assertBoolean(ring.back() == NULL,true,"should have no free slot",__LINE__);
+    test.assertEqualInt(ring.size(),4,"should hold four",__LINE__);
+    test.assertEqualInt(*ring.front(),10,"should still pop the oldest",__LINE__);
+
+    test.it("should move an index like the byte it holds");
+    OpenBCI_Radios_RingIndex index;
+    index = 255;
+    index++;
+    test.assertEqualInt(index,0,"should wrap at 256",__LINE__);
+    index = (index + 3) % OPENBCI_NUMBER_STREAM_BUFFERS;
+    test.assertEqualInt(index,3 % OPENBCI_NUMBER_STREAM_BUFFERS,"should take arithmetic",__LINE__);
+}
+
+void testBufferStreamDefer() {
+    char data[OPENBCI_MAX_PACKET_SIZE_BYTES];
+    test.describe("bufferStreamDefer");
+
+    test.it("should leave a stream packet for the loop");
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+    radio.streamDeferred.reset();
+    testBufferStreamParity_Packet(data, 0x00, 1, 'a');
+    radio.processHostRadioStreamData(DEVICE0, data);
+    testBufferStreamParity_Packet(data, 0x00, 2, 'b');
+    test.assertBoolean(radio.bufferStreamDefer(data),true,"should take it",__LINE__);
+    test.assertEqualInt(radio.streamDeferred.size(),2,"should queue both",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,0,"should not touch the ring",__LINE__);
+    test.assertEqualInt(radio.streamSequenceLast,0,"should not check the number",__LINE__);
+
+    test.it("should take them apart in order in the loop");
+    radio.bufferStreamProcessDeferred();
+    test.assertEqualInt(radio.streamDeferred.size(),0,"should empty it",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,2,"should put both on the ring",__LINE__);
+    test.assertEqualByte(radio.streamPacketBuffer[1].data[0],'b',"should keep the order",__LINE__);
+    test.assertEqualInt(radio.streamSequenceLast,2,"should check the numbers",__LINE__);
+
+    test.it("should drop a packet when full and count it in the loop");
+    uint32_t drops = radio.streamDrops;
+    for (uint8_t i = 0; i < OPENBCI_NUMBER_STREAM_DEFERRED; i++) {
+        testBufferStreamParity_Packet(data, 0x00, (i + 2) % OPENBCI_STREAM_SEQUENCE_MODULO + 1, 'c');
+        radio.bufferStreamDefer(data);
+    }
+    test.assertBoolean(radio.bufferStreamDefer(data),false,"should refuse one more",__LINE__);
+    test.assertEqualInt(radio.streamDeferredDropped,1,"should count it",__LINE__);
+    test.assertEqualInt(radio.streamDrops,drops,"should leave the drops to the loop",__LINE__);
+    radio.bufferStreamProcessDeferred();
+    test.assertEqualInt(radio.streamDrops,drops + 1,"should add it to the drops",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferHead,2 + OPENBCI_NUMBER_STREAM_DEFERRED,"should take the rest",__LINE__);
+
+    test.it("should ask for a lost packet on the next ACK from the loop");
+    testBufferStreamCleanUp();
+    radio.bufferStreamRetransmitSet(true);
+    radio.streamSequenceLast = 0;
+    radio.packetInTXRadioBuffer = false;
+    radio.singleCharMsg[0] = 0;
+    testBufferStreamParity_Packet(data, 0x00, 1, 'a');
+    radio.bufferStreamDefer(data);
+    testBufferStreamParity_Packet(data, 0x00, 3, 'c');
+    radio.bufferStreamDefer(data);
+    radio.bufferStreamProcessDeferred();
+    test.assertEqualByte(radio.singleCharMsg[0],ORPM_STREAM_NACK | 0x02,"should ask for 2",__LINE__);
+    test.assertBoolean(radio.packetInTXRadioBuffer,true,"should fill the ACK payload",__LINE__);
+    test.assertEqualInt(radio.streamNack,0,"should have asked",__LINE__);
+
+    radio.bufferStreamRetransmitSet(OPENBCI_STREAM_RETRANSMIT);
+    radio.packetInTXRadioBuffer = false;
+    testBufferStreamCleanUp();
+    radio.streamSequenceLast = 0;
+    radio.streamSequenceMissed = 0;
+}
+
 void testBufferStreamCleanUp() {
     for (int i = 0; i < OPENBCI_NUMBER_STREAM_BUFFERS; i++) {
         radio.bufferStreamReset(radio.streamPacketBuffer + i);
     }
     radio.streamPacketBufferHead = 0;
     radio.streamPacketBufferTail = 0;
+    radio.ingestCandidate = false;
+    radio.streamParityHole = OPENBCI_STREAM_PARITY_NO_HOLE;
 }
 
 void testBufferStreamReadyForNewPacket() {
@@ -28,6 +28,7 @@ void go() {
     testProcessChar();
     testBufferStreamAddChar();
     testProcessRadioChar();
+    testBufferStreamSendBurst();
     testByteIdMakeStreamPacketType();
 
     digitalWrite(ledPin, LOW);
@@ -365,6 +366,152 @@ void testPacketToSend() {
 
 }
 
+void testBufferStreamSendBurst() {
+    test.describe("bufferStreamSendBurst");
+
+    test.it("should fill both TX FIFO slots from the ring");
+    testBufferStreamSendBurst_Queue(3);
+    test.assertEqualInt(radio.bufferStreamSendBurst(),RFDUINOGZLL_MAX_PACKETS_ON_TX_BUFFER,"should send two packets",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferTail,2,"should move the tail past both",__LINE__);
+    test.assertEqualByte(radio.streamPacketBuffer->state,radio.STREAM_STATE_INIT,"should reset the first packet",__LINE__);
+    test.assertEqualByte((radio.streamPacketBuffer + 2)->state,radio.STREAM_STATE_READY,"should leave the third packet queued",__LINE__);
+
+    test.it("should stop when the ring is empty");
+    testBufferStreamSendBurst_Queue(1);
+    test.assertEqualInt(radio.bufferStreamSendBurst(),1,"should send the one packet",__LINE__);
+    test.assertEqualInt(radio.bufferStreamSendBurst(),0,"should send nothing",__LINE__);
+
+    test.it("should stop at a packet that is not ready");
+    testBufferStreamSendBurst_Queue(3);
+    (radio.streamPacketBuffer + 1)->state = radio.STREAM_STATE_STORING;
+    test.assertEqualInt(radio.bufferStreamSendBurst(),1,"should send the first packet",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferTail,1,"should leave the tail on the second",__LINE__);
+
+    test.it("should send one packet per call without streamSendBurst");
+    testBufferStreamSendBurst_Queue(3);
+    radio.streamSendBurst = false;
+    test.assertEqualInt(radio.bufferStreamSendBurst(),1,"should send one packet",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferTail,1,"should move the tail one",__LINE__);
+    radio.streamSendBurst = OPENBCI_STREAM_SEND_BURST;
+
+    test.it("should number stream packets with streamSequence");
+    testBufferStreamSendBurst_Queue(2);
+    radio.streamSequence = true;
+    radio.streamSequenceNext = 7;
+    test.assertEqualInt(radio.bufferStreamSendBurst(),2,"should send two packets",__LINE__);
+    test.assertEqualInt(radio.byteIdGetStreamSequence(radio.streamPacketBuffer->data[0]),7,"should send the first as 7",__LINE__);
+    test.assertEqualInt(radio.byteIdGetStreamSequence((radio.streamPacketBuffer + 1)->data[0]),1,"should wrap the second to 1",__LINE__);
+    test.assertEqualInt(radio.streamSequenceNext,2,"should move on to 2",__LINE__);
+    radio.streamSequence = OPENBCI_STREAM_SEQUENCE;
+    radio.streamSequenceNext = 1;
+
+    test.it("should not number stream packets without streamSequence");
+    testBufferStreamSendBurst_Queue(1);
+    radio.bufferStreamSendBurst();
+    test.assertEqualInt(radio.byteIdGetStreamSequence(radio.streamPacketBuffer->data[0]),0,"should send the packet as 0",__LINE__);
+
+    test.it("should switch the parity group when the Host asks");
+    test.assertBoolean(radio.processRadioCharDevice((char)(ORPM_STREAM_PARITY_SET + 2)),false,"should not send a data packet",__LINE__);
+    test.assertEqualInt(radio.streamParityGroup,2,"should take groups of 2",__LINE__);
+
+    test.it("should send a parity frame after each group");
+    testBufferStreamSendBurst_Queue(3);
+    (radio.streamPacketBuffer + 0)->typeByte = 0xC1;
+    (radio.streamPacketBuffer + 0)->data[1] = 0x0F;
+    (radio.streamPacketBuffer + 1)->typeByte = 0xC4;
+    (radio.streamPacketBuffer + 1)->data[1] = 0x33;
+    test.assertEqualInt(radio.bufferStreamSendBurst(),2,"should send the group",__LINE__);
+    test.assertEqualInt(radio.byteIdGetStreamSequence((radio.streamPacketBuffer + 1)->data[0]),2,"should number the packets with parity on",__LINE__);
+    test.assertBoolean(radio.streamParityPending,true,"should have a parity frame waiting",__LINE__);
+    test.assertEqualByte(radio.streamParityFrame[0],0x05 << 3,"should XOR the packet types",__LINE__);
+    test.assertEqualByte(radio.streamParityFrame[1],0x0F ^ 0x33,"should XOR the data",__LINE__);
+    test.assertEqualInt(radio.bufferStreamSendBurst(),2,"should send the parity frame and the next packet",__LINE__);
+    test.assertBoolean(radio.streamParityPending,false,"should have sent the parity frame",__LINE__);
+    test.assertEqualInt(radio.streamParityCount,1,"should start the next group",__LINE__);
+    test.assertEqualInt(radio.byteIdGetStreamSequence((radio.streamPacketBuffer + 2)->data[0]),3,"should go on numbering",__LINE__);
+    radio.bufferStreamParitySet(OPENBCI_STREAM_PARITY_GROUP);
+
+    test.it("should keep the packets it sent with retransmit on");
+    test.assertBoolean(radio.processRadioCharDevice((char)(ORPM_STREAM_RETRANSMIT_SET + 1)),false,"should not send a data packet",__LINE__);
+    test.assertBoolean(radio.streamRetransmit,true,"should turn retransmit on",__LINE__);
+    testBufferStreamSendBurst_Queue(3);
+    for (uint8_t i = 0; i < 3; i++) {
+        (radio.streamPacketBuffer + i)->data[1] = 'a' + i;
+    }
+    radio.bufferStreamSendBurst();
+    radio.bufferStreamSendBurst();
+    test.assertEqualInt(radio.streamSequenceNext,4,"should number the packets",__LINE__);
+    test.assertEqualInt(radio.byteIdGetStreamSequence(radio.streamHistory[1][0]),2,"should keep the byteId as sent",__LINE__);
+    test.assertEqualChar(radio.streamHistory[1][1],'b',"should keep the data",__LINE__);
+
+    test.it("should send the packets the Host asks for again, oldest first");
+    radio.streamRetransmitSent = 0;
+    test.assertBoolean(radio.processRadioCharDevice((char)(ORPM_STREAM_NACK | 0x06)),false,"should not send a data packet",__LINE__);
+    test.assertEqualInt(radio.streamNack,0x06,"should note 2 and 3",__LINE__);
+    test.assertEqualInt(radio.bufferStreamSendBurst(),2,"should send both",__LINE__);
+    test.assertEqualInt(radio.streamRetransmitSent,2,"should count them",__LINE__);
+    test.assertEqualInt(radio.streamNack,0,"should be done",__LINE__);
+    test.assertEqualInt(radio.streamSequenceNext,4,"should not number them again",__LINE__);
+
+    test.it("should drop a request for a number it has sent again since");
+    radio.streamSequenceNext = 7;
+    radio.processRadioCharDevice((char)(ORPM_STREAM_NACK | 0x01));
+    test.assertEqualInt(radio.bufferStreamSendBurst(),0,"should send nothing",__LINE__);
+    test.assertEqualInt(radio.streamNack,0,"should forget the request",__LINE__);
+    radio.bufferStreamRetransmitSet(OPENBCI_STREAM_RETRANSMIT);
+    radio.streamSequenceNext = 1;
+
+    test.it("should send one packet plain then pack the rest with delta on");
+    test.assertBoolean(radio.processRadioCharDevice((char)(ORPM_STREAM_DELTA_SET + 1)),false,"should not send a data packet",__LINE__);
+    test.assertBoolean(radio.streamDelta,true,"should turn delta on",__LINE__);
+    testBufferStreamSendBurst_Queue(4);
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = 1; j < OPENBCI_MAX_PACKET_SIZE_BYTES; j++) {
+            (radio.streamPacketBuffer + i)->data[j] = 0;
+        }
+        (radio.streamPacketBuffer + i)->data[1] = i + 1;
+    }
+    radio.streamDeltaSamples = 0;
+    test.assertEqualInt(radio.bufferStreamSendBurst(),2,"should send two frames",__LINE__);
+    test.assertEqualInt(radio.streamPacketBufferTail,4,"should move the tail past all four",__LINE__);
+    test.assertEqualInt(radio.streamDeltaSamples,3,"should pack the last three",__LINE__);
+    test.assertEqualInt(radio.streamSequenceNext,3,"should number the frames",__LINE__);
+    test.assertEqualByte(radio.streamDeltaReference[0],4,"should go on from the last one",__LINE__);
+    radio.bufferStreamDeltaSet(OPENBCI_STREAM_DELTA);
+    radio.streamSequenceNext = 1;
+
+    test.it("should turn delta off before a Pic packet with tail 0xCE goes out plain");
+    radio.processRadioCharDevice((char)(ORPM_STREAM_DELTA_SET + 1));
+    testBufferStreamSendBurst_Queue(1);
+    radio.streamPacketBuffer->typeByte = 0xCE;
+    radio.singleCharMsg[0] = (char)0xFF;
+    test.assertEqualInt(radio.bufferStreamSendBurst(),1,"should send the packet",__LINE__);
+    test.assertEqualChar(radio.singleCharMsg[0],(char)ORPM_STREAM_DELTA_SET,"should tell the Host delta is off first",__LINE__);
+    test.assertBoolean(radio.streamDelta,false,"should turn delta off",__LINE__);
+    test.assertEqualInt(radio.byteIdGetStreamPacketType(radio.streamPacketBuffer->data[0]),OPENBCI_STREAM_PACKET_TYPE_DELTA,"should send the packet as it is",__LINE__);
+
+    test.it("should keep delta off once the Pic sent tail 0xCE");
+    test.assertBoolean(radio.processRadioCharDevice((char)(ORPM_STREAM_DELTA_SET + 1)),false,"should not send a data packet",__LINE__);
+    test.assertBoolean(radio.streamDelta,false,"should not turn delta on",__LINE__);
+    test.assertEqualChar(radio.singleCharMsg[0],(char)ORPM_STREAM_DELTA_SET,"should tell the Host it is off",__LINE__);
+    radio.streamDeltaRefused = false;
+    radio.bufferStreamDeltaSet(OPENBCI_STREAM_DELTA);
+
+    radio.bufferStreamReset();
+    testProcessChar_CleanUp();
+}
+
+// Queues `n` ready stream packets at the start of the ring
+void testBufferStreamSendBurst_Queue(uint8_t n) {
+    radio.bufferStreamReset();
+    for (uint8_t i = 0; i < n; i++) {
+        (radio.streamPacketBuffer + i)->bytesIn = OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES;
+        (radio.streamPacketBuffer + i)->typeByte = 0xC0;
+        (radio.streamPacketBuffer + i)->state = radio.STREAM_STATE_READY;
+    }
+    radio.streamPacketBufferHead = n;
+}
+
 void testByteIdMakeStreamPacketType() {
     test.describe("byteIdMakeStreamPacketType");
 
@@ -370,6 +370,7 @@ void testProcessOutboundBufferCharDouble() {
     testProcessOutboundBufferCharDouble_OPENBCI_HOST_CMD_BAUD_FAST();
     testProcessOutboundBufferCharDouble_OPENBCI_HOST_CMD_SYS_UP();
     testProcessOutboundBufferCharDouble_OPENBCI_HOST_CMD_POLL_TIME_GET();
+    testProcessOutboundBufferCharDouble_OPENBCI_HOST_CMD_STREAM_DROPS_GET();
     testProcessOutboundBufferCharDouble_default();
 
 }
@@ -515,6 +516,35 @@ void testProcessOutboundBufferCharDouble_OPENBCI_HOST_CMD_POLL_TIME_GET() {
 
 }
 
+void testProcessOutboundBufferCharDouble_OPENBCI_HOST_CMD_STREAM_DROPS_GET() {
+    test.it("should print the host's stream drops and ask the device for its own if the system is up");
+    radio.systemUp = true;
+    radio.printMessageToDriverFlag = false;
+    radio.msgToPrint = 25;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_STREAM_DROPS_GET;
+    radio.bufferSerial.packetBuffer->positionWrite = 3;
+    radio.singleCharMsg[0] = (char)0xFF;
+    test.assertEqualByte(radio.processOutboundBufferCharDouble(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_SINGLE_CHAR, "should send the single char message", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_STREAM_DROPS, "should get stream drops message code", __LINE__);
+    test.assertBoolean(radio.printMessageToDriverFlag,true,"sets the print flag to high", __LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,0x01, "should clear the serial buffer to position write 1", __LINE__);
+    test.assertEqualChar(radio.singleCharMsg[0],(char)ORPM_GET_STREAM_DROPS, "should store stream drops request in single char buffer", __LINE__);
+
+    test.it("should only print the host's stream drops if the system is down");
+    radio.systemUp = false;
+    radio.printMessageToDriverFlag = false;
+    radio.msgToPrint = 25;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_STREAM_DROPS_GET;
+    radio.bufferSerial.packetBuffer->positionWrite = 3;
+    test.assertEqualByte(radio.processOutboundBufferCharDouble(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_NONE, "should not send any message", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_STREAM_DROPS, "should get stream drops message code", __LINE__);
+    test.assertBoolean(radio.printMessageToDriverFlag,true,"sets the print flag to high", __LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,0x01, "should set position to 1", __LINE__);
+
+}
+
 void testProcessOutboundBufferCharDouble_default() {
     test.it("should do nothing if system is up");
     radio.systemUp = true;
@@ -548,6 +578,11 @@ void testProcessOutboundBufferCharTriple() {
     testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_CHANNEL_SET();
     testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_POLL_TIME_SET();
     testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_CHANNEL_SET_OVERIDE();
+    testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_BAUD_DEVICE_SET();
+    testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_STREAM_PARITY_SET();
+    testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_STREAM_RETRANSMIT_SET();
+    testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_STREAM_DELTA_SET();
+    testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_OUTPUT_MODE_SET();
     testProcessOutboundBufferCharTriple_default();
 
 }
@@ -727,6 +762,217 @@ void testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_CHANNEL_SET_OVERIDE()
 
 }
 
+void testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_BAUD_DEVICE_SET() {
+    test.detail("OPENBCI_HOST_CMD_BAUD_DEVICE_SET");
+    test.it("should send a request to the device to change baud rate when system is up");
+    radio.systemUp = true;
+    radio.baudRateCodeDevice = (char)OPENBCI_HOST_CMD_BAUD_DEFAULT;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_BAUD_DEVICE_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)OPENBCI_HOST_CMD_BAUD_HYPER;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    radio.singleCharMsg[0] = (char)0xFF;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_SINGLE_CHAR,"should send a private radio message", __LINE__);
+    test.assertEqualChar(radio.baudRateCodeDevice,(char)OPENBCI_HOST_CMD_BAUD_HYPER,"should capture the new baud code", __LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,0x01, "should reset the write position to 1", __LINE__);
+    test.assertEqualChar(radio.singleCharMsg[0],(char)ORPM_CHANGE_BAUD_HOST_REQUEST, "should store host baud change request in single char buffer", __LINE__);
+
+    test.it("should not send a request to the device for a code that is not a baud rate");
+    radio.systemUp = true;
+    radio.msgToPrint = 25;
+    radio.baudRateCodeDevice = (char)OPENBCI_HOST_CMD_BAUD_DEFAULT;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_BAUD_DEVICE_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)0x42;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    radio.singleCharMsg[0] = (char)0xFF;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_NONE,"should take no radio action", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_BAUD_DEVICE_VERIFY, "should send verify baud code message", __LINE__);
+    test.assertEqualChar(radio.baudRateCodeDevice,(char)OPENBCI_HOST_CMD_BAUD_DEFAULT,"should not have changed the baud code", __LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,0x01, "should reset the write position to 1", __LINE__);
+    test.assertEqualChar(radio.singleCharMsg[0],(char)0xFF, "should not store anything to the singleCharMsg buffer", __LINE__);
+
+    test.it("should not send a request to the device to change baud rate when system is down");
+    radio.systemUp = false;
+    radio.msgToPrint = 25;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_BAUD_DEVICE_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)OPENBCI_HOST_CMD_BAUD_FAST;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    radio.singleCharMsg[0] = (char)0xFF;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_NONE, "should not send any message", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_COMMS_DOWN, "should get comms down message code", __LINE__);
+    test.assertEqualChar(radio.baudRateCodeDevice,(char)OPENBCI_HOST_CMD_BAUD_DEFAULT,"should not have changed the baud code", __LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,0x01, "should set position to 1", __LINE__);
+}
+
+void testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_STREAM_PARITY_SET() {
+    test.detail("OPENBCI_HOST_CMD_STREAM_PARITY_SET");
+    test.it("should ask the device for a parity group when system is up");
+    radio.systemUp = true;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_STREAM_PARITY_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)0x04;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    radio.singleCharMsg[0] = (char)0xFF;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_SINGLE_CHAR,"should send a private radio message", __LINE__);
+    test.assertEqualChar(radio.singleCharMsg[0],(char)(ORPM_STREAM_PARITY_SET + 4), "should carry the group in the message", __LINE__);
+    test.assertEqualInt(radio.streamParityGroup,OPENBCI_STREAM_PARITY_GROUP,"should wait for the device to switch", __LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,0x01, "should reset the write position to 1", __LINE__);
+
+    test.it("should switch when the device echoes the group");
+    radio.msgToPrint = 25;
+    test.assertBoolean(radio.processRadioCharHost(DEVICE0,(char)(ORPM_STREAM_PARITY_SET + 4)),false,"should not send a packet", __LINE__);
+    test.assertEqualInt(radio.streamParityGroup,4,"should take groups of 4", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_STREAM_PARITY, "should print the new group", __LINE__);
+    radio.bufferStreamParitySet(OPENBCI_STREAM_PARITY_GROUP);
+
+    test.it("should not ask the device for a group of 1 or more than 6");
+    const char groups[] = { 0x01, OPENBCI_STREAM_PARITY_GROUP_MAX + 1 };
+    for (int i = 0; i < 2; i++) {
+        radio.msgToPrint = 25;
+        radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+        radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_STREAM_PARITY_SET;
+        radio.bufferSerial.packetBuffer->data[3] = groups[i];
+        radio.bufferSerial.packetBuffer->positionWrite = 4;
+        radio.singleCharMsg[0] = (char)0xFF;
+        test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_NONE,"should take no radio action", __LINE__);
+        test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_STREAM_PARITY_VERIFY, "should send verify parity group message", __LINE__);
+        test.assertEqualChar(radio.singleCharMsg[0],(char)0xFF, "should not store anything to the singleCharMsg buffer", __LINE__);
+    }
+
+    test.it("should not ask the device for a group when system is down");
+    radio.systemUp = false;
+    radio.msgToPrint = 25;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_STREAM_PARITY_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)0x02;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_NONE, "should not send any message", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_COMMS_DOWN, "should get comms down message code", __LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,0x01, "should set position to 1", __LINE__);
+}
+
+void testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_STREAM_RETRANSMIT_SET() {
+    test.detail("OPENBCI_HOST_CMD_STREAM_RETRANSMIT_SET");
+    test.it("should ask the device to turn retransmit on when system is up");
+    radio.systemUp = true;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_STREAM_RETRANSMIT_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)0x01;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    radio.singleCharMsg[0] = (char)0xFF;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_SINGLE_CHAR,"should send a private radio message", __LINE__);
+    test.assertEqualChar(radio.singleCharMsg[0],(char)(ORPM_STREAM_RETRANSMIT_SET + 1), "should ask for on", __LINE__);
+    test.assertBoolean(radio.streamRetransmit,OPENBCI_STREAM_RETRANSMIT,"should wait for the device to switch", __LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,0x01, "should reset the write position to 1", __LINE__);
+
+    test.it("should switch when the device echoes it");
+    radio.msgToPrint = 25;
+    test.assertBoolean(radio.processRadioCharHost(DEVICE0,(char)(ORPM_STREAM_RETRANSMIT_SET + 1)),false,"should not send a packet", __LINE__);
+    test.assertBoolean(radio.streamRetransmit,true,"should turn retransmit on", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_STREAM_RETRANSMIT, "should print the setting", __LINE__);
+    radio.bufferStreamRetransmitSet(OPENBCI_STREAM_RETRANSMIT);
+
+    test.it("should not ask the device for anything but 0 or 1");
+    radio.msgToPrint = 25;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_STREAM_RETRANSMIT_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)0x02;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    radio.singleCharMsg[0] = (char)0xFF;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_NONE,"should take no radio action", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_STREAM_RETRANSMIT_VERIFY, "should send verify retransmit message", __LINE__);
+    test.assertEqualChar(radio.singleCharMsg[0],(char)0xFF, "should not store anything to the singleCharMsg buffer", __LINE__);
+
+    test.it("should not ask the device when system is down");
+    radio.systemUp = false;
+    radio.msgToPrint = 25;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_STREAM_RETRANSMIT_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)0x01;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_NONE, "should not send any message", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_COMMS_DOWN, "should get comms down message code", __LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,0x01, "should set position to 1", __LINE__);
+}
+
+void testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_STREAM_DELTA_SET() {
+    test.detail("OPENBCI_HOST_CMD_STREAM_DELTA_SET");
+    test.it("should ask the device to turn delta on when system is up");
+    radio.systemUp = true;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_STREAM_DELTA_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)0x01;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    radio.singleCharMsg[0] = (char)0xFF;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_SINGLE_CHAR,"should send a private radio message", __LINE__);
+    test.assertEqualChar(radio.singleCharMsg[0],(char)(ORPM_STREAM_DELTA_SET + 1), "should ask for on", __LINE__);
+    test.assertBoolean(radio.streamDelta,OPENBCI_STREAM_DELTA,"should wait for the device to switch", __LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,0x01, "should reset the write position to 1", __LINE__);
+
+    test.it("should switch when the device echoes it");
+    radio.msgToPrint = 25;
+    test.assertBoolean(radio.processRadioCharHost(DEVICE0,(char)(ORPM_STREAM_DELTA_SET + 1)),false,"should not send a packet", __LINE__);
+    test.assertBoolean(radio.streamDelta,OPENBCI_STREAM_DELTA,"should leave it to the loop", __LINE__);
+    radio.bufferStreamProcessDeferred();
+    test.assertBoolean(radio.streamDelta,true,"should turn delta on", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_STREAM_DELTA, "should print the setting", __LINE__);
+    radio.bufferStreamDeltaSet(OPENBCI_STREAM_DELTA);
+
+    test.it("should not ask the device for anything but 0 or 1");
+    radio.msgToPrint = 25;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_STREAM_DELTA_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)0x02;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    radio.singleCharMsg[0] = (char)0xFF;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_NONE,"should take no radio action", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_STREAM_DELTA_VERIFY, "should send verify delta message", __LINE__);
+    test.assertEqualChar(radio.singleCharMsg[0],(char)0xFF, "should not store anything to the singleCharMsg buffer", __LINE__);
+
+    test.it("should not ask the device when system is down");
+    radio.systemUp = false;
+    radio.msgToPrint = 25;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_STREAM_DELTA_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)0x01;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_NONE, "should not send any message", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_COMMS_DOWN, "should get comms down message code", __LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,0x01, "should set position to 1", __LINE__);
+}
+
+void testProcessOutboundBufferCharTriple_OPENBCI_HOST_CMD_OUTPUT_MODE_SET() {
+    test.detail("OPENBCI_HOST_CMD_OUTPUT_MODE_SET");
+    test.it("should switch the host to throughput mode even when system is down");
+    radio.systemUp = false;
+    radio.msgToPrint = 25;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_OUTPUT_MODE_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)OPENBCI_OUTPUT_MODE_THROUGHPUT;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    radio.singleCharMsg[0] = (char)0xFF;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_NONE,"should take no radio action", __LINE__);
+    test.assertEqualInt(radio.outputMode,OPENBCI_OUTPUT_MODE_THROUGHPUT,"should switch the mode", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_OUTPUT_MODE, "should print the mode", __LINE__);
+    test.assertBoolean(radio.printMessageToDriverFlag,true,"sets the print flag to high", __LINE__);
+    test.assertEqualChar(radio.singleCharMsg[0],(char)0xFF, "should not ask the device", __LINE__);
+    test.assertEqualInt(radio.bufferSerial.packetBuffer->positionWrite,0x01, "should reset the write position to 1", __LINE__);
+
+    test.it("should not take anything but 0 or 1");
+    radio.msgToPrint = 25;
+    radio.bufferSerial.packetBuffer->data[1] = (char)OPENBCI_HOST_PRIVATE_CMD_KEY;
+    radio.bufferSerial.packetBuffer->data[2] = (char)OPENBCI_HOST_CMD_OUTPUT_MODE_SET;
+    radio.bufferSerial.packetBuffer->data[3] = (char)0x02;
+    radio.bufferSerial.packetBuffer->positionWrite = 4;
+    test.assertEqualByte(radio.processOutboundBufferCharTriple(radio.bufferSerial.packetBuffer->data),ACTION_RADIO_SEND_NONE,"should take no radio action", __LINE__);
+    test.assertEqualInt(radio.outputMode,OPENBCI_OUTPUT_MODE_THROUGHPUT,"should keep the mode", __LINE__);
+    test.assertEqualByte(radio.msgToPrint,radio.HOST_MESSAGE_OUTPUT_MODE_VERIFY, "should send verify output mode message", __LINE__);
+    radio.outputMode = OPENBCI_OUTPUT_MODE;
+    radio.printMessageToDriverFlag = false;
+}
+
 void testProcessOutboundBufferCharTriple_default() {
     test.detail("default");
     test.it("should do nothing and take a normal radio action");
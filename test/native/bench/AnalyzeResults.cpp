@@ -0,0 +1,414 @@
+/***************************************************
+Analyzer for the recorded results in test/js/results.
+
+CSV files need a "Board Time" column (the board's ms clock) and may have a
+"Time Stamp" column (the PC's ms wall clock when the sample arrived). For
+each one the tool reports the median board sample period, the jitter
+(standard deviation) of the board and PC inter-arrival times, gaps and
+missing samples, duplicate and out of order board times, and the PC minus
+board clock offset. `drift_ppm` is the slope of a least squares line through
+the offsets. `lat_*` is each sample's offset above that line, measured from
+the fastest sample, so it is the latency a sample saw beyond the best case.
+Rows whose Time Stamp is not a wall clock time (the first row of the time
+sync logs) are counted as `unsynced` and left out. CSVs without a Board Time
+column, like the MMN stimulus logs, are skipped.
+
+Every other file is read as an enduranceTest*.txt log written by
+test/js/endurance-test.js: the last running packet total, the time between
+the first and last time stamp, and the lost samples in each "err: expected
+x got y" gap.
+
+Each file is streamed once, the 75k line logs take a few milliseconds.
+`--csv` prints comma separated rows to keep as a baseline.
+
+  openbci_analyze_results [--csv] file...
+
+MIT license
+****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+
+// Anything before 2001-09-09 is not a wall clock Time Stamp
+#define OPENBCI_ANALYZE_EPOCH_MIN_MS 1000000000000LL
+// A board time step this many periods long or more is a gap
+#define OPENBCI_ANALYZE_GAP_PERIODS 1.5
+
+typedef struct {
+    std::string name;
+    uint64_t    rows;
+    uint64_t    samples;
+    uint64_t    unsynced;
+    uint64_t    gaps;
+    uint64_t    lost;
+    uint64_t    duplicates;
+    uint64_t    outOfOrder;
+    double      seconds;
+    double      periodMs;
+    double      boardJitterMs;
+    double      pcJitterMs;
+    double      offsetMs;
+    double      driftPpm;
+    double      latencyP50Ms;
+    double      latencyP99Ms;
+    double      latencyMaxMs;
+    boolean     hasTimeStamp;
+    double      wallMs;
+} CsvSummary;
+
+typedef struct {
+    std::string name;
+    uint64_t    packets;
+    uint64_t    gaps;
+    uint64_t    lost;
+    uint64_t    worst;
+    double      seconds;
+    double      wallMs;
+} EnduranceSummary;
+
+static void usage(void) {
+  printf("usage: openbci_analyze_results [--csv] file...\n");
+}
+
+static double percentile(std::vector<double> &sorted, double p) {
+  if (sorted.empty()) return 0;
+  size_t i = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+  return sorted[i];
+}
+
+static double stddev(std::vector<double> &values) {
+  if (values.size() < 2) return 0;
+  double mean = 0;
+  for (size_t i = 0; i < values.size(); i++) mean += values[i];
+  mean /= (double)values.size();
+  double sum = 0;
+  for (size_t i = 0; i < values.size(); i++) sum += (values[i] - mean) * (values[i] - mean);
+  return sqrt(sum / (double)(values.size() - 1));
+}
+
+/**
+* @description Finds the columns of a CSV header line.
+* @returns {boolean} - `true` if there is a "Board Time" column.
+*/
+static boolean findColumns(char *line, int *timeStamp, int *boardTime) {
+  *timeStamp = -1;
+  *boardTime = -1;
+  int index = 0;
+  for (char *tok = strtok(line, ",\r\n"); tok; tok = strtok(NULL, ",\r\n"), index++) {
+    if (strcmp(tok, "Time Stamp") == 0) *timeStamp = index;
+    if (strcmp(tok, "Board Time") == 0) *boardTime = index;
+  }
+  return *boardTime >= 0;
+}
+
+/**
+* @description Streams a CSV with a "Board Time" column and fills in `out`.
+* @returns {boolean} - `true` if at least two samples were read.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static boolean analyzeCsv(const char *path, CsvSummary *out) {
+  FILE *f = fopen(path, "r");
+  if (f == NULL) return false;
+
+  char line[256];
+  int timeStampColumn;
+  int boardTimeColumn;
+  if (fgets(line, sizeof(line), f) == NULL || !findColumns(line, &timeStampColumn, &boardTimeColumn)) {
+    fclose(f);
+    return false;
+  }
+  out->hasTimeStamp = timeStampColumn >= 0;
+
+  std::vector<double> boardMs;
+  std::vector<double> pcMs;
+  boardMs.reserve(1 << 17);
+  pcMs.reserve(1 << 17);
+  while (fgets(line, sizeof(line), f)) {
+    out->rows++;
+    long long timeStamp = 0;
+    long long boardTime = 0;
+    boolean haveBoard = false;
+    char *p = line;
+    for (int index = 0; *p && *p != '\n' && *p != '\r'; index++) {
+      char *end;
+      long long value = strtoll(p, &end, 10);
+      if (index == timeStampColumn) timeStamp = value;
+      if (index == boardTimeColumn) {
+        boardTime = value;
+        haveBoard = end != p;
+      }
+      p = end;
+      while (*p && *p != ',' && *p != '\n') p++;
+      if (*p == ',') p++;
+    }
+    if (!haveBoard) continue;
+    if (out->hasTimeStamp && timeStamp < OPENBCI_ANALYZE_EPOCH_MIN_MS) {
+      out->unsynced++;
+      continue;
+    }
+    boardMs.push_back((double)boardTime);
+    // Keep the offsets small so the doubles stay exact
+    pcMs.push_back(out->hasTimeStamp ? (double)(timeStamp - OPENBCI_ANALYZE_EPOCH_MIN_MS) : 0);
+  }
+  fclose(f);
+  if (boardMs.size() < 2) return false;
+
+  // Board steps, skipping the ones that go nowhere or backwards
+  std::vector<double> steps;
+  std::vector<double> pcSteps;
+  std::vector<size_t> keep;
+  keep.push_back(0);
+  for (size_t i = 1; i < boardMs.size(); i++) {
+    double step = boardMs[i] - boardMs[keep.back()];
+    if (step <= 0) {
+      if (step == 0) {
+        out->duplicates++;
+      } else {
+        out->outOfOrder++;
+      }
+      continue;
+    }
+    steps.push_back(step);
+    pcSteps.push_back(pcMs[i] - pcMs[keep.back()]);
+    keep.push_back(i);
+  }
+  out->samples = keep.size();
+  out->seconds = (boardMs[keep.back()] - boardMs[keep.front()]) / 1000.0;
+
+  std::vector<double> sorted = steps;
+  std::sort(sorted.begin(), sorted.end());
+  out->periodMs = percentile(sorted, 0.5);
+  // Jitter only over the steps that are not gaps
+  std::vector<double> regular;
+  std::vector<double> pcRegular;
+  for (size_t i = 0; i < steps.size(); i++) {
+    if (out->periodMs > 0 && steps[i] >= out->periodMs * OPENBCI_ANALYZE_GAP_PERIODS) {
+      out->gaps++;
+      out->lost += (uint64_t)(steps[i] / out->periodMs + 0.5) - 1;
+      continue;
+    }
+    regular.push_back(steps[i]);
+    pcRegular.push_back(pcSteps[i]);
+  }
+  out->boardJitterMs = stddev(regular);
+  if (!out->hasTimeStamp) return true;
+  out->pcJitterMs = stddev(pcRegular);
+
+  // Least squares line through offset against board time
+  double x0 = boardMs[keep.front()];
+  double sx = 0, sy = 0, sxx = 0, sxy = 0;
+  double n = (double)keep.size();
+  for (size_t k = 0; k < keep.size(); k++) {
+    double x = boardMs[keep[k]] - x0;
+    double y = pcMs[keep[k]] - boardMs[keep[k]];
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+  }
+  double denom = n * sxx - sx * sx;
+  double slope = denom != 0 ? (n * sxy - sx * sy) / denom : 0;
+  double intercept = (sy - slope * sx) / n;
+  out->driftPpm = slope * 1000000.0;
+
+  std::vector<double> offsets;
+  std::vector<double> residuals;
+  offsets.reserve(keep.size());
+  residuals.reserve(keep.size());
+  for (size_t k = 0; k < keep.size(); k++) {
+    double x = boardMs[keep[k]] - x0;
+    double y = pcMs[keep[k]] - boardMs[keep[k]];
+    offsets.push_back(y);
+    residuals.push_back(y - (intercept + slope * x));
+  }
+  std::sort(offsets.begin(), offsets.end());
+  out->offsetMs = percentile(offsets, 0.5) + (double)OPENBCI_ANALYZE_EPOCH_MIN_MS;
+  std::sort(residuals.begin(), residuals.end());
+  double fastest = residuals.front();
+  out->latencyP50Ms = percentile(residuals, 0.5) - fastest;
+  out->latencyP99Ms = percentile(residuals, 0.99) - fastest;
+  out->latencyMaxMs = residuals.back() - fastest;
+  return true;
+}
+
+static boolean parseTime(const char *s, double *out) {
+  int y, mo, d, h, mi, sec;
+  if (sscanf(s, "%d-%d-%d %d:%d:%d", &y, &mo, &d, &h, &mi, &sec) != 6) return false;
+  // Days since 1970-01-01, good for the span between two stamps
+  y -= mo <= 2;
+  long era = (y >= 0 ? y : y - 399) / 400;
+  long yoe = y - era * 400;
+  long doy = (153 * (mo + (mo > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  long days = era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy - 719468;
+  *out = (double)days * 86400.0 + h * 3600 + mi * 60 + sec;
+  return true;
+}
+
+/**
+* @description Streams an enduranceTest*.txt log and fills in `out`.
+* @returns {boolean} - `true` if the log had a packet total or a gap.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static boolean analyzeEndurance(const char *path, EnduranceSummary *out) {
+  FILE *f = fopen(path, "r");
+  if (f == NULL) return false;
+
+  char line[256];
+  boolean found = false;
+  boolean haveFirst = false;
+  double firstS = 0;
+  double lastS = 0;
+  while (fgets(line, sizeof(line), f)) {
+    char *s = line;
+    while (*s == ' ' || *s == '\t') s++;
+    unsigned long long total;
+    int expected;
+    int got;
+    char stamp[64];
+    double timeS;
+    if (sscanf(s, "Total Packets: %llu", &total) == 1) {
+      out->packets = total;
+      found = true;
+    } else if (strncmp(s, "Date and time: ", 15) == 0) {
+      if (parseTime(s + 15, &timeS)) {
+        if (!haveFirst) firstS = timeS;
+        haveFirst = true;
+        lastS = timeS;
+      }
+    } else if (sscanf(s, "err: expected %d got %d at %63[^\n]", &expected, &got, stamp) == 3) {
+      uint64_t missing = (uint8_t)(got - expected);
+      if (missing > 0) out->gaps++;
+      if (missing > out->worst) out->worst = missing;
+      out->lost += missing;
+      found = true;
+      if (parseTime(stamp, &timeS)) lastS = timeS > lastS ? timeS : lastS;
+    }
+  }
+  fclose(f);
+  out->seconds = lastS - firstS;
+  return found;
+}
+
+static const char *baseName(const char *path) {
+  const char *slash = strrchr(path, '/');
+  return slash ? slash + 1 : path;
+}
+
+int main(int argc, char **argv) {
+  boolean csv = false;
+  std::vector<const char *> files;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--csv") == 0) {
+      csv = true;
+    } else if (strncmp(argv[i], "--", 2) == 0) {
+      usage();
+      return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+  if (files.empty()) {
+    usage();
+    return 1;
+  }
+
+  std::vector<CsvSummary> csvs;
+  std::vector<EnduranceSummary> endurance;
+  int failures = 0;
+  for (size_t i = 0; i < files.size(); i++) {
+    const char *path = files[i];
+    size_t len = strlen(path);
+    std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+    if (len > 4 && strcmp(path + len - 4, ".csv") == 0) {
+      CsvSummary s;
+      s.name = baseName(path);
+      s.rows = s.samples = s.unsynced = s.gaps = s.lost = s.duplicates = s.outOfOrder = 0;
+      s.seconds = s.periodMs = s.boardJitterMs = s.pcJitterMs = s.offsetMs = s.driftPpm = 0;
+      s.latencyP50Ms = s.latencyP99Ms = s.latencyMaxMs = 0;
+      s.hasTimeStamp = false;
+      FILE *f = fopen(path, "r");
+      if (f == NULL) {
+        fprintf(stderr, "%s: could not open\n", path);
+        failures++;
+        continue;
+      }
+      fclose(f);
+      // The stimulus logs only have a PC time stamp
+      if (!analyzeCsv(path, &s)) {
+        fprintf(stderr, "%s: skipped, no Board Time samples\n", path);
+        continue;
+      }
+      s.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+      csvs.push_back(s);
+      continue;
+    }
+
+    EnduranceSummary e;
+    e.name = baseName(path);
+    e.packets = e.gaps = e.lost = e.worst = 0;
+    e.seconds = 0;
+    if (!analyzeEndurance(path, &e)) {
+      fprintf(stderr, "%s: not an endurance log\n", path);
+      failures++;
+      continue;
+    }
+    e.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+    endurance.push_back(e);
+  }
+
+  if (!csvs.empty()) {
+    if (csv) {
+      printf("file,samples,seconds,period_ms,jitter_ms,pc_jitter_ms,gaps,lost,dup,ooo,unsynced,offset_ms,drift_ppm,lat_p50_ms,lat_p99_ms,lat_max_ms,wall_ms\n");
+    } else {
+      printf("%-38s %7s %7s %9s %9s %9s %5s %6s %4s %4s %8s %14s %9s %10s %10s %10s %7s\n",
+        "file", "samples", "seconds", "period_ms", "jitter_ms", "pc_jit_ms", "gaps", "lost", "dup",
+        "ooo", "unsynced", "offset_ms", "drift_ppm", "lat_p50_ms", "lat_p99_ms", "lat_max_ms", "wall_ms");
+    }
+    for (size_t i = 0; i < csvs.size(); i++) {
+      CsvSummary &s = csvs[i];
+      if (csv) {
+        printf("%s,%llu,%.1f,%.3f,%.3f,%.3f,%llu,%llu,%llu,%llu,%llu,%.0f,%.1f,%.1f,%.1f,%.1f,%.2f\n",
+          s.name.c_str(), (unsigned long long)s.samples, s.seconds, s.periodMs, s.boardJitterMs,
+          s.pcJitterMs, (unsigned long long)s.gaps, (unsigned long long)s.lost,
+          (unsigned long long)s.duplicates, (unsigned long long)s.outOfOrder,
+          (unsigned long long)s.unsynced, s.offsetMs, s.driftPpm, s.latencyP50Ms, s.latencyP99Ms,
+          s.latencyMaxMs, s.wallMs);
+      } else {
+        printf("%-38s %7llu %7.1f %9.3f %9.3f %9.3f %5llu %6llu %4llu %4llu %8llu %14.0f %9.1f %10.1f %10.1f %10.1f %7.2f\n",
+          s.name.c_str(), (unsigned long long)s.samples, s.seconds, s.periodMs, s.boardJitterMs,
+          s.pcJitterMs, (unsigned long long)s.gaps, (unsigned long long)s.lost,
+          (unsigned long long)s.duplicates, (unsigned long long)s.outOfOrder,
+          (unsigned long long)s.unsynced, s.offsetMs, s.driftPpm, s.latencyP50Ms, s.latencyP99Ms,
+          s.latencyMaxMs, s.wallMs);
+      }
+    }
+  }
+
+  if (!endurance.empty()) {
+    if (!csvs.empty()) printf("\n");
+    if (csv) {
+      printf("file,seconds,packets,lost,lost_%%,gaps,worst,wall_ms\n");
+    } else {
+      printf("%-38s %8s %9s %8s %8s %6s %6s %8s\n",
+        "file", "seconds", "packets", "lost", "lost_%", "gaps", "worst", "wall_ms");
+    }
+    for (size_t i = 0; i < endurance.size(); i++) {
+      EnduranceSummary &e = endurance[i];
+      uint64_t sent = e.packets + e.lost;
+      double lostPercent = sent > 0 ? (double)e.lost * 100.0 / (double)sent : 0;
+      printf(csv ? "%s,%.0f,%llu,%llu,%.4f,%llu,%llu,%.2f\n" :
+        "%-38s %8.0f %9llu %8llu %8.4f %6llu %6llu %8.2f\n",
+        e.name.c_str(), e.seconds, (unsigned long long)e.packets, (unsigned long long)e.lost,
+        lostPercent, (unsigned long long)e.gaps, (unsigned long long)e.worst, e.wallMs);
+    }
+  }
+  return failures > 0 ? 1 : 0;
+}
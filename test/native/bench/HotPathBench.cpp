@@ -0,0 +1,264 @@
+/***************************************************
+Microbenchmarks for the per-byte and per-packet hot functions of
+OpenBCI_Radios_Class.
+
+Every function is driven in a tight loop with input shaped like the stream in
+test/js/index.js (0x41, sample number, 30 bytes of data, 0xC0) or like a
+multi packet page from the PC. The best of several runs is reported in ns per
+call, per byte and per packet, together with an estimate of the Cortex-M0
+cycles the same work costs on the RFduino. The estimate scales x86 cycles by a
+fixed M0/x86 cycles-per-operation ratio, so it is only good for spotting
+regressions, not for absolute budgets. Functions marked `isr` run inside
+`RFduinoGZLL_onReceive()` on the Host.
+
+  openbci_hot_path_bench [--iterations n] [--runs n] [--x86-ghz f]
+                         [--m0-ratio f]
+
+MIT license
+****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "OpenBCI_Radios.h"
+#include "SimNode.h"
+
+// The RFduino's nRF51822 runs its Cortex-M0 at 16MHz
+#define OPENBCI_BENCH_M0_MHZ 16.0
+// The M0 has no superscalar issue, no branch prediction and a 1 cycle
+//  multiply on the nRF51, against roughly 3 instructions per cycle on a
+//  modern x86 core for this kind of byte shuffling code.
+#define OPENBCI_BENCH_M0_RATIO 3.0
+
+typedef struct {
+    const char  *name;
+    boolean     isr;
+    int         bytesPerCall;
+    int         callsPerPacket;
+    double      nsPerCall;
+} BenchResult;
+
+static volatile uint32_t benchSink;
+
+static double nowNs(void) {
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+* @description A stream packet exactly like `deviceSample()` in test/js/index.js
+* @author AJ Keller (@pushtheworldllc)
+*/
+static void makeDeviceSample(uint8_t num, char *out) {
+  memset(out, 0, OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES);
+  out[0] = (char)OPENBCI_STREAM_PACKET_HEAD;
+  out[1] = (char)num;
+  out[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES - 1] = (char)OPENBCI_STREAM_PACKET_TAIL;
+}
+
+static void resetRadio(OpenBCI_Radios_Class &r) {
+  r.bufferRadioReset(r.bufferRadio);
+  r.currentRadioBuffer = r.bufferRadio;
+  r.currentRadioBufferNum = 0;
+  r.bufferSerialReset(OPENBCI_NUMBER_SERIAL_BUFFERS);
+  r.bufferStreamReset();
+}
+
+static double benchStreamAddChar(OpenBCI_Radios_Class &r, long iterations) {
+  char sample[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES];
+  resetRadio(r);
+  double start = nowNs();
+  for (long i = 0; i < iterations; i++) {
+    makeDeviceSample((uint8_t)i, sample);
+    for (int j = 0; j < OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES; j++) {
+      r.bufferStreamAddChar(r.streamPacketBuffer, sample[j]);
+    }
+    benchSink += r.streamPacketBuffer->state;
+    r.bufferStreamReset(r.streamPacketBuffer);
+  }
+  return (nowNs() - start) / (double)(iterations * OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES);
+}
+
+static double benchSerialAddChar(OpenBCI_Radios_Class &r, long iterations) {
+  char sample[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES];
+  resetRadio(r);
+  long calls = 0;
+  double start = nowNs();
+  for (long i = 0; i < iterations; i++) {
+    makeDeviceSample((uint8_t)i, sample);
+    for (int j = 0; j < OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES; j++) {
+      r.bufferSerialAddChar(sample[j]);
+    }
+    calls += OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES;
+    // Same clean up the Device does once the stream packet is sent
+    r.bufferSerialReset(r.bufferSerial.numberOfPacketsToSend);
+  }
+  return (nowNs() - start) / (double)calls;
+}
+
+static double benchIngestSerial(OpenBCI_Radios_Class &r, long iterations) {
+  char sample[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES];
+  resetRadio(r);
+  double start = nowNs();
+  for (long i = 0; i < iterations; i++) {
+    makeDeviceSample((uint8_t)i, sample);
+    r.ingestSerial(sample, OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES);
+    benchSink += r.streamPacketBuffer->state;
+    r.bufferStreamReset(r.streamPacketBuffer);
+    r.bufferSerialReset(r.bufferSerial.numberOfPacketsToSend);
+  }
+  return (nowNs() - start) / (double)iterations;
+}
+
+static double benchRadioProcessPacket(OpenBCI_Radios_Class &r, long iterations) {
+  // A three packet page, packet numbers count down to 0
+  const int pagePackets = 3;
+  char page[pagePackets][OPENBCI_MAX_PACKET_SIZE_BYTES];
+  for (int p = 0; p < pagePackets; p++) {
+    for (int j = 1; j < OPENBCI_MAX_PACKET_SIZE_BYTES; j++) page[p][j] = (char)('a' + j);
+    page[p][0] = r.byteIdMake(false, pagePackets - 1 - p, page[p] + 1, OPENBCI_MAX_DATA_BYTES_IN_PACKET);
+  }
+  resetRadio(r);
+  double start = nowNs();
+  for (long i = 0; i < iterations; i++) {
+    for (int p = 0; p < pagePackets; p++) {
+      benchSink += r.bufferRadioProcessPacket(page[p], OPENBCI_MAX_PACKET_SIZE_BYTES);
+    }
+    r.bufferRadioReset(r.currentRadioBuffer);
+  }
+  return (nowNs() - start) / (double)(iterations * pagePackets);
+}
+
+static double benchStreamStoreData(OpenBCI_Radios_Class &r, long iterations) {
+  char packet[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES];
+  makeDeviceSample(0, packet);
+  packet[0] = r.byteIdMake(true, 0, packet + 1, OPENBCI_MAX_DATA_BYTES_IN_PACKET);
+  resetRadio(r);
+  double start = nowNs();
+  for (long i = 0; i < iterations; i++) {
+    packet[1] = (char)i;
+    r.bufferStreamStoreData(r.streamPacketBuffer + (i % OPENBCI_NUMBER_STREAM_BUFFERS), packet);
+  }
+  benchSink += r.streamPacketBuffer->data[0];
+  return (nowNs() - start) / (double)iterations;
+}
+
+static double benchByteIdMake(OpenBCI_Radios_Class &r, long iterations) {
+  char packet[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES];
+  makeDeviceSample(0, packet);
+  uint32_t acc = 0;
+  double start = nowNs();
+  for (long i = 0; i < iterations; i++) {
+    acc += (uint8_t)r.byteIdMake((i & 1) != 0, (uint8_t)i, packet + 1, OPENBCI_MAX_DATA_BYTES_IN_PACKET);
+  }
+  benchSink += acc;
+  return (nowNs() - start) / (double)iterations;
+}
+
+static double benchRadioAddData(OpenBCI_Radios_Class &r, long iterations) {
+  char packet[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES];
+  makeDeviceSample(0, packet);
+  resetRadio(r);
+  double start = nowNs();
+  for (long i = 0; i < iterations; i++) {
+    r.bufferRadioAddData(r.bufferRadio, packet + 1, OPENBCI_MAX_DATA_BYTES_IN_PACKET, false);
+    if (r.bufferRadio->positionWrite + OPENBCI_MAX_DATA_BYTES_IN_PACKET > OPENBCI_BUFFER_LENGTH_MULTI) {
+      r.bufferRadio->positionWrite = 0;
+    }
+  }
+  benchSink += r.bufferRadio->positionWrite;
+  return (nowNs() - start) / (double)iterations;
+}
+
+/**
+* @description Reads the core clock from /proc/cpuinfo for the cycle estimate.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static double detectX86Ghz(void) {
+  FILE *f = fopen("/proc/cpuinfo", "r");
+  double mhz = 0;
+  if (f) {
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+      if (sscanf(line, "cpu MHz : %lf", &mhz) == 1) break;
+    }
+    fclose(f);
+  }
+  return mhz > 0 ? mhz / 1000.0 : 3.0;
+}
+
+int main(int argc, char **argv) {
+  long iterations = 200000;
+  int runs = 5;
+  double x86Ghz = detectX86Ghz();
+  double m0Ratio = OPENBCI_BENCH_M0_RATIO;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--iterations") == 0) {
+      iterations = atol(argv[i + 1]);
+    } else if (strcmp(argv[i], "--runs") == 0) {
+      runs = atoi(argv[i + 1]);
+    } else if (strcmp(argv[i], "--x86-ghz") == 0) {
+      x86Ghz = atof(argv[i + 1]);
+    } else if (strcmp(argv[i], "--m0-ratio") == 0) {
+      m0Ratio = atof(argv[i + 1]);
+    } else {
+      printf("usage: openbci_hot_path_bench [--iterations n] [--runs n] [--x86-ghz f] [--m0-ratio f]\n");
+      return 1;
+    }
+  }
+
+  SimNode node("bench");
+  SimNode::active = &node;
+  static OpenBCI_Radios_Class r;
+
+  BenchResult results[] = {
+    { "bufferStreamAddChar",      false, 1,  OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES, 0 },
+    { "bufferSerialAddChar",      false, 1,  OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES, 0 },
+    { "ingestSerial",             false, OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES, 1, 0 },
+    { "bufferRadioProcessPacket", true,  OPENBCI_MAX_DATA_BYTES_IN_PACKET, 1, 0 },
+    { "bufferStreamStoreData",    true,  OPENBCI_MAX_DATA_BYTES_IN_PACKET, 1, 0 },
+    { "byteIdMake",               false, 0,  1, 0 },
+    { "bufferRadioAddData",       true,  OPENBCI_MAX_DATA_BYTES_IN_PACKET, 1, 0 }
+  };
+  double (*benches[])(OpenBCI_Radios_Class &, long) = {
+    benchStreamAddChar,
+    benchSerialAddChar,
+    benchIngestSerial,
+    benchRadioProcessPacket,
+    benchStreamStoreData,
+    benchByteIdMake,
+    benchRadioAddData
+  };
+  int count = sizeof(results) / sizeof(results[0]);
+
+  for (int b = 0; b < count; b++) {
+    double best = 1e30;
+    benches[b](r, iterations / 10 + 1); // warm up
+    for (int run = 0; run < runs; run++) {
+      double ns = benches[b](r, iterations);
+      if (ns < best) best = ns;
+    }
+    results[b].nsPerCall = best;
+  }
+
+  printf("x86 %.2f GHz, M0 %.0f MHz, M0/x86 cycle ratio %.1f, %ld iterations, best of %d\n",
+    x86Ghz, OPENBCI_BENCH_M0_MHZ, m0Ratio, iterations, runs);
+  printf("%-26s %4s %10s %10s %12s %12s %10s\n",
+    "function", "isr", "ns/call", "ns/byte", "ns/packet", "m0_cyc/pkt", "m0_us/pkt");
+  for (int b = 0; b < count; b++) {
+    BenchResult *res = results + b;
+    double nsPerPacket = res->nsPerCall * res->callsPerPacket;
+    double m0Cycles = nsPerPacket * x86Ghz * m0Ratio;
+    char perByte[16] = "-";
+    if (res->bytesPerCall > 0) {
+      snprintf(perByte, sizeof(perByte), "%.2f", res->nsPerCall / res->bytesPerCall);
+    }
+    printf("%-26s %4s %10.2f %10s %12.2f %12.0f %10.2f\n",
+      res->name, res->isr ? "yes" : "", res->nsPerCall, perByte, nsPerPacket,
+      m0Cycles, m0Cycles / OPENBCI_BENCH_M0_MHZ);
+  }
+  return benchSink == 0xFFFFFFFF ? 1 : 0;
+}
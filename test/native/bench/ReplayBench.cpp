@@ -0,0 +1,138 @@
+/***************************************************
+Replays the recorded logs in test/js/results through the simulator.
+
+Each log becomes a sample schedule for the simulated PIC and a list of link
+outages, one per gap the recording saw, placed where the lost samples would
+have been on air. The current firmware then runs on that trace and the tool
+compares what it delivers with what the recording delivered: `recovered` are
+samples the recording lost but the simulation delivered, `new_lost` the other
+way round. A firmware change that handles the same trace better shows up as
+more recovered samples.
+
+  openbci_sim_replay [--rate 250] [--max-seconds n] [--seed n] log...
+
+MIT license
+****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+#include "SimWorld.h"
+#include "SimTrace.h"
+
+static void usage(void) {
+  printf("usage: openbci_sim_replay [--rate 250] [--max-seconds n] [--seed n] log...\n");
+}
+
+/**
+* @description Turns every run of lost samples into one link outage, from the
+*  moment the first lost sample's tail reaches the Device until the next
+*  delivered sample's tail does.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static void buildOutages(SimTrace &trace, uint64_t startUs, double packetUs, std::vector<SimLinkOutage> &out) {
+  uint64_t periodUs = (uint64_t)(1000000.0 / trace.rateHz);
+  size_t n = 0;
+  while (n < trace.lost.size()) {
+    if (!trace.lost[n]) {
+      n++;
+      continue;
+    }
+    size_t first = n;
+    while (n < trace.lost.size() && trace.lost[n]) n++;
+    uint64_t end = n < trace.sampleUs.size() ? trace.sampleUs[n] : trace.sampleUs[n - 1] + periodUs;
+    SimLinkOutage outage;
+    outage.startUs = startUs + trace.sampleUs[first] + (uint64_t)packetUs;
+    outage.endUs = startUs + end + (uint64_t)packetUs;
+    out.push_back(outage);
+  }
+}
+
+int main(int argc, char **argv) {
+  double rate = OPENBCI_SIM_TRACE_RATE_HZ;
+  double maxSeconds = 0;
+  SimLinkConfig linkConfig = SimLink::defaults();
+  std::vector<const char *> logs;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (strncmp(arg, "--", 2) != 0) {
+      logs.push_back(arg);
+      continue;
+    }
+    if (strcmp(arg, "--help") == 0 || i + 1 >= argc) {
+      usage();
+      return strcmp(arg, "--help") == 0 ? 0 : 1;
+    }
+    const char *val = argv[++i];
+    if (strcmp(arg, "--rate") == 0) {
+      rate = atof(val);
+    } else if (strcmp(arg, "--max-seconds") == 0) {
+      maxSeconds = atof(val);
+    } else if (strcmp(arg, "--seed") == 0) {
+      linkConfig.seed = (uint32_t)atoi(val);
+    } else {
+      usage();
+      return 1;
+    }
+  }
+  if (logs.empty() || rate <= 0) {
+    usage();
+    return 1;
+  }
+
+  printf("%-38s %8s %9s %6s %6s %9s %9s %9s %8s %9s %9s %8s %8s\n",
+    "log", "seconds", "samples", "gaps", "worst", "rec_lost", "sim_lost",
+    "recovered", "new_lost", "p50_us", "p99_us", "wall_s", "speedup");
+
+  static SimWorld world;
+  int failures = 0;
+  for (size_t l = 0; l < logs.size(); l++) {
+    SimTrace trace;
+    if (!trace.load(logs[l], rate)) {
+      printf("%-38s could not read a sample schedule\n", logs[l]);
+      failures++;
+      continue;
+    }
+    if (maxSeconds > 0) trace.trim((uint64_t)(maxSeconds * 1000000.0));
+
+    std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+    world.begin(linkConfig);
+    world.run(world.nowUs() + OPENBCI_SIM_STREAM_START_uS);
+    world.stream(trace.rateHz, trace.durationUs());
+    world.pic.scheduleUs = trace.sampleUs;
+    double packetUs = world.device.serial.byteTimeUs() * OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES;
+    buildOutages(trace, world.pic.startUs, packetUs, world.link.outages);
+    world.run(world.pic.stopUs + OPENBCI_SIM_DRAIN_uS);
+    SimResults r = world.results();
+    double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    uint64_t recordedLost = trace.samplesLost();
+    uint64_t simLost = 0;
+    uint64_t recovered = 0;
+    uint64_t newLost = 0;
+    for (size_t n = 0; n < trace.lost.size(); n++) {
+      boolean delivered = n < world.driver.deliveredUs.size() &&
+        world.driver.deliveredUs[n] != OPENBCI_SIM_SAMPLE_NOT_SENT;
+      if (!delivered) simLost++;
+      if (trace.lost[n] && delivered) recovered++;
+      if (!trace.lost[n] && !delivered) newLost++;
+    }
+    double seconds = (double)trace.durationUs() / 1000000.0;
+    printf("%-38s %8.1f %9llu %6llu %6llu %9llu %9llu %9llu %8llu %9llu %9llu %8.2f %7.0fx\n",
+      trace.name.c_str(), seconds, (unsigned long long)trace.sampleUs.size(),
+      (unsigned long long)trace.gaps, (unsigned long long)trace.longestGap,
+      (unsigned long long)recordedLost, (unsigned long long)simLost,
+      (unsigned long long)recovered, (unsigned long long)newLost,
+      (unsigned long long)r.latencyP50Us, (unsigned long long)r.latencyP99Us,
+      wallS, wallS > 0 ? seconds / wallS : 0);
+    if (trace.duplicates > 0 || trace.outOfOrder > 0) {
+      printf("%-38s recording also had %llu duplicate and %llu out of order samples\n", "",
+        (unsigned long long)trace.duplicates, (unsigned long long)trace.outOfOrder);
+    }
+  }
+  return failures > 0 ? 1 : 0;
+}
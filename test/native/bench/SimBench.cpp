@@ -0,0 +1,276 @@
+/***************************************************
+Throughput and latency benchmark for the OpenBCI radio link.
+
+Streams 33 byte packets from a simulated PIC through the Device and Host
+sketches over the simulated Gazell link and reports, per sample rate, the
+delivered samples per second, the drop rate and the sample-to-serial latency
+(tail byte into the Device UART until tail byte out of the Host UART).
+`host_cpu_%` comes from the Host's own perf counters, read with the
+OPENBCI_HOST_CMD_PERF_GET command after the run, and is `-` when they are
+compiled out. The simulator charges firmware code no time, so here it only
+shows the Host blocked on a full UART. `dev_ring` and `host_ring` are the
+stream packets each radio's ring dropped when full (`streamDrops`), under the
+`streamOverflowPolicy` set with `--overflow`.
+
+After the table come the per stage latency histograms the firmware keeps
+(OPENBCI_HOST_CMD_LATENCY_GET), one row per rate and stage: Device ingest,
+Device queue, air, Host ring and Host serial.
+
+  openbci_sim_bench [--rates 250,500,1000] [--seconds 10] [--loss p]
+                    [--burst-enter p] [--burst-exit p] [--burst-loss p]
+                    [--ack-loss p] [--latency-us n] [--jitter-us n]
+                    [--attempt-us n] [--seed n]
+                    [--baud n] [--overflow 0|1|2] [--send-burst 0|1]
+                    [--loop-us n] [--sequence 0|1] [--duplicates 0|1]
+                    [--parity n] [--max-attempts n] [--retransmit 0|1]
+                    [--delta 0|1] [--output 0|1] [--pc-baud n]
+
+`--baud` runs both UARTs, the Pic's and the PC's, at
+another rate, with the Device's timeouts scaled by `timeoutsSetBaudRate` as
+after an OPENBCI_HOST_CMD_BAUD_DEVICE_SET.
+`--send-burst 0` has the Device put one stream packet on its TX FIFO per loop
+pass instead of filling it, which only costs anything when a Device `loop()`
+pass, `--loop-us`, takes longer than an attempt on air. `--sequence 1` numbers
+the Device's stream packets, `dups` then counts the repeats that still got to
+the PC and `gap_missed` the packets the Host's gap markers stood in for.
+`--duplicates 1` has the Host see a Gazell retry whose ACK was lost.
+`--parity n` sends a parity frame after every n stream packets, on both radios,
+and `fec_fix` counts the packets the Host rebuilt from them. `--max-attempts`
+lowers how many tries Gazell gets, which turns `--loss` into lost packets.
+`--retransmit 1` has the Host ask the Device for lost packets again, `resent`
+counts the ones that made it in time. `--delta 1` has the Device pack queued
+samples as deltas, `packed` counts the samples the Host wrote out from packed
+frames. `--output 1` puts the Host in OPENBCI_OUTPUT_MODE_THROUGHPUT, and
+`pc_writes` counts its `Serial.write` calls to the PC. `pc_drops` are the
+stream packets and pages the Host threw away because the PC's UART had no
+room for them (`outputDrops`). `--pc-baud` runs only the Host's UART to the
+PC at another rate, a PC that reads slower than the radio delivers.
+
+MIT license
+****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "OpenBCI_Radios.h"
+#include "SimWorld.h"
+
+/**
+* @description Asks the Host for its perf counters and picks the CPU use out
+*  of the reply.
+* @returns {double} - Percent of the window the Host was busy, or -1 if the
+*  reply did not come or the counters are compiled out.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static double hostCpuPercent(SimWorld &world) {
+  const char cmd[] = { (char)OPENBCI_HOST_PRIVATE_CMD_KEY, (char)OPENBCI_HOST_CMD_PERF_GET };
+  size_t from = world.driver.text.size();
+  world.pcWrite(cmd, sizeof(cmd));
+  world.run(world.nowUs() + OPENBCI_SIM_DRAIN_uS);
+  size_t at = world.driver.text.find("util:", from);
+  if (at == std::string::npos) return -1;
+  return atof(world.driver.text.c_str() + at + 5) * 100.0 / OPENBCI_PERF_PERMILLE;
+}
+
+/**
+* @description Asks the Host for the latency histograms, which gets the
+*  Device's too, and turns each stage into one table row.
+* @param `rows` {std::vector<std::string>} - Gets one row per stage found.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static void latencyRows(SimWorld &world, double rate, std::vector<std::string> &rows) {
+  static const char *stages[] = { "ingest", "queue", "air", "ring", "serial" };
+  const char cmd[] = { (char)OPENBCI_HOST_PRIVATE_CMD_KEY, (char)OPENBCI_HOST_CMD_LATENCY_GET };
+  size_t from = world.driver.text.size();
+  world.pcWrite(cmd, sizeof(cmd));
+  world.run(world.nowUs() + OPENBCI_SIM_DRAIN_uS);
+  for (size_t i = 0; i < sizeof(stages) / sizeof(stages[0]); i++) {
+    std::string key = std::string(" ") + stages[i] + ":";
+    size_t at = world.driver.text.find(key, from);
+    if (at == std::string::npos) continue;
+    char row[256];
+    int len = snprintf(row, sizeof(row), "%8.0f %8s", rate, stages[i]);
+    const char *p = world.driver.text.c_str() + at + key.size();
+    for (int b = 0; b < OPENBCI_LATENCY_BUCKETS; b++) {
+      char *end;
+      unsigned long count = strtoul(p, &end, 10);
+      len += snprintf(row + len, sizeof(row) - len, " %8lu", count);
+      p = *end == ',' ? end + 1 : end;
+    }
+    rows.push_back(row);
+  }
+}
+
+static void usage(void) {
+  printf("usage: openbci_sim_bench [--rates 250,500,1000] [--seconds 10] [--loss p]\n");
+  printf("         [--burst-enter p] [--burst-exit p] [--burst-loss p] [--ack-loss p]\n");
+  printf("         [--latency-us n] [--jitter-us n] [--attempt-us n] [--seed n]\n");
+  printf("         [--baud n] [--overflow 0|1|2] [--send-burst 0|1]\n");
+  printf("         [--loop-us n] [--sequence 0|1] [--duplicates 0|1] [--parity n]\n");
+  printf("         [--max-attempts n] [--retransmit 0|1] [--delta 0|1] [--output 0|1]\n");
+  printf("         [--pc-baud n]\n");
+}
+
+int main(int argc, char **argv) {
+  std::vector<double> rates;
+  double seconds = 10;
+  uint32_t baud = OPENBCI_BAUD_RATE_DEFAULT;
+  uint32_t pcBaud = 0;
+  uint8_t overflow = OPENBCI_STREAM_OVERFLOW_POLICY;
+  boolean sendBurst = OPENBCI_STREAM_SEND_BURST;
+  uint32_t loopUs = OPENBCI_SIM_LOOP_COST_uS;
+  boolean sequence = OPENBCI_STREAM_SEQUENCE;
+  uint8_t parity = OPENBCI_STREAM_PARITY_GROUP;
+  boolean retransmit = OPENBCI_STREAM_RETRANSMIT;
+  boolean delta = OPENBCI_STREAM_DELTA;
+  uint8_t output = OPENBCI_OUTPUT_MODE;
+  SimLinkConfig link = SimLink::defaults();
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+    if (strcmp(arg, "--help") == 0 || val == NULL) {
+      usage();
+      return strcmp(arg, "--help") == 0 ? 0 : 1;
+    }
+    i++;
+    if (strcmp(arg, "--rates") == 0) {
+      char *copy = strdup(val);
+      for (char *tok = strtok(copy, ","); tok; tok = strtok(NULL, ",")) {
+        rates.push_back(atof(tok));
+      }
+      free(copy);
+    } else if (strcmp(arg, "--seconds") == 0) {
+      seconds = atof(val);
+    } else if (strcmp(arg, "--loss") == 0) {
+      link.lossProbability = atof(val);
+    } else if (strcmp(arg, "--burst-enter") == 0) {
+      link.burstEnterProbability = atof(val);
+    } else if (strcmp(arg, "--burst-exit") == 0) {
+      link.burstExitProbability = atof(val);
+    } else if (strcmp(arg, "--burst-loss") == 0) {
+      link.burstLossProbability = atof(val);
+    } else if (strcmp(arg, "--ack-loss") == 0) {
+      link.ackLossProbability = atof(val);
+    } else if (strcmp(arg, "--latency-us") == 0) {
+      link.latencyUs = (uint32_t)atoi(val);
+    } else if (strcmp(arg, "--jitter-us") == 0) {
+      link.attemptJitterUs = (uint32_t)atoi(val);
+    } else if (strcmp(arg, "--attempt-us") == 0) {
+      link.attemptUs = (uint32_t)atoi(val);
+    } else if (strcmp(arg, "--seed") == 0) {
+      link.seed = (uint32_t)atoi(val);
+    } else if (strcmp(arg, "--baud") == 0) {
+      baud = (uint32_t)atoi(val);
+    } else if (strcmp(arg, "--pc-baud") == 0) {
+      pcBaud = (uint32_t)atoi(val);
+    } else if (strcmp(arg, "--overflow") == 0) {
+      overflow = (uint8_t)atoi(val);
+    } else if (strcmp(arg, "--send-burst") == 0) {
+      sendBurst = atoi(val) != 0;
+    } else if (strcmp(arg, "--loop-us") == 0) {
+      loopUs = (uint32_t)atoi(val);
+    } else if (strcmp(arg, "--sequence") == 0) {
+      sequence = atoi(val) != 0;
+    } else if (strcmp(arg, "--duplicates") == 0) {
+      link.deliverDuplicates = atoi(val) != 0;
+    } else if (strcmp(arg, "--max-attempts") == 0) {
+      link.maxAttempts = (uint32_t)atoi(val);
+    } else if (strcmp(arg, "--retransmit") == 0) {
+      retransmit = atoi(val) != 0;
+    } else if (strcmp(arg, "--delta") == 0) {
+      delta = atoi(val) != 0;
+    } else if (strcmp(arg, "--output") == 0) {
+      output = (uint8_t)atoi(val);
+    } else if (strcmp(arg, "--parity") == 0) {
+      parity = (uint8_t)atoi(val);
+    } else {
+      usage();
+      return 1;
+    }
+  }
+  if (rates.empty()) {
+    rates.push_back(250);
+    rates.push_back(500);
+    rates.push_back(1000);
+  }
+
+  printf("baud %u loss %.4f burst %.4f/%.4f/%.2f ack-loss %.4f attempt %uus latency %uus jitter %uus, %.1fs per rate\n",
+    baud, link.lossProbability, link.burstEnterProbability, link.burstExitProbability,
+    link.burstLossProbability, link.ackLossProbability, link.attemptUs, link.latencyUs,
+    link.attemptJitterUs, seconds);
+  printf("%8s %10s %10s %10s %12s %9s %9s %9s %9s %11s %9s %9s %9s %10s %9s %9s %9s %10s %9s\n",
+    "rate_hz", "generated", "pic_drop", "delivered", "samples/s", "drop_%", "p50_us", "p99_us", "max_us",
+    "host_cpu_%", "dev_ring", "host_ring", "dups", "gap_missed", "fec_fix", "resent", "packed", "pc_writes", "pc_drops");
+
+  SimWorld world;
+  std::vector<std::string> stageRows;
+  for (size_t i = 0; i < rates.size(); i++) {
+    world.begin(link);
+    world.device.serial.baud = baud;
+    world.host.serial.baud = pcBaud ? pcBaud : baud;
+    world.host.sketch.radio->outputBaud = world.host.serial.baud;
+    world.device.sketch.radio->timeoutsSetBaudRate(baud);
+    world.device.sketch.radio->streamOverflowPolicy = overflow;
+    world.host.sketch.radio->streamOverflowPolicy = overflow;
+    world.device.sketch.radio->streamSendBurst = sendBurst;
+    world.device.loopCostUs = loopUs;
+    world.device.sketch.radio->streamSequence = sequence;
+    world.device.sketch.radio->bufferStreamParitySet(parity);
+    world.host.sketch.radio->bufferStreamParitySet(parity);
+    world.device.sketch.radio->bufferStreamRetransmitSet(retransmit);
+    world.host.sketch.radio->bufferStreamRetransmitSet(retransmit);
+    world.device.sketch.radio->bufferStreamDeltaSet(delta);
+    world.host.sketch.radio->bufferStreamDeltaSet(delta);
+    world.host.sketch.radio->outputMode = output;
+    world.runStream(rates[i], (uint64_t)(seconds * 1000000.0));
+    SimResults r = world.results();
+    double cpu = hostCpuPercent(world);
+    char cpuText[16];
+    if (cpu < 0) {
+      snprintf(cpuText, sizeof(cpuText), "-");
+    } else {
+      snprintf(cpuText, sizeof(cpuText), "%.1f", cpu);
+    }
+    printf("%8.0f %10llu %10llu %10llu %12.1f %9.3f %9llu %9llu %9llu %11s %9lu %9lu %9llu %10llu %9lu %9lu %9lu %10llu %9lu\n",
+      rates[i],
+      (unsigned long long)r.samplesGenerated,
+      (unsigned long long)r.samplesPicDropped,
+      (unsigned long long)r.samplesDelivered,
+      r.deliveredPerSecond,
+      r.dropRate * 100.0,
+      (unsigned long long)r.latencyP50Us,
+      (unsigned long long)r.latencyP99Us,
+      (unsigned long long)r.latencyMaxUs,
+      cpuText,
+      (unsigned long)world.device.sketch.radio->streamDrops,
+      (unsigned long)world.host.sketch.radio->streamDrops,
+      (unsigned long long)r.duplicates,
+      (unsigned long long)r.gapMissed,
+      (unsigned long)world.host.sketch.radio->streamParityRecovered,
+      (unsigned long)world.host.sketch.radio->streamRetransmitRecovered,
+      (unsigned long)world.host.sketch.radio->streamDeltaSamples,
+      (unsigned long long)world.host.serial.writeCalls,
+      (unsigned long)world.host.sketch.radio->outputDrops);
+    latencyRows(world, rates[i], stageRows);
+  }
+
+  if (!stageRows.empty()) {
+    printf("\n%8s %8s", "rate_hz", "stage");
+    for (int b = 0; b < OPENBCI_LATENCY_BUCKETS - 1; b++) {
+      char label[16];
+      snprintf(label, sizeof(label), "<%luus", (unsigned long)OPENBCI_LATENCY_BUCKET_MIN_uS << b);
+      printf(" %8s", label);
+    }
+    char label[16];
+    snprintf(label, sizeof(label), ">=%luus", (unsigned long)OPENBCI_LATENCY_BUCKET_MIN_uS << (OPENBCI_LATENCY_BUCKETS - 2));
+    printf(" %8s\n", label);
+    for (size_t i = 0; i < stageRows.size(); i++) {
+      printf("%s\n", stageRows[i].c_str());
+    }
+  }
+  return 0;
+}
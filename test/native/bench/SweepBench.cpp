@@ -0,0 +1,214 @@
+/***************************************************
+Design-space sweep for the stream ring depth, the serial and stream packet
+timeouts and the poll time.
+
+Every combination of the grids runs through the simulator once per scenario
+(sample rate, link loss and UART baud rate). The runtime copies of the
+defines (`numberOfStreamBuffers`, `timeoutPacketNormalUs`,
+`timeoutPacketStreamUs` and `pollTime`) are set on both radios right after
+`setup()`, so one build covers the whole grid. The baud rate is forced on
+both UARTs, the PIC's and the PC's.
+
+For each scenario the tool prints the Pareto front over delivered samples per
+second (higher is better), drop rate, p99 latency and ring RAM (lower is
+better). `ring_ram` is the bytes both radios spend on stream packet buffers
+at that depth, in this build's layout. `--all` prints the dominated
+configurations too.
+
+  openbci_sim_sweep [--rates 250] [--losses 0,0.02,0.1] [--bauds 115200]
+                    [--depths 5,10,25] [--stream-us 44,88,176]
+                    [--normal-us 250,500,1000] [--poll-ms 24,48,96]
+                    [--seconds 5] [--seed n] [--all]
+
+MIT license
+****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "OpenBCI_Radios.h"
+#include "SimWorld.h"
+
+typedef struct {
+    uint32_t    depth;
+    uint32_t    streamUs;
+    uint32_t    normalUs;
+    uint32_t    pollMs;
+    double      samplesPerSecond;
+    double      dropRate;
+    uint64_t    p50Us;
+    uint64_t    p99Us;
+    uint64_t    ramBytes;
+    boolean     pareto;
+} SweepPoint;
+
+static void usage(void) {
+  printf("usage: openbci_sim_sweep [--rates 250] [--losses 0,0.02,0.1] [--bauds 115200]\n");
+  printf("         [--depths 5,10,25] [--stream-us 44,88,176] [--normal-us 250,500,1000]\n");
+  printf("         [--poll-ms 24,48,96] [--seconds 5] [--seed n] [--all]\n");
+}
+
+static void parseList(const char *val, std::vector<double> &out) {
+  out.clear();
+  char *copy = strdup(val);
+  for (char *tok = strtok(copy, ","); tok; tok = strtok(NULL, ",")) {
+    out.push_back(atof(tok));
+  }
+  free(copy);
+}
+
+/**
+* @description Sets one grid point on a radio that has been through `setup()`.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static void configure(OpenBCI_Radios_Class *radio, SweepPoint &p) {
+  radio->numberOfStreamBuffers = (uint8_t)p.depth;
+  radio->timeoutPacketStreamUs = p.streamUs;
+  radio->timeoutPacketNormalUs = p.normalUs;
+  radio->pollTime = p.pollMs;
+}
+
+/**
+* @description `a` dominates `b` when it is no worse on every measure and
+*  better on at least one.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static boolean dominates(SweepPoint &a, SweepPoint &b) {
+  if (a.samplesPerSecond < b.samplesPerSecond || a.dropRate > b.dropRate ||
+      a.p99Us > b.p99Us || a.ramBytes > b.ramBytes) {
+    return false;
+  }
+  return a.samplesPerSecond > b.samplesPerSecond || a.dropRate < b.dropRate ||
+    a.p99Us < b.p99Us || a.ramBytes < b.ramBytes;
+}
+
+int main(int argc, char **argv) {
+  std::vector<double> rates(1, 250);
+  std::vector<double> losses;
+  std::vector<double> bauds(1, OPENBCI_BAUD_RATE_DEFAULT);
+  std::vector<double> depths;
+  std::vector<double> streamUs;
+  std::vector<double> normalUs;
+  std::vector<double> pollMs;
+  parseList("0,0.02,0.1", losses);
+  parseList("5,10,25", depths);
+  parseList("44,88,176", streamUs);
+  parseList("250,500,1000", normalUs);
+  parseList("24,48,96", pollMs);
+  double seconds = 5;
+  boolean all = false;
+  SimLinkConfig link = SimLink::defaults();
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (strcmp(arg, "--all") == 0) {
+      all = true;
+      continue;
+    }
+    const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+    if (strcmp(arg, "--help") == 0 || val == NULL) {
+      usage();
+      return strcmp(arg, "--help") == 0 ? 0 : 1;
+    }
+    i++;
+    if (strcmp(arg, "--rates") == 0) {
+      parseList(val, rates);
+    } else if (strcmp(arg, "--losses") == 0) {
+      parseList(val, losses);
+    } else if (strcmp(arg, "--bauds") == 0) {
+      parseList(val, bauds);
+    } else if (strcmp(arg, "--depths") == 0) {
+      parseList(val, depths);
+    } else if (strcmp(arg, "--stream-us") == 0) {
+      parseList(val, streamUs);
+    } else if (strcmp(arg, "--normal-us") == 0) {
+      parseList(val, normalUs);
+    } else if (strcmp(arg, "--poll-ms") == 0) {
+      parseList(val, pollMs);
+    } else if (strcmp(arg, "--seconds") == 0) {
+      seconds = atof(val);
+    } else if (strcmp(arg, "--seed") == 0) {
+      link.seed = (uint32_t)atoi(val);
+    } else {
+      usage();
+      return 1;
+    }
+  }
+  for (size_t i = 0; i < depths.size(); i++) {
+    if (depths[i] < 2 || depths[i] > OPENBCI_NUMBER_STREAM_BUFFERS) {
+      printf("depths must be from 2 to %d, raise OPENBCI_NUMBER_STREAM_BUFFERS for more\n",
+        OPENBCI_NUMBER_STREAM_BUFFERS);
+      return 1;
+    }
+  }
+
+  // Both radios keep a ring
+  uint64_t slotBytes = 2 * sizeof(OpenBCI_Radios_Class::StreamPacketBuffer);
+
+  static SimWorld world;
+  for (size_t r = 0; r < rates.size(); r++) {
+    for (size_t l = 0; l < losses.size(); l++) {
+      for (size_t b = 0; b < bauds.size(); b++) {
+        std::vector<SweepPoint> points;
+        link.lossProbability = losses[l];
+        for (size_t d = 0; d < depths.size(); d++) {
+          for (size_t s = 0; s < streamUs.size(); s++) {
+            for (size_t n = 0; n < normalUs.size(); n++) {
+              for (size_t p = 0; p < pollMs.size(); p++) {
+                SweepPoint point;
+                memset(&point, 0, sizeof(point));
+                point.depth = (uint32_t)depths[d];
+                point.streamUs = (uint32_t)streamUs[s];
+                point.normalUs = (uint32_t)normalUs[n];
+                point.pollMs = (uint32_t)pollMs[p];
+
+                world.begin(link);
+                world.host.serial.baud = (uint32_t)bauds[b];
+                world.device.serial.baud = (uint32_t)bauds[b];
+                configure(world.host.sketch.radio, point);
+                configure(world.device.sketch.radio, point);
+                world.runStream(rates[r], (uint64_t)(seconds * 1000000.0));
+                SimResults res = world.results();
+
+                point.samplesPerSecond = res.deliveredPerSecond;
+                point.dropRate = res.dropRate;
+                point.p50Us = res.latencyP50Us;
+                point.p99Us = res.latencyP99Us;
+                point.ramBytes = slotBytes * point.depth;
+                points.push_back(point);
+              }
+            }
+          }
+        }
+
+        for (size_t i = 0; i < points.size(); i++) {
+          points[i].pareto = true;
+          for (size_t j = 0; j < points.size() && points[i].pareto; j++) {
+            if (j != i && dominates(points[j], points[i])) points[i].pareto = false;
+          }
+        }
+
+        printf("\nrate %.0fHz loss %.4f baud %.0f, %.1fs per run, %u runs\n",
+          rates[r], losses[l], bauds[b], seconds, (unsigned)points.size());
+        printf("%6s %10s %10s %8s %12s %9s %9s %9s %9s %7s\n",
+          "depth", "stream_us", "normal_us", "poll_ms", "samples/s", "drop_%",
+          "p50_us", "p99_us", "ring_ram", "pareto");
+        // Cheapest first
+        for (uint32_t d = 0; d <= OPENBCI_NUMBER_STREAM_BUFFERS; d++) {
+          for (size_t i = 0; i < points.size(); i++) {
+            SweepPoint &pt = points[i];
+            if (pt.depth != d || (!pt.pareto && !all)) continue;
+            printf("%6u %10u %10u %8u %12.1f %9.3f %9llu %9llu %9llu %7s\n",
+              pt.depth, pt.streamUs, pt.normalUs, pt.pollMs, pt.samplesPerSecond,
+              pt.dropRate * 100.0, (unsigned long long)pt.p50Us,
+              (unsigned long long)pt.p99Us, (unsigned long long)pt.ramBytes,
+              pt.pareto ? "*" : "");
+          }
+        }
+      }
+    }
+  }
+  return 0;
+}
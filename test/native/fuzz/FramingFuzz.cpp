@@ -0,0 +1,494 @@
+/***************************************************
+Coverage guided fuzzer for the framing state machines.
+
+Runs byte sequences through a simulated Host/Device pair and searches for the
+ones that keep the pipeline from committing for longest, that lose the most
+bytes, or that make a radio refuse the most pages with
+`ORPM_PACKET_PAGE_REJECT`. The firmware (OpenBCI_Radios.cpp and the example
+sketches) is built with `-fsanitize-coverage=trace-pc`. An input is kept when
+it reaches a new edge in the firmware or beats the worst value seen so far
+for any of the three measures.
+
+An input is laid out as:
+
+  [0]   bit 0: 0 = PIC -> Device -> Host -> PC, 1 = PC -> Host -> Device -> PIC
+  [1]   radio attempt loss, in 1/1024
+  [2]   ACK loss, in 1/1024
+  [3]   bit 0: the Host sees retries after a lost ACK
+  [4..] (gap, byte) pairs, the gap is idle time on the UART before the byte
+        in steps of `OPENBCI_FUZZ_GAP_STEP_uS`
+
+The worst inputs for each measure are written to the corpus directory, and
+`--replay` runs saved inputs again so they can serve as regression
+benchmarks (see test/native/fuzz/corpus).
+
+  openbci_framing_fuzz [--runs n] [--seconds s] [--seed n] [--corpus dir]
+  openbci_framing_fuzz --replay file...
+
+MIT license
+****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "OpenBCI_Radios.h"
+#include "SimWorld.h"
+
+#define OPENBCI_FUZZ_HEADER_BYTES 4
+#define OPENBCI_FUZZ_MAX_RECORDS 256
+#define OPENBCI_FUZZ_GAP_STEP_uS 16
+// Idle check granularity and how long to wait for the pipeline to settle
+#define OPENBCI_FUZZ_SETTLE_STEP_uS 1000
+#define OPENBCI_FUZZ_SETTLE_MAX_uS 500000
+#define OPENBCI_FUZZ_MAP_SIZE 65536
+#define OPENBCI_FUZZ_KEEP_WORST 3
+
+/********************************************/
+/********************************************/
+/**********    COVERAGE CODE    *************/
+/********************************************/
+/********************************************/
+
+static uint8_t fuzzEdges[OPENBCI_FUZZ_MAP_SIZE];
+static uint8_t fuzzSeen[OPENBCI_FUZZ_MAP_SIZE];
+static uintptr_t fuzzPrevPc;
+
+// Called by every basic block of the instrumented firmware
+extern "C" void __sanitizer_cov_trace_pc(void) {
+  uintptr_t pc = (uintptr_t)__builtin_return_address(0);
+  fuzzEdges[(pc ^ fuzzPrevPc) & (OPENBCI_FUZZ_MAP_SIZE - 1)] = 1;
+  fuzzPrevPc = pc >> 1;
+}
+
+/**
+* @description Folds this run's edges into the ones seen so far.
+* @returns {int} - The number of edges never seen before.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static int fuzzMergeEdges(void) {
+  int fresh = 0;
+  for (int i = 0; i < OPENBCI_FUZZ_MAP_SIZE; i++) {
+    if (fuzzEdges[i] && !fuzzSeen[i]) {
+      fuzzSeen[i] = 1;
+      fresh++;
+    }
+  }
+  return fresh;
+}
+
+/********************************************/
+/********************************************/
+/*************    RUN CODE    ***************/
+/********************************************/
+/********************************************/
+
+typedef std::vector<uint8_t> FuzzInput;
+
+typedef enum {
+  FUZZ_MEASURE_COMMIT,
+  FUZZ_MEASURE_DROPPED,
+  FUZZ_MEASURE_REJECTS,
+  FUZZ_MEASURE_COUNT
+} FUZZ_MEASURE;
+
+static const char *fuzzMeasureNames[FUZZ_MEASURE_COUNT] = { "commit", "dropped", "reject" };
+
+typedef struct {
+    uint64_t    value[FUZZ_MEASURE_COUNT];
+    uint64_t    bytesIn;
+    uint64_t    bytesOut;
+    uint64_t    packetsMissed;
+    boolean     settled;
+} FuzzResult;
+
+static SimWorld world;
+
+/**
+* @description Nothing is left in a radio's serial, stream or radio buffers.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static boolean fuzzRadioIdle(OpenBCI_Radios_Class *r) {
+  if (r->bufferSerialHasData()) return false;
+  if (r->streamPacketBufferHead != r->streamPacketBufferTail) return false;
+  if ((r->streamPacketBuffer + r->streamPacketBufferHead)->state != r->STREAM_STATE_INIT) return false;
+  for (int i = 0; i < OPENBCI_NUMBER_RADIO_BUFFERS; i++) {
+    if (r->bufferRadioHasData(r->bufferRadio + i)) return false;
+  }
+  return true;
+}
+
+/**
+* @description Both radios are idle, nothing is waiting for air time and the
+*  far UART has put out its last byte.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static boolean fuzzPipelineIdle(boolean downstream) {
+  if (!world.host.txFifo.empty() || !world.device.txFifo.empty()) return false;
+  SimNode *far = downstream ? &world.device : &world.host;
+  if (far->serial.txBusyUntilUs > (double)far->nowUs) return false;
+  return fuzzRadioIdle(world.host.sketch.radio) && fuzzRadioIdle(world.device.sketch.radio);
+}
+
+/**
+* @description Runs one input from power on until the pipeline settles.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static FuzzResult fuzzRun(const FuzzInput &input) {
+  FuzzResult result;
+  memset(&result, 0, sizeof(result));
+  memset(fuzzEdges, 0, sizeof(fuzzEdges));
+  fuzzPrevPc = 0;
+
+  uint8_t header[OPENBCI_FUZZ_HEADER_BYTES] = {0, 0, 0, 0};
+  for (size_t i = 0; i < OPENBCI_FUZZ_HEADER_BYTES && i < input.size(); i++) header[i] = input[i];
+  boolean downstream = (header[0] & 0x01) != 0;
+
+  SimLinkConfig config = SimLink::defaults();
+  config.lossProbability = (double)header[1] / 1024.0;
+  config.ackLossProbability = (double)header[2] / 1024.0;
+  config.deliverDuplicates = (header[3] & 0x01) != 0;
+  world.begin(config);
+  world.run(world.nowUs() + OPENBCI_SIM_STREAM_START_uS);
+
+  SimNode *near = downstream ? &world.host : &world.device;
+  double byteTime = near->serial.byteTimeUs();
+  double t = (double)near->nowUs;
+  for (size_t i = OPENBCI_FUZZ_HEADER_BYTES; i + 1 < input.size(); i += 2) {
+    t += (double)input[i] * OPENBCI_FUZZ_GAP_STEP_uS + byteTime;
+    near->serial.push((uint64_t)t, input[i + 1]);
+    result.bytesIn++;
+  }
+  uint64_t lastByteUs = (uint64_t)t;
+
+  world.run(lastByteUs);
+  uint64_t settleUs = lastByteUs;
+  while (settleUs < lastByteUs + OPENBCI_FUZZ_SETTLE_MAX_uS) {
+    if (fuzzPipelineIdle(downstream)) {
+      result.settled = true;
+      break;
+    }
+    settleUs += OPENBCI_FUZZ_SETTLE_STEP_uS;
+    world.run(settleUs);
+  }
+
+  result.bytesOut = downstream ? world.device.serial.bytesWritten : world.driver.bytesReceived;
+  result.value[FUZZ_MEASURE_COMMIT] = settleUs - lastByteUs;
+  result.value[FUZZ_MEASURE_DROPPED] = result.bytesIn > result.bytesOut ? result.bytesIn - result.bytesOut : 0;
+  result.value[FUZZ_MEASURE_REJECTS] = world.link.stats.pageRejects;
+  result.packetsMissed = world.link.stats.packetsMissed;
+  return result;
+}
+
+/********************************************/
+/********************************************/
+/**********    MUTATION CODE    *************/
+/********************************************/
+/********************************************/
+
+static std::mt19937 fuzzRng;
+
+static uint32_t fuzzRand(uint32_t n) {
+  return n == 0 ? 0 : std::uniform_int_distribution<uint32_t>(0, n - 1)(fuzzRng);
+}
+
+static size_t fuzzRecords(const FuzzInput &in) {
+  return in.size() > OPENBCI_FUZZ_HEADER_BYTES ? (in.size() - OPENBCI_FUZZ_HEADER_BYTES) / 2 : 0;
+}
+
+static void fuzzAppendPacket(FuzzInput &out, uint8_t sampleNumber, uint8_t stopByte) {
+  for (int i = 0; i < OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES; i++) {
+    uint8_t b = 0;
+    if (i == 0) b = OPENBCI_STREAM_PACKET_HEAD;
+    if (i == 1) b = sampleNumber;
+    if (i == OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES - 1) b = stopByte;
+    out.push_back(0);
+    out.push_back(b);
+  }
+}
+
+/**
+* @description Bytes the framing code treats specially.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static uint8_t fuzzInterestingByte(void) {
+  switch (fuzzRand(8)) {
+    case 0: return OPENBCI_STREAM_PACKET_HEAD;
+    case 1: return (uint8_t)(OPENBCI_STREAM_PACKET_TAIL | fuzzRand(16));
+    case 2: return OPENBCI_HOST_PRIVATE_CMD_KEY;
+    case 3: return (uint8_t)fuzzRand(0x10);
+    case 4: return 0xA0;
+    case 5: return 0xFF;
+    case 6: return '$';
+    default: return (uint8_t)fuzzRand(256);
+  }
+}
+
+static void fuzzMutateOnce(FuzzInput &in, const std::vector<FuzzInput> &corpus) {
+  while (in.size() < OPENBCI_FUZZ_HEADER_BYTES) in.push_back(0);
+  size_t records = fuzzRecords(in);
+  size_t r = fuzzRand((uint32_t)records);
+  size_t pos = OPENBCI_FUZZ_HEADER_BYTES + 2 * r;
+
+  switch (fuzzRand(9)) {
+    case 0: // Flip a bit anywhere
+      in[fuzzRand((uint32_t)in.size())] ^= (uint8_t)(1 << fuzzRand(8));
+      break;
+    case 1: // Interesting data byte
+      if (records > 0) in[pos + 1] = fuzzInterestingByte();
+      break;
+    case 2: // Gap from back to back up to well past the serial timeout
+      if (records > 0) {
+        uint8_t gaps[4] = { 0, 5, 190, 255 };
+        in[pos] = fuzzRand(2) ? gaps[fuzzRand(4)] : (uint8_t)fuzzRand(256);
+      }
+      break;
+    case 3: // Insert a well formed stream packet
+      if (records + OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES <= OPENBCI_FUZZ_MAX_RECORDS) {
+        FuzzInput packet;
+        fuzzAppendPacket(packet, (uint8_t)fuzzRand(256), (uint8_t)(OPENBCI_STREAM_PACKET_TAIL | fuzzRand(16)));
+        in.insert(in.begin() + (records > 0 ? pos : in.size()), packet.begin(), packet.end());
+      }
+      break;
+    case 4: // Insert a single record
+      if (records < OPENBCI_FUZZ_MAX_RECORDS) {
+        uint8_t rec[2] = { 0, fuzzInterestingByte() };
+        in.insert(in.begin() + (records > 0 ? pos : in.size()), rec, rec + 2);
+      }
+      break;
+    case 5: // Delete a run of records
+      if (records > 0) {
+        size_t n = 1 + fuzzRand((uint32_t)(records - r < 40 ? records - r : 40));
+        in.erase(in.begin() + pos, in.begin() + pos + 2 * n);
+      }
+      break;
+    case 6: // Duplicate a run of records
+      if (records > 0 && records < OPENBCI_FUZZ_MAX_RECORDS) {
+        size_t n = 1 + fuzzRand((uint32_t)(records - r < 40 ? records - r : 40));
+        if (records + n > OPENBCI_FUZZ_MAX_RECORDS) n = OPENBCI_FUZZ_MAX_RECORDS - records;
+        FuzzInput copy(in.begin() + pos, in.begin() + pos + 2 * n);
+        in.insert(in.begin() + pos, copy.begin(), copy.end());
+      }
+      break;
+    case 7: // Change the link or the direction
+      in[fuzzRand(OPENBCI_FUZZ_HEADER_BYTES)] = (uint8_t)fuzzRand(256);
+      break;
+    default: // Splice in the tail of another input
+      if (!corpus.empty()) {
+        const FuzzInput &other = corpus[fuzzRand((uint32_t)corpus.size())];
+        size_t otherRecords = fuzzRecords(other);
+        if (otherRecords > 0) {
+          size_t from = OPENBCI_FUZZ_HEADER_BYTES + 2 * fuzzRand((uint32_t)otherRecords);
+          in.resize(records > 0 ? pos : in.size());
+          in.insert(in.end(), other.begin() + from, other.end());
+        }
+      }
+      break;
+  }
+  if (fuzzRecords(in) > OPENBCI_FUZZ_MAX_RECORDS) {
+    in.resize(OPENBCI_FUZZ_HEADER_BYTES + 2 * OPENBCI_FUZZ_MAX_RECORDS);
+  }
+}
+
+/********************************************/
+/********************************************/
+/************    CORPUS CODE    *************/
+/********************************************/
+/********************************************/
+
+typedef struct {
+    FuzzInput   input;
+    FuzzResult  result;
+} FuzzWorst;
+
+static boolean fuzzReadFile(const char *path, FuzzInput &out) {
+  FILE *f = fopen(path, "rb");
+  if (f == NULL) return false;
+  out.clear();
+  int c;
+  while ((c = fgetc(f)) != EOF) out.push_back((uint8_t)c);
+  fclose(f);
+  return true;
+}
+
+static boolean fuzzWriteFile(const std::string &path, const FuzzInput &in) {
+  FILE *f = fopen(path.c_str(), "wb");
+  if (f == NULL) return false;
+  fwrite(in.data(), 1, in.size(), f);
+  fclose(f);
+  return true;
+}
+
+static void fuzzPrintResult(const char *name, FuzzResult &r) {
+  printf("%-40s %10llu %8llu %7llu %7llu %8llu %8llu %s\n", name,
+    (unsigned long long)r.value[FUZZ_MEASURE_COMMIT],
+    (unsigned long long)r.value[FUZZ_MEASURE_DROPPED],
+    (unsigned long long)r.value[FUZZ_MEASURE_REJECTS],
+    (unsigned long long)r.packetsMissed,
+    (unsigned long long)r.bytesIn, (unsigned long long)r.bytesOut,
+    r.settled ? "" : "never settled");
+}
+
+static void fuzzPrintHeader(void) {
+  printf("%-40s %10s %8s %7s %7s %8s %8s\n",
+    "input", "commit_us", "dropped", "reject", "missed", "bytes_in", "bytes_out");
+}
+
+/**
+* @description Keeps the `OPENBCI_FUZZ_KEEP_WORST` worst inputs for a measure.
+* @returns {boolean} - `true` if the input beat the worst one so far.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static boolean fuzzKeepWorst(std::vector<FuzzWorst> &worst, int measure, const FuzzInput &in, FuzzResult &r) {
+  uint64_t value = r.value[measure];
+  if (value == 0) return false;
+  boolean record = worst.empty() || value > worst.front().result.value[measure];
+  size_t at = 0;
+  while (at < worst.size() && worst[at].result.value[measure] >= value) at++;
+  if (at >= OPENBCI_FUZZ_KEEP_WORST) return false;
+  FuzzWorst w;
+  w.input = in;
+  w.result = r;
+  worst.insert(worst.begin() + at, w);
+  if (worst.size() > OPENBCI_FUZZ_KEEP_WORST) worst.pop_back();
+  return record;
+}
+
+static void fuzzSeeds(std::vector<FuzzInput> &seeds) {
+  FuzzInput stream(OPENBCI_FUZZ_HEADER_BYTES, 0);
+  for (int i = 0; i < 3; i++) fuzzAppendPacket(stream, (uint8_t)i, OPENBCI_STREAM_PACKET_TAIL);
+  seeds.push_back(stream);
+
+  FuzzInput text(OPENBCI_FUZZ_HEADER_BYTES, 0);
+  const char *msg = "OpenBCI V3 8-16 channel$$$";
+  for (const char *c = msg; *c; c++) {
+    text.push_back(0);
+    text.push_back((uint8_t)*c);
+  }
+  seeds.push_back(text);
+
+  FuzzInput command(OPENBCI_FUZZ_HEADER_BYTES, 0);
+  command[0] = 0x01;
+  command.push_back(0);
+  command.push_back('b');
+  seeds.push_back(command);
+
+  FuzzInput privateCommand(OPENBCI_FUZZ_HEADER_BYTES, 0);
+  privateCommand[0] = 0x01;
+  privateCommand.push_back(0);
+  privateCommand.push_back(OPENBCI_HOST_PRIVATE_CMD_KEY);
+  privateCommand.push_back(0);
+  privateCommand.push_back(OPENBCI_HOST_CMD_POLL_TIME_GET);
+  seeds.push_back(privateCommand);
+}
+
+static void usage(void) {
+  printf("usage: openbci_framing_fuzz [--runs n] [--seconds s] [--seed n] [--corpus dir]\n");
+  printf("       openbci_framing_fuzz --replay file...\n");
+}
+
+int main(int argc, char **argv) {
+  long runs = 20000;
+  double seconds = 0;
+  uint32_t seed = 1;
+  std::string corpusDir = "fuzz-corpus";
+  std::vector<const char *> replay;
+  boolean replaying = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (replaying) {
+      replay.push_back(arg);
+    } else if (strcmp(arg, "--replay") == 0) {
+      replaying = true;
+    } else if (i + 1 < argc && strcmp(arg, "--runs") == 0) {
+      runs = atol(argv[++i]);
+    } else if (i + 1 < argc && strcmp(arg, "--seconds") == 0) {
+      seconds = atof(argv[++i]);
+    } else if (i + 1 < argc && strcmp(arg, "--seed") == 0) {
+      seed = (uint32_t)atoi(argv[++i]);
+    } else if (i + 1 < argc && strcmp(arg, "--corpus") == 0) {
+      corpusDir = argv[++i];
+    } else {
+      usage();
+      return strcmp(arg, "--help") == 0 ? 0 : 1;
+    }
+  }
+
+  if (replaying) {
+    fuzzPrintHeader();
+    int failures = 0;
+    for (size_t i = 0; i < replay.size(); i++) {
+      FuzzInput in;
+      if (!fuzzReadFile(replay[i], in)) {
+        printf("%-40s could not be read\n", replay[i]);
+        failures++;
+        continue;
+      }
+      FuzzResult r = fuzzRun(in);
+      const char *slash = strrchr(replay[i], '/');
+      fuzzPrintResult(slash ? slash + 1 : replay[i], r);
+    }
+    return failures > 0 ? 1 : 0;
+  }
+
+  fuzzRng.seed(seed);
+  std::vector<FuzzInput> corpus;
+  std::vector<FuzzWorst> worst[FUZZ_MEASURE_COUNT];
+  std::vector<FuzzInput> seeds;
+  fuzzSeeds(seeds);
+  for (size_t i = 0; i < seeds.size(); i++) {
+    FuzzResult r = fuzzRun(seeds[i]);
+    fuzzMergeEdges();
+    corpus.push_back(seeds[i]);
+    for (int m = 0; m < FUZZ_MEASURE_COUNT; m++) fuzzKeepWorst(worst[m], m, seeds[i], r);
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  long run = 0;
+  for (; run < runs; run++) {
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (seconds > 0 && elapsed > seconds) break;
+
+    FuzzInput in = corpus[fuzzRand((uint32_t)corpus.size())];
+    int stack = 1 + fuzzRand(4);
+    for (int s = 0; s < stack; s++) fuzzMutateOnce(in, corpus);
+    FuzzResult r = fuzzRun(in);
+
+    boolean keep = fuzzMergeEdges() > 0;
+    for (int m = 0; m < FUZZ_MEASURE_COUNT; m++) {
+      if (fuzzKeepWorst(worst[m], m, in, r)) {
+        keep = true;
+        printf("run %ld: new worst %s %llu\n", run, fuzzMeasureNames[m], (unsigned long long)r.value[m]);
+      }
+    }
+    if (keep) corpus.push_back(in);
+  }
+
+  int edges = 0;
+  for (int i = 0; i < OPENBCI_FUZZ_MAP_SIZE; i++) edges += fuzzSeen[i];
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  printf("%ld runs in %.1fs, %d edges, corpus %d\n", run, elapsed, edges, (int)corpus.size());
+
+  mkdir(corpusDir.c_str(), 0755);
+  fuzzPrintHeader();
+  for (int m = 0; m < FUZZ_MEASURE_COUNT; m++) {
+    for (size_t i = 0; i < worst[m].size(); i++) {
+      char name[64];
+      snprintf(name, sizeof(name), "%s-%llu-%d.bin", fuzzMeasureNames[m],
+        (unsigned long long)worst[m][i].result.value[m], (int)i);
+      std::string path = corpusDir + "/" + name;
+      if (!fuzzWriteFile(path, worst[m][i].input)) {
+        printf("could not write %s\n", path.c_str());
+        return 1;
+      }
+      fuzzPrintResult(name, worst[m][i].result);
+    }
+  }
+  return 0;
+}
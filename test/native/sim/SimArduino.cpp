@@ -0,0 +1,243 @@
+/***************************************************
+Arduino core stand-ins for the native build. Every function acts on
+`SimNode::active`.
+
+MIT license
+****************************************************/
+
+#include <stdio.h>
+
+#include <Arduino.h>
+#include "SimNode.h"
+
+HardwareSerial Serial;
+
+/********************************************/
+/********************************************/
+/*************    TIME CODE    **************/
+/********************************************/
+/********************************************/
+
+unsigned long millis(void) {
+  return SimNode::active->millisNow();
+}
+
+unsigned long micros(void) {
+  return SimNode::active->microsNow();
+}
+
+uint32_t simCycles(void) {
+  return (uint32_t)(SimNode::active->nowUs * OPENBCI_PERF_CYCLES_PER_uS);
+}
+
+void delay(unsigned long ms) {
+  SimNode::active->nowUs += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+  SimNode::active->nowUs += us;
+}
+
+/********************************************/
+/********************************************/
+/*************    GPIO CODE    **************/
+/********************************************/
+/********************************************/
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin < OPENBCI_SIM_NUMBER_PINS) {
+    SimNode::active->pins[pin] = value;
+  }
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < OPENBCI_SIM_NUMBER_PINS ? SimNode::active->pins[pin] : LOW;
+}
+
+/********************************************/
+/********************************************/
+/*************    FLASH CODE    *************/
+/********************************************/
+/********************************************/
+
+uint32_t *ADDRESS_OF_PAGE(int page) {
+  return SimNode::active->flash[page];
+}
+
+int PAGE_FROM_ADDRESS(uint32_t *address) {
+  return (int)((address - SimNode::active->flash[0]) / OPENBCI_SIM_FLASH_PAGE_WORDS);
+}
+
+/**
+* @description Erases one page back to all ones.
+* @returns {int} - `0` on success, `2` if the page is out of range.
+* @author AJ Keller (@pushtheworldllc)
+*/
+int flashPageErase(int page) {
+  if (page < 0 || page >= OPENBCI_SIM_FLASH_PAGES) return 2;
+  memset(SimNode::active->flash[page], 0xFF, OPENBCI_SIM_FLASH_PAGE_WORDS * sizeof(uint32_t));
+  SimNode::active->activity++;
+  return 0;
+}
+
+/**
+* @description Programs one word. Like NOR flash, programming can only clear
+*  bits, so writing over an unerased word ANDs the values.
+* @returns {int} - `0` on success, `2` if the address is out of range.
+* @author AJ Keller (@pushtheworldllc)
+*/
+int flashWrite(uint32_t *address, uint32_t value) {
+  uint32_t *start = SimNode::active->flash[0];
+  if (address < start || address >= start + OPENBCI_SIM_FLASH_PAGES * OPENBCI_SIM_FLASH_PAGE_WORDS) return 2;
+  *address &= value;
+  SimNode::active->activity++;
+  return 0;
+}
+
+/********************************************/
+/********************************************/
+/*************   SERIAL CODE    *************/
+/********************************************/
+/********************************************/
+
+void HardwareSerial::begin(unsigned long baud) {
+  SimNode *node = SimNode::active;
+  node->serial.open = true;
+  node->serial.baud = (uint32_t)baud;
+  node->activity++;
+}
+
+void HardwareSerial::begin(unsigned long baud, int rx, int tx) {
+  (void)rx;
+  (void)tx;
+  begin(baud);
+}
+
+void HardwareSerial::end(void) {
+  SimNode::active->serial.open = false;
+  SimNode::active->activity++;
+}
+
+int HardwareSerial::available(void) {
+  SimNode *node = SimNode::active;
+  return node->serial.available(node->nowUs);
+}
+
+int HardwareSerial::availableForWrite(void) {
+  SimNode *node = SimNode::active;
+  return node->serial.availableForWrite(node->nowUs);
+}
+
+int HardwareSerial::read(void) {
+  SimNode *node = SimNode::active;
+  int value = node->serial.read(node->nowUs);
+  if (value >= 0) node->activity++;
+  return value;
+}
+
+int HardwareSerial::peek(void) {
+  SimNode *node = SimNode::active;
+  return node->serial.peek(node->nowUs);
+}
+
+void HardwareSerial::flush(void) {
+  SimNode *node = SimNode::active;
+  if (node->serial.txBusyUntilUs > (double)node->nowUs) {
+    node->nowUs = (uint64_t)(node->serial.txBusyUntilUs + 0.5);
+  }
+}
+
+size_t HardwareSerial::write(uint8_t value) {
+  SimNode *node = SimNode::active;
+  node->activity++;
+  if (!node->serial.open) return 0;
+  node->serial.writeCalls++;
+  node->nowUs = node->serial.write(node->nowUs, value);
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  SimNode *node = SimNode::active;
+  node->activity++;
+  if (!node->serial.open || size == 0) return 0;
+  node->serial.writeCalls++;
+  for (size_t i = 0; i < size; i++) {
+    node->nowUs = node->serial.write(node->nowUs, buffer[i]);
+  }
+  return size;
+}
+
+size_t HardwareSerial::write(const char *str) {
+  return write((const uint8_t *)str, strlen(str));
+}
+
+size_t HardwareSerial::print(const char *str) {
+  return write(str);
+}
+
+size_t HardwareSerial::print(char c) {
+  return write((uint8_t)c);
+}
+
+size_t HardwareSerial::print(int n, int base) {
+  return print((long)n, base);
+}
+
+size_t HardwareSerial::print(unsigned int n, int base) {
+  return print((unsigned long)n, base);
+}
+
+size_t HardwareSerial::print(long n, int base) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%ld", n);
+  return write(buf);
+}
+
+size_t HardwareSerial::print(unsigned long n, int base) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%lu", n);
+  return write(buf);
+}
+
+size_t HardwareSerial::print(double n, int digits) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", digits, n);
+  return write(buf);
+}
+
+size_t HardwareSerial::println(void) {
+  return write("\r\n");
+}
+
+size_t HardwareSerial::println(const char *str) {
+  return print(str) + println();
+}
+
+size_t HardwareSerial::println(char c) {
+  return print(c) + println();
+}
+
+size_t HardwareSerial::println(int n, int base) {
+  return print(n, base) + println();
+}
+
+size_t HardwareSerial::println(unsigned int n, int base) {
+  return print(n, base) + println();
+}
+
+size_t HardwareSerial::println(long n, int base) {
+  return print(n, base) + println();
+}
+
+size_t HardwareSerial::println(unsigned long n, int base) {
+  return print(n, base) + println();
+}
+
+size_t HardwareSerial::println(double n, int digits) {
+  return print(n, digits) + println();
+}
@@ -0,0 +1,34 @@
+/**
+* Name: SimDefinitions.h
+* Date: 10/15/2026
+* Purpose: Defaults for the native GZLL link simulator. The timing defaults
+*   are taken from the nRF51 Gazell defaults used by RFduinoGZLL.
+*
+* Author: Push The World LLC (AJ Keller)
+*/
+
+#ifndef __OpenBCI_Sim_Definitions__
+#define __OpenBCI_Sim_Definitions__
+
+#include "OpenBCI_Radios_Definitions.h"
+
+#define OPENBCI_SIM_MAX_FRAME_BYTES 32
+#define OPENBCI_SIM_FLASH_PAGES 256
+#define OPENBCI_SIM_FLASH_PAGE_WORDS 256 // 1k pages
+#define OPENBCI_SIM_NUMBER_PINS 32
+
+// Node timing
+#define OPENBCI_SIM_LOOP_COST_uS 10 // One pass of loop() on the 16MHz Cortex-M0
+#define OPENBCI_SIM_ISR_COST_uS 20 // One RFduinoGZLL_onReceive
+#define OPENBCI_SIM_IDLE_SKIP_uS 20 // How far an idle loop() pass may jump ahead
+#define OPENBCI_SIM_UART_TX_BUFFER_BYTES 64
+
+// Link timing
+#define OPENBCI_SIM_ATTEMPT_uS 600 // Gazell timeslot period
+#define OPENBCI_SIM_MAX_TX_ATTEMPTS 100 // Gazell default
+#define OPENBCI_SIM_RSSI -45
+
+// Driver
+#define OPENBCI_SIM_PIC_MAX_BACKLOG_PACKETS 2 // The PIC drops samples past this
+
+#endif // __OpenBCI_Sim_Definitions__
@@ -0,0 +1,89 @@
+/***************************************************
+PC driver stand-in for the native simulator.
+
+MIT license
+****************************************************/
+
+#include "SimDriver.h"
+#include "SimPic.h"
+#include "OpenBCI_Radios.h"
+
+SimDriver::SimDriver() {
+  reset();
+}
+
+void SimDriver::reset(void) {
+  framesReceived = 0;
+  framesUnmatched = 0;
+  duplicates = 0;
+  outOfOrder = 0;
+  gapMarkers = 0;
+  gapMissed = 0;
+  bytesReceived = 0;
+  text.clear();
+  deliveredUs.clear();
+  framePos = 0;
+  lastSeq = 0;
+  haveLastSeq = false;
+}
+
+void SimDriver::attach(SimNode *host) {
+  host->serial.sink = SimDriver::sink;
+  host->serial.sinkCtx = this;
+}
+
+void SimDriver::sink(void *ctx, uint64_t timeUs, uint8_t value) {
+  ((SimDriver *)ctx)->onByte(timeUs, value);
+}
+
+void SimDriver::flushFrameAsText(void) {
+  for (int i = 0; i < framePos && text.size() < OPENBCI_SIM_DRIVER_TEXT_MAX; i++) {
+    text.push_back((char)frame[i]);
+  }
+  framePos = 0;
+}
+
+/**
+* @description Feeds one byte from the Host's UART into the frame parser.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimDriver::onByte(uint64_t timeUs, uint8_t value) {
+  bytesReceived++;
+  if (framePos == 0 && value != OPENBCI_STREAM_BYTE_START) {
+    if (text.size() < OPENBCI_SIM_DRIVER_TEXT_MAX) text.push_back((char)value);
+    return;
+  }
+  frame[framePos++] = value;
+  if (framePos < OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES) return;
+
+  if ((value >> 4) != 0xC) {
+    flushFrameAsText();
+    return;
+  }
+  framePos = 0;
+  framesReceived++;
+
+  if (value == (OPENBCI_STREAM_BYTE_STOP | OPENBCI_STREAM_PACKET_TYPE_GAP)) {
+    gapMarkers++;
+    gapMissed += frame[1];
+    return;
+  }
+
+  uint32_t seq = SimPicSource::readSeq(frame);
+  if (seq >= OPENBCI_SIM_DRIVER_MAX_SEQ) {
+    // Not a frame the PIC source made
+    framesUnmatched++;
+    return;
+  }
+  if (seq >= deliveredUs.size()) {
+    deliveredUs.resize(seq + 1, OPENBCI_SIM_SAMPLE_NOT_SENT);
+  }
+  if (deliveredUs[seq] != OPENBCI_SIM_SAMPLE_NOT_SENT) {
+    duplicates++;
+    return;
+  }
+  deliveredUs[seq] = timeUs;
+  if (haveLastSeq && seq < lastSeq) outOfOrder++;
+  lastSeq = seq;
+  haveLastSeq = true;
+}
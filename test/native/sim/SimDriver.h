@@ -0,0 +1,52 @@
+/**
+* Name: SimDriver.h
+* Date: 10/15/2026
+* Purpose: Stand-in for the PC side driver. Sits on the Host's UART, picks the
+*   33 byte 0xA0 ... 0xCX stream frames out of the byte stream and keeps
+*   everything else (the "Success: ...$$$" style messages) as text.
+*
+* Author: Push The World LLC (AJ Keller)
+*/
+
+#ifndef __OpenBCI_Sim_Driver__
+#define __OpenBCI_Sim_Driver__
+
+#include <string>
+#include <vector>
+
+#include "SimNode.h"
+
+#define OPENBCI_SIM_DRIVER_TEXT_MAX 4096
+// About 18 hours at 250Hz, a larger sequence number is not from SimPicSource
+#define OPENBCI_SIM_DRIVER_MAX_SEQ (1UL << 24)
+
+class SimDriver {
+public:
+    SimDriver();
+    void        reset(void);
+    void        attach(SimNode *host);
+    static void sink(void *ctx, uint64_t timeUs, uint8_t value);
+    void        onByte(uint64_t timeUs, uint8_t value);
+
+    uint64_t    framesReceived;
+    uint64_t    framesUnmatched;
+    uint64_t    duplicates;
+    uint64_t    outOfOrder;
+    // Host gap markers and the stream packets they stand in for
+    uint64_t    gapMarkers;
+    uint64_t    gapMissed;
+    uint64_t    bytesReceived;
+    std::string text;
+    // When each sample's frame finished arriving at the PC, by sequence number
+    std::vector<uint64_t> deliveredUs;
+
+private:
+    void        flushFrameAsText(void);
+
+    uint8_t     frame[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES];
+    uint8_t     framePos;
+    uint32_t    lastSeq;
+    boolean     haveLastSeq;
+};
+
+#endif // __OpenBCI_Sim_Driver__
@@ -0,0 +1,199 @@
+/***************************************************
+Discrete-event Gazell link model used by the native simulator.
+
+MIT license
+****************************************************/
+
+#include "SimLink.h"
+
+SimLink::SimLink() {
+  host = NULL;
+  device = NULL;
+  reset(NULL, NULL, defaults());
+}
+
+/**
+* @description A clean link: no loss and Gazell's default timing.
+* @author AJ Keller (@pushtheworldllc)
+*/
+SimLinkConfig SimLink::defaults(void) {
+  SimLinkConfig c;
+  c.attemptUs = OPENBCI_SIM_ATTEMPT_uS;
+  c.attemptJitterUs = 0;
+  c.latencyUs = 0;
+  c.maxAttempts = OPENBCI_SIM_MAX_TX_ATTEMPTS;
+  c.lossProbability = 0;
+  c.burstEnterProbability = 0;
+  c.burstExitProbability = 1;
+  c.burstLossProbability = 1;
+  c.ackLossProbability = 0;
+  c.deliverDuplicates = false;
+  c.rssi = OPENBCI_SIM_RSSI;
+  c.seed = 1;
+  return c;
+}
+
+void SimLink::reset(SimNode *h, SimNode *d, SimLinkConfig c) {
+  host = h;
+  device = d;
+  config = c;
+  memset(&stats, 0, sizeof(stats));
+  rng.seed(config.seed);
+  busy = false;
+  burstBad = false;
+  headDelivered = false;
+  hasAckPayload = false;
+  headAttempts = 0;
+  outages.clear();
+  outageIndex = 0;
+  eventUs = 0;
+  freeAtUs = 0;
+}
+
+boolean SimLink::draw(double probability) {
+  if (probability <= 0) return false;
+  if (probability >= 1) return true;
+  return std::uniform_real_distribution<double>(0.0, 1.0)(rng) < probability;
+}
+
+/**
+* @description Steps the Gilbert-Elliott channel state and decides if this
+*  attempt is lost.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean SimLink::drawLoss(void) {
+  if (burstBad) {
+    if (draw(config.burstExitProbability)) burstBad = false;
+  } else {
+    if (draw(config.burstEnterProbability)) burstBad = true;
+  }
+  if (burstBad && draw(config.burstLossProbability)) return true;
+  return draw(config.lossProbability);
+}
+
+/**
+* @description Attempts complete in time order, so walk the outages forward.
+* @param `timeUs` {uint64_t} - When the attempt completes.
+* @returns {boolean} - `true` if the link is dead at `timeUs`.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean SimLink::inOutage(uint64_t timeUs) {
+  while (outageIndex < outages.size() && outages[outageIndex].endUs <= timeUs) {
+    outageIndex++;
+  }
+  return outageIndex < outages.size() && outages[outageIndex].startUs <= timeUs;
+}
+
+/**
+* @description When the attempt currently on air completes. Starts a new
+*  attempt if the link is idle and the Device has a frame queued.
+* @returns {uint64_t} - `UINT64_MAX` if nothing is on air.
+* @author AJ Keller (@pushtheworldllc)
+*/
+uint64_t SimLink::nextEventUs(void) {
+  if (busy) return eventUs;
+  if (device == NULL || device->txFifo.empty()) return UINT64_MAX;
+
+  uint64_t start = device->txFifo.front().queuedUs;
+  if (start < freeAtUs) start = freeAtUs;
+  uint32_t duration = config.attemptUs + config.latencyUs;
+  if (config.attemptJitterUs > 0) {
+    duration += std::uniform_int_distribution<uint32_t>(0, config.attemptJitterUs)(rng);
+  }
+  eventUs = start + duration;
+  busy = true;
+  return eventUs;
+}
+
+/**
+* @description Counts the one byte messages the radios use to refuse a page.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimLink::countRadioMessage(SimFrame *frame) {
+  if (frame->len != 1) return;
+  if ((uint8_t)frame->data[0] == ORPM_PACKET_PAGE_REJECT) stats.pageRejects++;
+  if ((uint8_t)frame->data[0] == ORPM_PACKET_MISSED) stats.packetsMissed++;
+}
+
+void SimLink::finishHead(void) {
+  device->txFifo.pop_front();
+  headAttempts = 0;
+  headDelivered = false;
+}
+
+/**
+* @description Completes the attempt on air. Runs the Host's and then the
+*  Device's `RFduinoGZLL_onReceive()` when the frame and ACK make it.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimLink::process(void) {
+  busy = false;
+  freeAtUs = eventUs;
+  if (device->txFifo.empty()) {
+    // The Device tore down its radio while the attempt was on air
+    headAttempts = 0;
+    headDelivered = false;
+    return;
+  }
+
+  SimFrame frame = device->txFifo.front();
+  headAttempts++;
+  stats.attempts++;
+  stats.airTimeUs += config.attemptUs;
+
+  if (inOutage(eventUs)) {
+    stats.attemptsLost++;
+    stats.framesFailed++;
+    stats.framesDroppedInOutage++;
+    finishHead();
+    return;
+  }
+
+  boolean linked = host->radioOn && device->radioOn && host->channel == device->channel;
+  if (!linked || drawLoss()) {
+    stats.attemptsLost++;
+    if (headAttempts >= config.maxAttempts) {
+      stats.framesFailed++;
+      finishHead();
+    }
+    return;
+  }
+
+  if (!headDelivered) {
+    // Gazell hands the Host's queued payload to this ACK before the Host's
+    //  callback runs, anything the callback queues rides the next ACK.
+    if (!hasAckPayload && !host->txFifo.empty()) {
+      ackPayload = host->txFifo.front();
+      host->txFifo.pop_front();
+      hasAckPayload = true;
+    }
+    headDelivered = true;
+    stats.framesDelivered++;
+    countRadioMessage(&frame);
+    host->interrupt(DEVICE0, config.rssi, frame.data, frame.len);
+  } else {
+    stats.duplicates++;
+    if (config.deliverDuplicates) {
+      host->interrupt(DEVICE0, config.rssi, frame.data, frame.len);
+    }
+  }
+
+  if (draw(config.ackLossProbability)) {
+    stats.acksLost++;
+    if (headAttempts >= config.maxAttempts) {
+      finishHead();
+    }
+    return;
+  }
+
+  finishHead();
+  if (hasAckPayload) {
+    hasAckPayload = false;
+    stats.ackPayloads++;
+    countRadioMessage(&ackPayload);
+    device->interrupt(HOST, config.rssi, ackPayload.data, ackPayload.len);
+  } else {
+    char empty[1] = {0};
+    device->interrupt(HOST, config.rssi, empty, 0);
+  }
+}
@@ -0,0 +1,91 @@
+/**
+* Name: SimLink.h
+* Date: 10/15/2026
+* Purpose: Discrete-event model of the Gazell link between one Device and the
+*   Host. The Device transmits the head of its TX FIFO, the Host answers with
+*   an ACK that carries the head of its own FIFO as payload. Attempts can be
+*   lost independently, in bursts (Gilbert-Elliott) or on the ACK leg, and every
+*   attempt takes a configurable air time plus latency jitter.
+*
+* Author: Push The World LLC (AJ Keller)
+*/
+
+#ifndef __OpenBCI_Sim_Link__
+#define __OpenBCI_Sim_Link__
+
+#include <random>
+#include <vector>
+
+#include "SimNode.h"
+
+typedef struct {
+    uint32_t    attemptUs;              // Air time of one attempt incl. ACK
+    uint32_t    attemptJitterUs;        // Uniform extra time per attempt
+    uint32_t    latencyUs;              // Fixed extra delivery latency
+    uint32_t    maxAttempts;            // Frame is dropped after this many
+    double      lossProbability;        // Independent loss per attempt
+    double      burstEnterProbability;  // Good -> bad per attempt
+    double      burstExitProbability;   // Bad -> good per attempt
+    double      burstLossProbability;   // Loss per attempt while bad
+    double      ackLossProbability;     // Packet arrived, ACK did not
+    boolean     deliverDuplicates;      // Host sees the retry after a lost ACK
+    int         rssi;
+    uint32_t    seed;
+} SimLinkConfig;
+
+// A stretch of time the link is dead. A frame on air inside it is dropped as
+//  if Gazell had run out of retries.
+typedef struct {
+    uint64_t    startUs;
+    uint64_t    endUs;
+} SimLinkOutage;
+
+typedef struct {
+    uint64_t    attempts;
+    uint64_t    attemptsLost;
+    uint64_t    acksLost;
+    uint64_t    framesDelivered;
+    uint64_t    framesFailed;
+    uint64_t    framesDroppedInOutage;
+    uint64_t    duplicates;
+    uint64_t    ackPayloads;
+    uint64_t    pageRejects;            // ORPM_PACKET_PAGE_REJECT either way
+    uint64_t    packetsMissed;          // ORPM_PACKET_MISSED either way
+    uint64_t    airTimeUs;
+} SimLinkStats;
+
+class SimLink {
+public:
+    SimLink();
+    static SimLinkConfig defaults(void);
+    void        reset(SimNode *host, SimNode *device, SimLinkConfig config);
+    uint64_t    nextEventUs(void);
+    void        process(void);
+
+    SimLinkConfig config;
+    SimLinkStats  stats;
+    // Sorted by start time, set after `reset()`
+    std::vector<SimLinkOutage> outages;
+
+private:
+    boolean     drawLoss(void);
+    boolean     draw(double probability);
+    boolean     inOutage(uint64_t timeUs);
+    void        finishHead(void);
+    void        countRadioMessage(SimFrame *frame);
+
+    SimNode     *host;
+    SimNode     *device;
+    std::mt19937 rng;
+    boolean     busy;
+    boolean     burstBad;
+    boolean     headDelivered;
+    boolean     hasAckPayload;
+    SimFrame    ackPayload;
+    uint32_t    headAttempts;
+    size_t      outageIndex;
+    uint64_t    eventUs;
+    uint64_t    freeAtUs;
+};
+
+#endif // __OpenBCI_Sim_Link__
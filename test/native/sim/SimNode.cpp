@@ -0,0 +1,259 @@
+/***************************************************
+Native simulation node for the OpenBCI RFduinoGZLL Host and Device.
+
+A node models one RFduino: a local clock in micro seconds, a UART with a
+transmit buffer that drains at the configured baud rate, a flash page, pins
+and the GZLL TX FIFO. The Arduino and RFduinoGZLL stand-ins act on whichever
+node is `SimNode::active`.
+
+MIT license
+****************************************************/
+
+#include <string.h>
+#include <new>
+
+#include "SimNode.h"
+#include "OpenBCI_Radios.h"
+
+SimNode *SimNode::active = NULL;
+
+/********************************************/
+/********************************************/
+/**********    SERIAL PORT CODE    **********/
+/********************************************/
+/********************************************/
+
+SimSerialPort::SimSerialPort() {
+  sink = NULL;
+  sinkCtx = NULL;
+  reset();
+}
+
+/**
+* @description Closes the port and drops anything in flight.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimSerialPort::reset(void) {
+  open = false;
+  baud = OPENBCI_BAUD_RATE_DEFAULT;
+  txBufferBytes = OPENBCI_SIM_UART_TX_BUFFER_BYTES;
+  txBusyUntilUs = 0;
+  rx.clear();
+  bytesWritten = 0;
+  bytesRead = 0;
+  writeCalls = 0;
+}
+
+/**
+* @description The time it takes to put one 8N1 byte on the wire.
+* @returns {double} - Micro seconds per byte at the current baud rate.
+* @author AJ Keller (@pushtheworldllc)
+*/
+double SimSerialPort::byteTimeUs(void) {
+  return 10000000.0 / (double)baud;
+}
+
+/**
+* @description Counts the received bytes that have fully arrived by `nowUs`.
+* @param `nowUs` {uint64_t} - The reading node's clock.
+* @returns {int} - Same as `Serial.available()`.
+* @author AJ Keller (@pushtheworldllc)
+*/
+int SimSerialPort::available(uint64_t nowUs) {
+  int count = 0;
+  for (std::deque<SimByte>::iterator it = rx.begin(); it != rx.end(); ++it) {
+    if (it->timeUs > nowUs) break;
+    count++;
+  }
+  return count;
+}
+
+/**
+* @description How many bytes can be written before a write would block.
+* @param `nowUs` {uint64_t} - The writing node's clock.
+* @returns {int} - Free bytes in the transmit buffer.
+* @author AJ Keller (@pushtheworldllc)
+*/
+int SimSerialPort::availableForWrite(uint64_t nowUs) {
+  double pending = txBusyUntilUs - (double)nowUs;
+  if (pending <= 0) return (int)txBufferBytes;
+  int used = (int)(pending / byteTimeUs()) + 1;
+  return used >= (int)txBufferBytes ? 0 : (int)txBufferBytes - used;
+}
+
+int SimSerialPort::read(uint64_t nowUs) {
+  if (rx.empty() || rx.front().timeUs > nowUs) return -1;
+  uint8_t value = rx.front().value;
+  rx.pop_front();
+  bytesRead++;
+  return value;
+}
+
+int SimSerialPort::peek(uint64_t nowUs) {
+  if (rx.empty() || rx.front().timeUs > nowUs) return -1;
+  return rx.front().value;
+}
+
+/**
+* @description The arrival time of the next byte that is still on the wire.
+* @returns {uint64_t} - `UINT64_MAX` if nothing is coming.
+* @author AJ Keller (@pushtheworldllc)
+*/
+uint64_t SimSerialPort::nextArrivalUs(void) {
+  return rx.empty() ? UINT64_MAX : rx.front().timeUs;
+}
+
+/**
+* @description Queue a byte for reception. Bytes must be pushed in time order.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimSerialPort::push(uint64_t timeUs, uint8_t value) {
+  SimByte b;
+  b.timeUs = timeUs;
+  b.value = value;
+  rx.push_back(b);
+}
+
+/**
+* @description Writes a byte. Like the hardware UART, the call blocks once the
+*  transmit buffer is full.
+* @param `nowUs` {uint64_t} - The writing node's clock.
+* @param `value` {uint8_t} - The byte to write.
+* @returns {uint64_t} - The node clock after the write returns.
+* @author AJ Keller (@pushtheworldllc)
+*/
+uint64_t SimSerialPort::write(uint64_t nowUs, uint8_t value) {
+  double byteTime = byteTimeUs();
+  double start = txBusyUntilUs > (double)nowUs ? txBusyUntilUs : (double)nowUs;
+  txBusyUntilUs = start + byteTime;
+  bytesWritten++;
+  if (sink) {
+    sink(sinkCtx, (uint64_t)txBusyUntilUs, value);
+  }
+  // Block until there is room in the buffer again
+  double bufferTime = byteTime * (double)txBufferBytes;
+  if (txBusyUntilUs - (double)nowUs > bufferTime) {
+    return (uint64_t)(txBusyUntilUs - bufferTime + 0.5);
+  }
+  return nowUs;
+}
+
+/********************************************/
+/********************************************/
+/*************    NODE CODE    **************/
+/********************************************/
+/********************************************/
+
+SimNode::SimNode(const char *nodeName) {
+  name = nodeName;
+  sketch.setup = NULL;
+  sketch.loop = NULL;
+  sketch.onReceive = NULL;
+  sketch.radio = NULL;
+  reset();
+}
+
+/**
+* @description Puts the node back to power on state with erased flash.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimNode::reset(void) {
+  nowUs = 0;
+  clockOffsetUs = 0;
+  loopCostUs = OPENBCI_SIM_LOOP_COST_uS;
+  isrCostUs = OPENBCI_SIM_ISR_COST_uS;
+  idleSkipUs = OPENBCI_SIM_IDLE_SKIP_uS;
+  timerReadCostUs = 0;
+  loops = 0;
+  idleLoops = 0;
+  interrupts = 0;
+  activity = 0;
+  serial.reset();
+  memset(flash, 0xFF, sizeof(flash));
+  memset(pins, 0, sizeof(pins));
+  radioOn = false;
+  role = HOST;
+  channel = 0;
+  txFifoDepth = RFDUINOGZLL_MAX_PACKETS_ON_TX_BUFFER;
+  txFifo.clear();
+  framesQueued = 0;
+  framesRefused = 0;
+}
+
+/**
+* @description Binds the sketch and puts its radio object back to the power on
+*  state so a node can be reused across simulations. Like a global on the
+*  RFduino the object is zeroed before its constructor runs, which does not
+*  set every member.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimNode::attach(SimSketch s) {
+  sketch = s;
+  if (sketch.radio) {
+    memset((void *)sketch.radio, 0, sizeof(OpenBCI_Radios_Class));
+    new (sketch.radio) OpenBCI_Radios_Class();
+  }
+}
+
+void SimNode::runSetup(void) {
+  SimNode *previous = active;
+  active = this;
+  if (sketch.setup) sketch.setup();
+  active = previous;
+}
+
+/**
+* @description Runs one pass of `loop()`. A pass that does nothing observable
+*  lets the clock jump ahead by up to `idleSkipUs`, but never past `wakeUs`
+*  (the next thing that will happen to this node) or the next UART byte.
+* @param `wakeUs` {uint64_t} - The next time something external hits the node.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimNode::step(uint64_t wakeUs) {
+  SimNode *previous = active;
+  active = this;
+  uint64_t before = activity;
+  loops++;
+  if (sketch.loop) sketch.loop();
+  active = previous;
+
+  uint64_t advance = loopCostUs;
+  if (activity == before) {
+    idleLoops++;
+    uint64_t limit = nowUs + idleSkipUs;
+    uint64_t nextByte = serial.nextArrivalUs();
+    if (nextByte < limit) limit = nextByte;
+    if (wakeUs < limit) limit = wakeUs;
+    if (limit > nowUs + advance) advance = limit - nowUs;
+  }
+  nowUs += advance;
+}
+
+/**
+* @description Runs `RFduinoGZLL_onReceive()` on this node.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimNode::interrupt(device_t device, int rssi, char *data, int len) {
+  SimNode *previous = active;
+  active = this;
+  interrupts++;
+  activity++;
+  if (sketch.onReceive) sketch.onReceive(device, rssi, data, len);
+  nowUs += isrCostUs;
+  active = previous;
+}
+
+/**
+* @description The value `micros()` returns. Truncated to 32 bits like the
+*  Cortex-M0 so the roll over every ~71 minutes is reproduced.
+* @author AJ Keller (@pushtheworldllc)
+*/
+uint32_t SimNode::microsNow(void) {
+  nowUs += timerReadCostUs;
+  return (uint32_t)(nowUs + clockOffsetUs);
+}
+
+uint32_t SimNode::millisNow(void) {
+  nowUs += timerReadCostUs;
+  return (uint32_t)((nowUs + clockOffsetUs) / 1000);
+}
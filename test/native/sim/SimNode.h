@@ -0,0 +1,120 @@
+/**
+* Name: SimNode.h
+* Date: 10/15/2026
+* Purpose: One simulated RFduino. A node owns everything the Arduino and
+*   RFduinoGZLL stand-ins need to answer for a single board: its local clock,
+*   its UART, its flash page, its pins and its GZLL TX FIFO. The stand-ins
+*   always act on `SimNode::active`, which the scheduler in `SimWorld` points
+*   at the node whose `loop()` or `RFduinoGZLL_onReceive()` is running.
+*
+* Author: Push The World LLC (AJ Keller)
+*/
+
+#ifndef __OpenBCI_Sim_Node__
+#define __OpenBCI_Sim_Node__
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+#include <RFduinoGZLL.h>
+#include "SimDefinitions.h"
+
+class OpenBCI_Radios_Class;
+
+// The sketch entry points, lifted out of an example .ino by SimSketches.cpp
+typedef struct {
+    void                    (*setup)(void);
+    void                    (*loop)(void);
+    void                    (*onReceive)(device_t, int, char *, int);
+    OpenBCI_Radios_Class    *radio;
+} SimSketch;
+
+typedef struct {
+    uint64_t    timeUs;
+    uint8_t     value;
+} SimByte;
+
+typedef struct {
+    char        data[OPENBCI_SIM_MAX_FRAME_BYTES];
+    uint8_t     len;
+    uint64_t    queuedUs;
+} SimFrame;
+
+// Called for every byte that leaves a node's UART, with the time the last bit
+//  left the wire.
+typedef void (*SimSerialSink)(void *ctx, uint64_t timeUs, uint8_t value);
+
+class SimSerialPort {
+public:
+    SimSerialPort();
+    void        reset(void);
+    double      byteTimeUs(void);
+    int         available(uint64_t nowUs);
+    int         availableForWrite(uint64_t nowUs);
+    int         read(uint64_t nowUs);
+    int         peek(uint64_t nowUs);
+    uint64_t    nextArrivalUs(void);
+    void        push(uint64_t timeUs, uint8_t value);
+    uint64_t    write(uint64_t nowUs, uint8_t value);
+
+    boolean     open;
+    uint32_t    baud;
+    uint32_t    txBufferBytes;
+    double      txBusyUntilUs;
+    std::deque<SimByte> rx;
+    SimSerialSink sink;
+    void        *sinkCtx;
+    uint64_t    bytesWritten;
+    uint64_t    bytesRead;
+    // Calls to `Serial.write`/`print` that wrote anything, a block is one
+    uint64_t    writeCalls;
+};
+
+class SimNode {
+public:
+    SimNode(const char *name);
+    void        reset(void);
+    void        attach(SimSketch sketch);
+    void        runSetup(void);
+    void        step(uint64_t wakeUs);
+    void        interrupt(device_t device, int rssi, char *data, int len);
+    uint32_t    microsNow(void);
+    uint32_t    millisNow(void);
+
+    const char  *name;
+    SimSketch   sketch;
+
+    // Clock
+    uint64_t    nowUs;
+    uint64_t    clockOffsetUs;
+    uint32_t    loopCostUs;
+    uint32_t    isrCostUs;
+    uint32_t    idleSkipUs;
+    uint32_t    timerReadCostUs;    // Lets busy waits on micros() finish
+    uint64_t    loops;
+    uint64_t    idleLoops;
+    uint64_t    interrupts;
+
+    // Anything a sketch does that the outside world can observe bumps this,
+    //  letting an idle loop pass fast forward the clock.
+    uint64_t    activity;
+
+    // Peripherals
+    SimSerialPort serial;
+    uint32_t    flash[OPENBCI_SIM_FLASH_PAGES][OPENBCI_SIM_FLASH_PAGE_WORDS];
+    uint8_t     pins[OPENBCI_SIM_NUMBER_PINS];
+
+    // Radio
+    boolean     radioOn;
+    device_t    role;
+    uint32_t    channel;
+    uint8_t     txFifoDepth;
+    std::deque<SimFrame> txFifo;
+    uint64_t    framesQueued;
+    uint64_t    framesRefused;
+
+    static SimNode *active;
+};
+
+#endif // __OpenBCI_Sim_Node__
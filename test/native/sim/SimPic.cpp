@@ -0,0 +1,109 @@
+/***************************************************
+PIC32 stream source for the native simulator.
+
+MIT license
+****************************************************/
+
+#include <math.h>
+
+#include "SimPic.h"
+#include "OpenBCI_Radios.h"
+
+SimPicSource::SimPicSource() {
+  maxBacklogPackets = OPENBCI_SIM_PIC_MAX_BACKLOG_PACKETS;
+  stopByte = OPENBCI_STREAM_PACKET_TAIL;
+  reset(0, 0, 0);
+}
+
+void SimPicSource::reset(double rate, uint64_t start, uint64_t stop) {
+  rateHz = rate;
+  startUs = start;
+  stopUs = stop;
+  samplesGenerated = 0;
+  samplesDropped = 0;
+  tailArrivalUs.clear();
+  scheduleUs.clear();
+  nextSeq = 0;
+  uartFreeUs = 0;
+}
+
+/**
+* @description Fills `out` with one 33 byte stream packet. The channel data is
+*  a slow sine per channel plus a little noise, so it looks like EEG to anything
+*  that cares about the values.
+* @param `seq` {uint32_t} - The sample sequence number.
+* @param `stopByte` {uint8_t} - The 0xCX tail byte.
+* @param `out` {uint8_t *} - At least `OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES`.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimPicSource::buildSample(uint32_t seq, uint8_t stopByte, uint8_t *out) {
+  out[0] = OPENBCI_STREAM_PACKET_HEAD;
+  out[1] = (uint8_t)seq;
+  uint32_t noise = seq * 1103515245u + 12345u;
+  for (int ch = 0; ch < 8; ch++) {
+    double phase = (double)seq * (0.01 + 0.003 * ch);
+    noise = noise * 1103515245u + 12345u;
+    int32_t value = (int32_t)(20000.0 * sin(phase)) + (int32_t)((noise >> 16) & 0x3F) - 32;
+    out[2 + ch * 3] = (uint8_t)(value >> 16);
+    out[3 + ch * 3] = (uint8_t)(value >> 8);
+    out[4 + ch * 3] = (uint8_t)value;
+  }
+  out[OPENBCI_SIM_SEQ_POS] = (uint8_t)(seq >> 24);
+  out[OPENBCI_SIM_SEQ_POS + 1] = (uint8_t)(seq >> 16);
+  out[OPENBCI_SIM_SEQ_POS + 2] = (uint8_t)(seq >> 8);
+  out[OPENBCI_SIM_SEQ_POS + 3] = (uint8_t)seq;
+  out[30] = 0;
+  out[31] = 0;
+  out[32] = stopByte;
+}
+
+/**
+* @description Pulls the sequence number back out of a packet laid out like
+*  `buildSample()` (the 0xA0 Host output frame shares the layout).
+* @author AJ Keller (@pushtheworldllc)
+*/
+uint32_t SimPicSource::readSeq(const uint8_t *packet) {
+  return ((uint32_t)packet[OPENBCI_SIM_SEQ_POS] << 24) |
+    ((uint32_t)packet[OPENBCI_SIM_SEQ_POS + 1] << 16) |
+    ((uint32_t)packet[OPENBCI_SIM_SEQ_POS + 2] << 8) |
+    (uint32_t)packet[OPENBCI_SIM_SEQ_POS + 3];
+}
+
+/**
+* @description Puts every sample due before `untilUs` on the Device's UART.
+* @param `device` {SimNode *} - The Device node, its baud rate sets byte timing.
+* @param `untilUs` {uint64_t} - Generate samples that start before this time.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimPicSource::pump(SimNode *device, uint64_t untilUs) {
+  if (rateHz <= 0) return;
+  double periodUs = 1000000.0 / rateHz;
+  double byteTime = device->serial.byteTimeUs();
+  double packetTime = byteTime * OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES;
+  uint8_t packet[OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES];
+
+  while (true) {
+    double sampleUs = (double)startUs + periodUs * (double)nextSeq;
+    if (!scheduleUs.empty()) {
+      if (nextSeq >= scheduleUs.size()) return;
+      sampleUs = (double)(startUs + scheduleUs[nextSeq]);
+    }
+    if (sampleUs >= (double)untilUs || sampleUs >= (double)stopUs) return;
+
+    uint32_t seq = (uint32_t)nextSeq++;
+    samplesGenerated++;
+    if (uartFreeUs - sampleUs > packetTime * maxBacklogPackets) {
+      samplesDropped++;
+      tailArrivalUs.push_back(OPENBCI_SIM_SAMPLE_NOT_SENT);
+      continue;
+    }
+    buildSample(seq, stopByte, packet);
+    double t = uartFreeUs > sampleUs ? uartFreeUs : sampleUs;
+    for (int i = 0; i < OPENBCI_MAX_PACKET_SIZE_STREAM_BYTES; i++) {
+      t += byteTime;
+      device->serial.push((uint64_t)t, packet[i]);
+    }
+    uartFreeUs = t;
+    tailArrivalUs.push_back((uint64_t)t);
+  }
+}
@@ -0,0 +1,54 @@
+/**
+* Name: SimPic.h
+* Date: 10/15/2026
+* Purpose: Stand-in for the PIC32 on the Cyton board. Produces 33 byte stream
+*   packets (0x41 ... 0xCX, see test/js/index.js) at a fixed sample rate and
+*   clocks them into the Device's UART at the Device's baud rate. Like the PIC,
+*   it drops samples when its own UART falls too far behind.
+*
+*   Every packet carries a 32 bit sequence number in its aux bytes so the
+*   driver side can match what comes out of the Host to when it went in.
+*
+* Author: Push The World LLC (AJ Keller)
+*/
+
+#ifndef __OpenBCI_Sim_Pic__
+#define __OpenBCI_Sim_Pic__
+
+#include <vector>
+
+#include "SimNode.h"
+
+// Where the sequence number lives inside the 33 byte packet
+#define OPENBCI_SIM_SEQ_POS 26
+#define OPENBCI_SIM_SAMPLE_NOT_SENT UINT64_MAX
+
+class SimPicSource {
+public:
+    SimPicSource();
+    void        reset(double rateHz, uint64_t startUs, uint64_t stopUs);
+    void        pump(SimNode *device, uint64_t untilUs);
+    static void buildSample(uint32_t seq, uint8_t stopByte, uint8_t *out);
+    static uint32_t readSeq(const uint8_t *packet);
+
+    double      rateHz;
+    uint64_t    startUs;
+    uint64_t    stopUs;
+    uint8_t     stopByte;
+    uint32_t    maxBacklogPackets;
+    // When set, sample n starts at `startUs + scheduleUs[n]` instead of on
+    //  the fixed rate grid (see SimTrace)
+    std::vector<uint64_t> scheduleUs;
+
+    uint64_t    samplesGenerated;
+    uint64_t    samplesDropped;
+    // When the tail byte of each sample finished arriving at the Device,
+    //  indexed by sequence number
+    std::vector<uint64_t> tailArrivalUs;
+
+private:
+    uint64_t    nextSeq;
+    double      uartFreeUs;
+};
+
+#endif // __OpenBCI_Sim_Pic__
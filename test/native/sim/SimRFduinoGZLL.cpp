@@ -0,0 +1,67 @@
+/***************************************************
+RFduinoGZLL stand-in for the native build. Packets are queued on the active
+node's TX FIFO, `SimLink` carries them over the air.
+
+MIT license
+****************************************************/
+
+#include <RFduinoGZLL.h>
+#include "SimNode.h"
+
+RFduinoGZLLClass RFduinoGZLL;
+
+RFduinoGZLLChannel &RFduinoGZLLChannel::operator=(uint32_t value) {
+  SimNode::active->channel = value;
+  return *this;
+}
+
+RFduinoGZLLChannel::operator uint32_t() const {
+  return SimNode::active->channel;
+}
+
+/**
+* @description Queues a frame on the active node's TX FIFO.
+* @returns {bool} - `false` if the radio is off or the FIFO is full, just like
+*  the real `sendToHost()`/`sendToDevice()`.
+* @author AJ Keller (@pushtheworldllc)
+*/
+static bool simQueueFrame(const char *data, int len) {
+  SimNode *node = SimNode::active;
+  node->activity++;
+  if (!node->radioOn || node->txFifo.size() >= node->txFifoDepth || len > OPENBCI_SIM_MAX_FRAME_BYTES || len < 0) {
+    node->framesRefused++;
+    return false;
+  }
+  SimFrame frame;
+  frame.len = (uint8_t)len;
+  frame.queuedUs = node->nowUs;
+  if (len > 0) memcpy(frame.data, data, len);
+  node->txFifo.push_back(frame);
+  node->framesQueued++;
+  return true;
+}
+
+int RFduinoGZLLClass::begin(device_t device) {
+  SimNode *node = SimNode::active;
+  node->radioOn = true;
+  node->role = device;
+  node->txFifo.clear();
+  node->activity++;
+  return 0;
+}
+
+void RFduinoGZLLClass::end(void) {
+  SimNode *node = SimNode::active;
+  node->radioOn = false;
+  node->txFifo.clear();
+  node->activity++;
+}
+
+bool RFduinoGZLLClass::sendToDevice(device_t device, const char *data, int len) {
+  (void)device;
+  return simQueueFrame(data, len);
+}
+
+bool RFduinoGZLLClass::sendToHost(const char *data, int len) {
+  return simQueueFrame(data, len);
+}
@@ -0,0 +1,39 @@
+/***************************************************
+Pulls the 32bit Host and Device example sketches into the native build. The
+sketches are included verbatim, only wrapped in a namespace that provides a
+sketch local `radio`, so they must keep compiling unchanged on hardware.
+
+MIT license
+****************************************************/
+
+#include <RFduinoGZLL.h>
+#include "OpenBCI_Radios.h"
+#include "SimSketches.h"
+
+namespace sim_host {
+  OpenBCI_Radios_Class radio;
+  #include "RadioHost32bit/RadioHost32bit.ino"
+}
+
+namespace sim_device {
+  OpenBCI_Radios_Class radio;
+  #include "RadioDevice32bit/RadioDevice32bit.ino"
+}
+
+SimSketch simHostSketch(void) {
+  SimSketch s;
+  s.setup = sim_host::setup;
+  s.loop = sim_host::loop;
+  s.onReceive = sim_host::RFduinoGZLL_onReceive;
+  s.radio = &sim_host::radio;
+  return s;
+}
+
+SimSketch simDeviceSketch(void) {
+  SimSketch s;
+  s.setup = sim_device::setup;
+  s.loop = sim_device::loop;
+  s.onReceive = sim_device::RFduinoGZLL_onReceive;
+  s.radio = &sim_device::radio;
+  return s;
+}
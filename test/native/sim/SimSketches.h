@@ -0,0 +1,19 @@
+/**
+* Name: SimSketches.h
+* Date: 10/15/2026
+* Purpose: The example sketches, compiled for the simulator. Each sketch lives
+*   in its own namespace with its own `radio` object so a Host and a Device can
+*   run side by side in one process.
+*
+* Author: Push The World LLC (AJ Keller)
+*/
+
+#ifndef __OpenBCI_Sim_Sketches__
+#define __OpenBCI_Sim_Sketches__
+
+#include "SimNode.h"
+
+SimSketch simHostSketch(void);
+SimSketch simDeviceSketch(void);
+
+#endif // __OpenBCI_Sim_Sketches__
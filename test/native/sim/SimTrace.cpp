@@ -0,0 +1,290 @@
+/***************************************************
+Recorded log loader for the native simulator's replay tool.
+
+MIT license
+****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SimTrace.h"
+
+typedef struct {
+    uint64_t    count;
+    double      timeS;
+} SimTraceCheckpoint;
+
+typedef struct {
+    int         expected;
+    int         got;
+    double      timeS;
+} SimTraceGap;
+
+SimTrace::SimTrace() {
+  clear();
+}
+
+void SimTrace::clear(void) {
+  name.clear();
+  rateHz = OPENBCI_SIM_TRACE_RATE_HZ;
+  sampleUs.clear();
+  lost.clear();
+  gaps = 0;
+  longestGap = 0;
+  duplicates = 0;
+  outOfOrder = 0;
+}
+
+void SimTrace::addSample(uint64_t timeUs, boolean wasLost) {
+  sampleUs.push_back(timeUs);
+  lost.push_back(wasLost);
+}
+
+/**
+* @description Drops every sample that starts at or after `untilUs` and
+*  recounts the gaps that are left.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimTrace::trim(uint64_t untilUs) {
+  size_t keep = 0;
+  while (keep < sampleUs.size() && sampleUs[keep] < untilUs) keep++;
+  sampleUs.resize(keep);
+  lost.resize(keep);
+  gaps = 0;
+  longestGap = 0;
+  uint64_t run = 0;
+  for (size_t i = 0; i <= keep; i++) {
+    if (i < keep && lost[i]) {
+      run++;
+      continue;
+    }
+    if (run > 0) gaps++;
+    if (run > longestGap) longestGap = run;
+    run = 0;
+  }
+}
+
+/**
+* @description One sample period past the last sample.
+* @author AJ Keller (@pushtheworldllc)
+*/
+uint64_t SimTrace::durationUs(void) {
+  if (sampleUs.empty()) return 0;
+  return sampleUs.back() + (uint64_t)(1000000.0 / rateHz);
+}
+
+uint64_t SimTrace::samplesLost(void) {
+  uint64_t count = 0;
+  for (size_t i = 0; i < lost.size(); i++) {
+    if (lost[i]) count++;
+  }
+  return count;
+}
+
+/**
+* @description Picks the loader from the file name, .csv files carry board
+*  time, everything else is taken for an endurance log.
+* @param `path` {char *} - The log to load.
+* @param `rate` {double} - The sample rate the log was recorded at.
+* @returns {boolean} - `true` if at least one sample came out of the log.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean SimTrace::load(const char *path, double rate) {
+  size_t len = strlen(path);
+  if (len > 4 && strcmp(path + len - 4, ".csv") == 0) {
+    return loadBoardTime(path, rate);
+  }
+  return loadEndurance(path, rate);
+}
+
+/**
+* @description Days since 1970-01-01 for a civil date, so the log time stamps
+*  can be compared without going through the local time zone.
+*/
+static long simTraceDays(int y, int m, int d) {
+  y -= m <= 2;
+  long era = (y >= 0 ? y : y - 399) / 400;
+  long yoe = y - era * 400;
+  long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+static boolean simTraceParseTime(const char *s, double *out) {
+  int y, mo, d, h, mi, sec;
+  if (sscanf(s, "%d-%d-%d %d:%d:%d", &y, &mo, &d, &h, &mi, &sec) != 6) return false;
+  *out = (double)simTraceDays(y, mo, d) * 86400.0 + h * 3600 + mi * 60 + sec;
+  return true;
+}
+
+/**
+* @description How many samples the recording had received by `timeS`,
+*  interpolated between the running totals.
+*/
+static double simTraceReceivedAt(std::vector<SimTraceCheckpoint> &checkpoints, double timeS, double rate) {
+  if (checkpoints.empty()) return 0;
+  if (timeS <= checkpoints.front().timeS) {
+    double count = (double)checkpoints.front().count - (checkpoints.front().timeS - timeS) * rate;
+    return count > 0 ? count : 0;
+  }
+  for (size_t i = 1; i < checkpoints.size(); i++) {
+    SimTraceCheckpoint &a = checkpoints[i - 1];
+    SimTraceCheckpoint &b = checkpoints[i];
+    if (timeS <= b.timeS) {
+      if (b.timeS <= a.timeS) return (double)b.count;
+      return (double)a.count + ((double)b.count - (double)a.count) * (timeS - a.timeS) / (b.timeS - a.timeS);
+    }
+  }
+  return (double)checkpoints.back().count + (timeS - checkpoints.back().timeS) * rate;
+}
+
+/**
+* @description Loads an enduranceTest*.txt log written by test/js/endurance-test.js.
+*  The 8 bit sample number only says how many samples went missing in each gap
+*  and how many arrived between two gaps modulo 256. The running totals and
+*  the one second time stamps decide the multiple of 256.
+* @param `path` {char *} - The log to load.
+* @param `rate` {double} - The sample rate the log was recorded at.
+* @returns {boolean} - `true` if at least one sample came out of the log.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean SimTrace::loadEndurance(const char *path, double rate) {
+  clear();
+  rateHz = rate;
+  const char *slash = strrchr(path, '/');
+  name = slash ? slash + 1 : path;
+
+  FILE *f = fopen(path, "r");
+  if (f == NULL) return false;
+
+  std::vector<SimTraceCheckpoint> checkpoints;
+  std::vector<SimTraceGap> gapLines;
+  char line[256];
+  boolean haveTotal = false;
+  unsigned long long total = 0;
+  while (fgets(line, sizeof(line), f)) {
+    char *s = line;
+    while (*s == ' ' || *s == '\t') s++;
+    SimTraceGap gap;
+    char stamp[64];
+    if (sscanf(s, "Total Packets: %llu", &total) == 1) {
+      haveTotal = true;
+    } else if (haveTotal && strncmp(s, "Date and time: ", 15) == 0) {
+      SimTraceCheckpoint checkpoint;
+      if (simTraceParseTime(s + 15, &checkpoint.timeS)) {
+        checkpoint.count = total;
+        checkpoints.push_back(checkpoint);
+      }
+      haveTotal = false;
+    } else if (sscanf(s, "err: expected %d got %d at %63[^\n]", &gap.expected, &gap.got, stamp) == 3) {
+      if (simTraceParseTime(stamp, &gap.timeS)) gapLines.push_back(gap);
+    }
+  }
+  fclose(f);
+  if (checkpoints.empty() && gapLines.empty()) return false;
+
+  double periodUs = 1000000.0 / rateHz;
+  uint64_t received = 0; // Samples the recording got before the next gap
+  uint8_t counter = 0;   // The sample number it expected next
+  uint64_t lostSoFar = 0;
+  for (size_t i = 0; i < gapLines.size(); i++) {
+    SimTraceGap &gap = gapLines[i];
+    uint64_t good = (uint8_t)(gap.expected - counter);
+    // The gap was logged somewhere inside its one second time stamp
+    double hint = simTraceReceivedAt(checkpoints, gap.timeS + 0.5, rateHz);
+    double wraps = (hint - (double)received - (double)good) / 256.0;
+    if (wraps > 0) good += 256 * (uint64_t)(wraps + 0.5);
+
+    uint64_t missing = (uint8_t)(gap.got - gap.expected);
+    while (sampleUs.size() < received + good + lostSoFar) {
+      addSample((uint64_t)(periodUs * sampleUs.size()), false);
+    }
+    for (uint64_t j = 0; j < missing; j++) {
+      addSample((uint64_t)(periodUs * sampleUs.size()), true);
+    }
+    // The sample that showed the gap did arrive
+    addSample((uint64_t)(periodUs * sampleUs.size()), false);
+    if (missing > 0) gaps++;
+    if (missing > longestGap) longestGap = missing;
+    lostSoFar += missing;
+    received += good + 1;
+    counter = (uint8_t)(gap.got + 1);
+  }
+  uint64_t totalReceived = checkpoints.empty() ? 0 : checkpoints.back().count;
+  if (received > totalReceived) totalReceived = received;
+  while (sampleUs.size() < totalReceived + lostSoFar) {
+    addSample((uint64_t)(periodUs * sampleUs.size()), false);
+  }
+  return !sampleUs.empty();
+}
+
+/**
+* @description Loads a CSV with a "Board Time" column in ms, like the
+*  timeSyncTest-*.csv logs written by test/js/time-sync-validation.js.
+*  Samples start at their board time, steps of more than one period are gaps
+*  filled with lost samples, zero and negative steps are counted and skipped.
+* @param `path` {char *} - The log to load.
+* @param `rate` {double} - The sample rate the log was recorded at.
+* @returns {boolean} - `true` if at least one sample came out of the log.
+* @author AJ Keller (@pushtheworldllc)
+*/
+boolean SimTrace::loadBoardTime(const char *path, double rate) {
+  clear();
+  rateHz = rate;
+  const char *slash = strrchr(path, '/');
+  name = slash ? slash + 1 : path;
+
+  FILE *f = fopen(path, "r");
+  if (f == NULL) return false;
+
+  char line[256];
+  int column = -1;
+  if (fgets(line, sizeof(line), f)) {
+    int index = 0;
+    for (char *tok = strtok(line, ",\r\n"); tok; tok = strtok(NULL, ",\r\n"), index++) {
+      if (strcmp(tok, "Board Time") == 0) column = index;
+    }
+  }
+  if (column < 0) {
+    fclose(f);
+    return false;
+  }
+
+  double periodMs = 1000.0 / rateHz;
+  boolean havePrevious = false;
+  double firstMs = 0;
+  double previousMs = 0;
+  while (fgets(line, sizeof(line), f)) {
+    char *tok = strtok(line, ",\r\n");
+    for (int index = 0; tok && index < column; index++) tok = strtok(NULL, ",\r\n");
+    if (tok == NULL) continue;
+    double boardMs = atof(tok);
+
+    if (!havePrevious) {
+      firstMs = boardMs;
+    } else {
+      double step = boardMs - previousMs;
+      if (step <= 0) {
+        if (step == 0) {
+          duplicates++;
+        } else {
+          outOfOrder++;
+        }
+        continue;
+      }
+      uint64_t missing = (uint64_t)(step / periodMs + 0.5);
+      missing = missing > 0 ? missing - 1 : 0;
+      for (uint64_t j = 1; j <= missing; j++) {
+        addSample((uint64_t)((previousMs - firstMs + step * j / (missing + 1)) * 1000.0), true);
+      }
+      if (missing > 0) gaps++;
+      if (missing > longestGap) longestGap = missing;
+    }
+    addSample((uint64_t)((boardMs - firstMs) * 1000.0), false);
+    havePrevious = true;
+    previousMs = boardMs;
+  }
+  fclose(f);
+  return !sampleUs.empty();
+}
@@ -0,0 +1,54 @@
+/**
+* Name: SimTrace.h
+* Date: 10/15/2026
+* Purpose: Turns the recorded logs in test/js/results into a sample schedule
+*   for the simulator. Every sample the PIC sent during the recording gets a
+*   start time and a flag saying whether the PC ever saw it.
+*
+*   enduranceTest*.txt only logs the 8 bit sample number gaps ("err: expected
+*   78 got 80 at ...") and a running total every N samples, so samples sit on
+*   the fixed rate grid and each gap is placed by matching the sample number
+*   against the totals. timeSyncTest-*.csv and Hardware_timestamp-*.csv carry
+*   the board time of every sample, so those keep the board's own jitter and
+*   a gap is any step longer than one sample period.
+*
+* Author: Push The World LLC (AJ Keller)
+*/
+
+#ifndef __OpenBCI_Sim_Trace__
+#define __OpenBCI_Sim_Trace__
+
+#include <string>
+#include <vector>
+
+#include "SimNode.h"
+
+#define OPENBCI_SIM_TRACE_RATE_HZ 250 // The Cyton's default sample rate
+
+class SimTrace {
+public:
+    SimTrace();
+    void        clear(void);
+    boolean     load(const char *path, double rateHz);
+    boolean     loadEndurance(const char *path, double rateHz);
+    boolean     loadBoardTime(const char *path, double rateHz);
+    void        trim(uint64_t untilUs);
+    uint64_t    durationUs(void);
+    uint64_t    samplesLost(void);
+
+    std::string name;
+    double      rateHz;
+    // Start of each sample the PIC sent, relative to the first one
+    std::vector<uint64_t> sampleUs;
+    // The recording never received this sample
+    std::vector<boolean>  lost;
+    uint64_t    gaps;
+    uint64_t    longestGap;
+    uint64_t    duplicates;
+    uint64_t    outOfOrder;
+
+private:
+    void        addSample(uint64_t timeUs, boolean wasLost);
+};
+
+#endif // __OpenBCI_Sim_Trace__
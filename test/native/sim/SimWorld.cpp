@@ -0,0 +1,149 @@
+/***************************************************
+Discrete-event scheduler for the native simulator.
+
+MIT license
+****************************************************/
+
+#include <algorithm>
+
+#include "SimWorld.h"
+#include "SimSketches.h"
+
+// How far ahead of the Device's clock the PIC source is pumped
+#define OPENBCI_SIM_PIC_LOOKAHEAD_uS 10000
+
+SimWorld::SimWorld() : host("host"), device("device") {
+}
+
+/**
+* @description Powers both boards up with erased flash and runs `setup()`.
+* @param `linkConfig` {SimLinkConfig} - The radio link model to use.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimWorld::begin(SimLinkConfig linkConfig) {
+  host.reset();
+  device.reset();
+  host.attach(simHostSketch());
+  device.attach(simDeviceSketch());
+  driver.reset();
+  driver.attach(&host);
+  link.reset(&host, &device, linkConfig);
+  pic.reset(0, 0, 0);
+  host.runSetup();
+  device.runSetup();
+}
+
+uint64_t SimWorld::nowUs(void) {
+  return std::min(host.nowUs, device.nowUs);
+}
+
+/**
+* @description Start the PIC streaming from now on.
+* @param `rateHz` {double} - Sample rate.
+* @param `durationUs` {uint64_t} - How long to stream for.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimWorld::stream(double rateHz, uint64_t durationUs) {
+  uint64_t start = nowUs();
+  pic.reset(rateHz, start, start + durationUs);
+}
+
+/**
+* @description Advances the simulation until every clock reaches `untilUs`.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimWorld::run(uint64_t untilUs) {
+  uint64_t pumpedUntil = 0;
+  while (true) {
+    if (device.nowUs + OPENBCI_SIM_PIC_LOOKAHEAD_uS / 2 > pumpedUntil) {
+      pumpedUntil = device.nowUs + OPENBCI_SIM_PIC_LOOKAHEAD_uS;
+      pic.pump(&device, pumpedUntil);
+    }
+    uint64_t linkUs = link.nextEventUs();
+    uint64_t t = std::min(std::min(host.nowUs, device.nowUs), linkUs);
+    if (t >= untilUs) break;
+
+    if (linkUs == t) {
+      link.process();
+    } else if (host.nowUs == t) {
+      host.step(std::min(linkUs, untilUs));
+    } else {
+      device.step(std::min(linkUs, untilUs));
+    }
+  }
+}
+
+/**
+* @description Boots the link, streams for `durationUs` and drains.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimWorld::runStream(double rateHz, uint64_t durationUs) {
+  run(nowUs() + OPENBCI_SIM_STREAM_START_uS);
+  stream(rateHz, durationUs);
+  run(pic.stopUs + OPENBCI_SIM_DRAIN_uS);
+}
+
+/**
+* @description Writes bytes from the PC to the Host's UART, starting now.
+* @author AJ Keller (@pushtheworldllc)
+*/
+void SimWorld::pcWrite(const char *data, int len) {
+  double t = (double)host.nowUs;
+  if (!host.serial.rx.empty() && (double)host.serial.rx.back().timeUs > t) {
+    t = (double)host.serial.rx.back().timeUs;
+  }
+  double byteTime = host.serial.byteTimeUs();
+  for (int i = 0; i < len; i++) {
+    t += byteTime;
+    host.serial.push((uint64_t)t, (uint8_t)data[i]);
+  }
+}
+
+static uint64_t simPercentile(std::vector<uint64_t> &sorted, double p) {
+  if (sorted.empty()) return 0;
+  size_t i = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+  return sorted[i];
+}
+
+/**
+* @description Matches what the driver saw to what the PIC sent.
+* @author AJ Keller (@pushtheworldllc)
+*/
+SimResults SimWorld::results(void) {
+  SimResults r;
+  memset(&r, 0, sizeof(r));
+  r.samplesGenerated = pic.samplesGenerated;
+  r.samplesPicDropped = pic.samplesDropped;
+  r.duplicates = driver.duplicates;
+  r.outOfOrder = driver.outOfOrder;
+  r.gapMissed = driver.gapMissed;
+  r.seconds = (double)(pic.stopUs - pic.startUs) / 1000000.0;
+
+  std::vector<uint64_t> latencies;
+  double sum = 0;
+  for (size_t seq = 0; seq < pic.tailArrivalUs.size(); seq++) {
+    uint64_t sent = pic.tailArrivalUs[seq];
+    if (sent == OPENBCI_SIM_SAMPLE_NOT_SENT) continue;
+    r.samplesSent++;
+    if (seq >= driver.deliveredUs.size() || driver.deliveredUs[seq] == OPENBCI_SIM_SAMPLE_NOT_SENT) {
+      r.samplesLost++;
+      continue;
+    }
+    uint64_t latency = driver.deliveredUs[seq] > sent ? driver.deliveredUs[seq] - sent : 0;
+    latencies.push_back(latency);
+    sum += (double)latency;
+  }
+  r.samplesDelivered = latencies.size();
+  std::sort(latencies.begin(), latencies.end());
+  if (r.seconds > 0) r.deliveredPerSecond = (double)r.samplesDelivered / r.seconds;
+  if (r.samplesGenerated > 0) {
+    r.dropRate = 1.0 - (double)r.samplesDelivered / (double)r.samplesGenerated;
+  }
+  if (!latencies.empty()) {
+    r.latencyMeanUs = sum / (double)latencies.size();
+    r.latencyMaxUs = latencies.back();
+  }
+  r.latencyP50Us = simPercentile(latencies, 0.50);
+  r.latencyP99Us = simPercentile(latencies, 0.99);
+  return r;
+}
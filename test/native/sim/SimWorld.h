@@ -0,0 +1,65 @@
+/**
+* Name: SimWorld.h
+* Date: 10/15/2026
+* Purpose: Discrete-event scheduler that ties a Host node, a Device node, the
+*   Gazell link, the PIC source and the PC driver together. Each node keeps its
+*   own clock; the scheduler always advances whichever of the two nodes or the
+*   link is furthest behind, so `loop()` passes, radio callbacks and UART bytes
+*   interleave in time order.
+*
+*   The example sketches are global, so there can only be one world running at
+*   a time. `begin()` puts everything back to power on.
+*
+* Author: Push The World LLC (AJ Keller)
+*/
+
+#ifndef __OpenBCI_Sim_World__
+#define __OpenBCI_Sim_World__
+
+#include "SimNode.h"
+#include "SimLink.h"
+#include "SimPic.h"
+#include "SimDriver.h"
+
+// Give the Device time to poll the Host before the PIC starts streaming
+#define OPENBCI_SIM_STREAM_START_uS 200000
+// Let the pipeline drain after the PIC stops
+#define OPENBCI_SIM_DRAIN_uS 300000
+
+typedef struct {
+    uint64_t    samplesGenerated;
+    uint64_t    samplesPicDropped;
+    uint64_t    samplesSent;
+    uint64_t    samplesDelivered;
+    uint64_t    samplesLost;
+    uint64_t    duplicates;
+    uint64_t    outOfOrder;
+    uint64_t    gapMissed;
+    double      seconds;
+    double      deliveredPerSecond;
+    double      dropRate;
+    double      latencyMeanUs;
+    uint64_t    latencyP50Us;
+    uint64_t    latencyP99Us;
+    uint64_t    latencyMaxUs;
+} SimResults;
+
+class SimWorld {
+public:
+    SimWorld();
+    void        begin(SimLinkConfig linkConfig);
+    void        stream(double rateHz, uint64_t durationUs);
+    void        run(uint64_t untilUs);
+    void        runStream(double rateHz, uint64_t durationUs);
+    void        pcWrite(const char *data, int len);
+    uint64_t    nowUs(void);
+    SimResults  results(void);
+
+    SimNode     host;
+    SimNode     device;
+    SimLink     link;
+    SimPicSource pic;
+    SimDriver   driver;
+};
+
+#endif // __OpenBCI_Sim_World__
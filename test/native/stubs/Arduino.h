@@ -0,0 +1,93 @@
+/**
+* Name: Arduino.h
+* Date: 10/15/2026
+* Purpose: Linux stand-in for the RFduino Arduino core. Only the parts of the
+*   core that OpenBCI_Radios and the example sketches touch are provided. Every
+*   call is routed to the currently active `SimNode` so that a Host and a Device
+*   can live in the same process and be driven by the discrete-event simulator.
+*
+* Author: Push The World LLC (AJ Keller)
+*/
+
+#ifndef __OpenBCI_Native_Arduino__
+#define __OpenBCI_Native_Arduino__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define OUTPUT_D0H1 0x2
+
+// Time
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long);
+void delayMicroseconds(unsigned int);
+// The perf counters' cycle counter, the simulated clock at 16MHz
+uint32_t simCycles(void);
+#define OPENBCI_PERF_CYCLES() simCycles()
+
+// GPIO
+void pinMode(uint8_t, uint8_t);
+void digitalWrite(uint8_t, uint8_t);
+int digitalRead(uint8_t);
+
+// Flash, see the nRF51 flash helpers in the RFduino core
+#define FLASH_PAGE_SIZE_BYTES 1024
+uint32_t *ADDRESS_OF_PAGE(int);
+int PAGE_FROM_ADDRESS(uint32_t *);
+int flashPageErase(int);
+int flashWrite(uint32_t *, uint32_t);
+
+// The simulator only runs an ISR between two steps of the loop
+#define noInterrupts()
+#define interrupts()
+
+#define DEC 10
+#define HEX 16
+
+class HardwareSerial {
+public:
+    void    begin(unsigned long);
+    void    begin(unsigned long, int, int);
+    void    end(void);
+    int     available(void);
+    int     availableForWrite(void);
+    int     read(void);
+    int     peek(void);
+    void    flush(void);
+    size_t  write(uint8_t);
+    size_t  write(const char *);
+    size_t  write(const uint8_t *, size_t);
+    size_t  write(const char *buf, size_t len) { return write((const uint8_t *)buf, len); }
+    size_t  write(char c) { return write((uint8_t)c); }
+    size_t  write(int c) { return write((uint8_t)c); }
+    size_t  print(const char *);
+    size_t  print(char);
+    size_t  print(int, int = DEC);
+    size_t  print(unsigned int, int = DEC);
+    size_t  print(long, int = DEC);
+    size_t  print(unsigned long, int = DEC);
+    size_t  print(double, int = 2);
+    size_t  println(void);
+    size_t  println(const char *);
+    size_t  println(char);
+    size_t  println(int, int = DEC);
+    size_t  println(unsigned int, int = DEC);
+    size_t  println(long, int = DEC);
+    size_t  println(unsigned long, int = DEC);
+    size_t  println(double, int = 2);
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif // __OpenBCI_Native_Arduino__
@@ -0,0 +1,62 @@
+/**
+* Name: PTW-Arduino-Assert.h
+* Date: 10/15/2026
+* Purpose: Linux stand-in for the PTW-Arduino-Assert test framework so the unit
+*   test sketches in test/arduino can run under ctest. Same calls, results go
+*   to stdout and `failures` decides the exit code of the runner.
+*
+* Author: Push The World LLC (AJ Keller)
+*/
+
+#ifndef __OpenBCI_Native_PTW_Arduino_Assert__
+#define __OpenBCI_Native_PTW_Arduino_Assert__
+
+#include <stdio.h>
+#include "Arduino.h"
+
+// The real framework prints every result over Serial at 115200 and some tests
+//  lean on that time passing, so each assertion costs the time it would take
+//  to print its message.
+void ptwAssertSpendTime(const char *msg);
+
+class PTW_Arduino_Assert {
+public:
+    PTW_Arduino_Assert() : failVerbosity(false), passes(0), failures(0) {}
+
+    void setSerial(HardwareSerial &) {}
+    void begin(void) { passes = 0; failures = 0; }
+    void end(void) { printf("\n%d passing, %d failing\n", passes, failures); }
+    void describe(const char *msg) { printf("\n%s\n", msg); }
+    void detail(const char *msg) { printf("  %s\n", msg); }
+    void it(const char *msg) { printf("    it %s\n", msg); }
+
+    void assertBoolean(boolean actual, boolean expected, const char *msg, int line = 0) { check(actual == expected, msg, line); }
+    void assertEqualByte(byte actual, byte expected, const char *msg, int line = 0) { check(actual == expected, msg, line, actual, expected); }
+    void assertEqualChar(char actual, char expected, const char *msg, int line = 0) { check(actual == expected, msg, line, (uint8_t)actual, (uint8_t)expected); }
+    void assertNotEqualChar(char actual, char expected, const char *msg, int line = 0) { check(actual != expected, msg, line); }
+    void assertEqualInt(int actual, int expected, const char *msg, int line = 0) { check(actual == expected, msg, line, actual, expected); }
+    void assertGreaterThanByte(byte actual, byte expected, const char *msg, int line = 0) { check(actual > expected, msg, line, actual, expected); }
+    void assertGreaterThanChar(char actual, char expected, const char *msg, int line = 0) { check(actual > expected, msg, line, actual, expected); }
+    void assertLessThanChar(char actual, char expected, const char *msg, int line = 0) { check(actual < expected, msg, line, actual, expected); }
+    void assertBetweenInclusiveInt(int actual, int lower, int upper, const char *msg, int line = 0) { check(actual >= lower && actual <= upper, msg, line, actual, lower); }
+    void assertEqualBuffer(const char *actual, const char *expected, int len, const char *msg, int line = 0) { check(memcmp(actual, expected, len) == 0, msg, line); }
+
+    boolean failVerbosity;
+    int     passes;
+    int     failures;
+
+private:
+    void check(bool ok, const char *msg, int line, long actual = 0, long expected = 0) {
+        ptwAssertSpendTime(msg);
+        if (ok) {
+            passes++;
+            return;
+        }
+        failures++;
+        printf("      FAIL: %s (line %d, actual %ld expected %ld)\n", msg, line, actual, expected);
+    }
+};
+
+extern PTW_Arduino_Assert test;
+
+#endif // __OpenBCI_Native_PTW_Arduino_Assert__
@@ -0,0 +1,50 @@
+/**
+* Name: RFduinoGZLL.h
+* Date: 10/15/2026
+* Purpose: Linux stand-in for the RFduinoGZLL library. Packets handed to
+*   `sendToHost()` and `sendToDevice()` are queued on the active `SimNode` and
+*   carried across by `SimLink`, which calls the sketch's
+*   `RFduinoGZLL_onReceive()` on the other side.
+*
+* Author: Push The World LLC (AJ Keller)
+*/
+
+#ifndef __OpenBCI_Native_RFduinoGZLL__
+#define __OpenBCI_Native_RFduinoGZLL__
+
+#include "Arduino.h"
+
+typedef enum {
+    HOST,
+    DEVICE0,
+    DEVICE1,
+    DEVICE2,
+    DEVICE3,
+    DEVICE4,
+    DEVICE5,
+    DEVICE6,
+    DEVICE7
+} device_t;
+
+// `RFduinoGZLL.channel` is a plain field on hardware. Here it forwards to the
+//  active node so each simulated radio keeps its own channel.
+class RFduinoGZLLChannel {
+public:
+    RFduinoGZLLChannel &operator=(uint32_t);
+    operator uint32_t() const;
+};
+
+class RFduinoGZLLClass {
+public:
+    RFduinoGZLLChannel channel;
+    int     txPowerLevel;
+
+    int     begin(device_t);
+    void    end(void);
+    bool    sendToDevice(device_t, const char *, int);
+    bool    sendToHost(const char *, int);
+};
+
+extern RFduinoGZLLClass RFduinoGZLL;
+
+#endif // __OpenBCI_Native_RFduinoGZLL__
@@ -0,0 +1,37 @@
+/***************************************************
+Runs one of the PTW-Arduino-Assert unit test sketches from test/arduino on a
+single simulated node. The node's flash starts out like a board that has
+already been through `begin()` once, since several tests read the stored
+channel number and poll time. The sketch is included through the generated
+`OPENBCI_SKETCH_TEST` wrapper, which adds the prototypes the Arduino IDE would
+normally generate.
+
+MIT license
+****************************************************/
+
+#include <RFduinoGZLL.h>
+#include "OpenBCI_Radios.h"
+#include "PTW-Arduino-Assert.h"
+#include "SimNode.h"
+
+PTW_Arduino_Assert test;
+
+void ptwAssertSpendTime(const char *msg) {
+  SimNode::active->nowUs += (uint64_t)(strlen(msg) * SimNode::active->serial.byteTimeUs());
+}
+
+#include OPENBCI_SKETCH_TEST
+
+int main(void) {
+  SimNode node("unit");
+  node.timerReadCostUs = 1;
+  // There is no Host on the other end, let the TX FIFO soak up every send
+  node.radioOn = true;
+  node.txFifoDepth = 0xFF;
+  node.flash[RFDUINOGZLL_FLASH_MEM_ADDR][0] = 20;
+  node.flash[RFDUINOGZLL_FLASH_MEM_ADDR][1] = OPENBCI_TIMEOUT_PACKET_POLL_MS;
+  SimNode::active = &node;
+  setup();
+  go();
+  return test.failures == 0 && test.passes > 0 ? 0 : 1;
+}